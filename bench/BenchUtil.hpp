@@ -0,0 +1,240 @@
+/******************************
+ *      基准测试辅助工具         *
+ ******************************/
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+// 阻止编译器把基准测试中的结果优化掉
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile T* sink = &value;
+    (void)sink;
+#endif
+}
+
+inline void clobber_memory() {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+// 硬件计数器读数 (不可用时 valid 为 false)
+struct CounterValues {
+    bool valid = false;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cacheMisses = 0;
+};
+
+/**
+ * @brief 通过 perf_event_open 读取周期数、指令数与缓存未命中
+ *
+ * 非 Linux 平台或权限不足 (perf_event_paranoid) 时自动失效, 只报告时间.
+ */
+class PerfCounters {
+#if defined(__linux__)
+    int m_fds[3] = {-1, -1, -1};
+
+    static int open_counter(uint64_t config) {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+#if defined(__linux__)
+        const uint64_t configs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                     PERF_COUNT_HW_CACHE_MISSES};
+        for (int i = 0; i < 3; ++i) {
+            m_fds[i] = open_counter(configs[i]);
+            if (m_fds[i] < 0) {
+                close_all();
+                return;
+            }
+        }
+#endif
+    }
+
+    ~PerfCounters() { close_all(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const {
+#if defined(__linux__)
+        return m_fds[0] >= 0;
+#else
+        return false;
+#endif
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (!available()) return;
+        for (int fd : m_fds) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    CounterValues stop() {
+        CounterValues values;
+#if defined(__linux__)
+        if (!available()) return values;
+        uint64_t raw[3] = {0, 0, 0};
+        for (int i = 0; i < 3; ++i) {
+            ioctl(m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fds[i], &raw[i], sizeof(raw[i])) != sizeof(raw[i])) return values;
+        }
+        values.valid = true;
+        values.cycles = raw[0];
+        values.instructions = raw[1];
+        values.cacheMisses = raw[2];
+#endif
+        return values;
+    }
+
+private:
+    void close_all() {
+#if defined(__linux__)
+        for (int& fd : m_fds) {
+            if (fd >= 0) close(fd);
+            fd = -1;
+        }
+#endif
+    }
+};
+
+// 单个基准测试的结果
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;   // 测量阶段调用次数
+    uint64_t opsPerCall = 1;   // 每次调用处理的元素数
+    double nsPerOp = 0;
+    CounterValues counters;
+
+    double ops() const { return static_cast<double>(iterations) * static_cast<double>(opsPerCall); }
+};
+
+/**
+ * @brief 基准测试运行器: 按最短测量时间自动确定迭代次数
+ */
+class Runner {
+    std::string m_filter;
+    double m_minTime;
+    PerfCounters m_counters;
+    std::vector<Result> m_results;
+
+public:
+    Runner(std::string filter, double minTimeSeconds)
+        : m_filter(std::move(filter)), m_minTime(minTimeSeconds) {}
+
+    bool counters_available() const { return m_counters.available(); }
+    const std::vector<Result>& results() const { return m_results; }
+
+    /**
+     * @param name 基准名称, 形如 "matrix/mat4_mul"
+     * @param opsPerCall 每次调用 fn 处理的元素数, 用于换算单元素耗时
+     * @param fn 被测函数
+     */
+    void run(const std::string& name, uint64_t opsPerCall, const std::function<void()>& fn) {
+        using Clock = std::chrono::steady_clock;
+        if (!m_filter.empty() && name.find(m_filter) == std::string::npos) return;
+
+        // 预热并估算迭代次数
+        fn();
+        uint64_t iterations = 1;
+        for (;;) {
+            auto begin = Clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) fn();
+            double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+            if (elapsed >= m_minTime * 0.1 || iterations >= (uint64_t(1) << 40)) {
+                double perCall = elapsed / static_cast<double>(iterations);
+                iterations = perCall > 0 ? static_cast<uint64_t>(m_minTime / perCall) + 1 : iterations * 10;
+                break;
+            }
+            iterations *= 10;
+        }
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.opsPerCall = opsPerCall;
+        m_counters.start();
+        auto begin = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) fn();
+        auto end = Clock::now();
+        result.counters = m_counters.stop();
+        result.nsPerOp = std::chrono::duration<double, std::nano>(end - begin).count() / result.ops();
+
+        print(result);
+        m_results.push_back(result);
+    }
+
+    void print(const Result& r) const {
+        std::printf("%-40s %14.3f ns/op", r.name.c_str(), r.nsPerOp);
+        if (r.counters.valid) {
+            double ipc = r.counters.cycles ? double(r.counters.instructions) / double(r.counters.cycles) : 0.0;
+            std::printf("  %10.2f cyc/op  IPC %5.2f  %10.4f miss/op",
+                        double(r.counters.cycles) / r.ops(), ipc, double(r.counters.cacheMisses) / r.ops());
+        }
+        std::printf("\n");
+    }
+
+    /**
+     * @brief 以 JSON 格式写出所有结果, 便于在版本间比较
+     */
+    bool write_json(const std::string& path, const std::string& simdTier) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "{\n  \"context\": {\n";
+        out << "    \"simd_tier\": \"" << simdTier << "\",\n";
+        out << "    \"hardware_counters\": " << (counters_available() ? "true" : "false") << ",\n";
+        out << "    \"min_time_seconds\": " << m_minTime << "\n  },\n";
+        out << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const Result& r = m_results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+                << ", \"ops_per_call\": " << r.opsPerCall << ", \"ns_per_op\": " << r.nsPerOp;
+            if (r.counters.valid) {
+                double ipc = r.counters.cycles ? double(r.counters.instructions) / double(r.counters.cycles) : 0.0;
+                out << ", \"cycles_per_op\": " << double(r.counters.cycles) / r.ops()
+                    << ", \"instructions_per_cycle\": " << ipc
+                    << ", \"cache_misses_per_op\": " << double(r.counters.cacheMisses) / r.ops();
+            } else {
+                out << ", \"cycles_per_op\": null, \"instructions_per_cycle\": null, \"cache_misses_per_op\": null";
+            }
+            out << "}" << (i + 1 < m_results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+};
+
+} // namespace bench
@@ -0,0 +1,823 @@
+#include "BenchUtil.hpp"
+#include "BoardGame.h"
+#include "Simulator.h"
+#include <GameMath/GameMath.hpp>
+#include <GameMath/Dispatch.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GameMath;
+
+namespace {
+
+// 丢弃 BoardGame::play 的输出, 避免 iostream 干扰计时
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+constexpr size_t kArraySize = 4096;
+
+std::vector<Vector3f> make_vec3_array(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<Vector3f> result(count);
+    for (auto& v : result) v = Vector3f(dist(rng), dist(rng), dist(rng));
+    return result;
+}
+
+std::vector<Vector4f> make_vec4_array(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<Vector4f> result(count);
+    for (auto& v : result) v = Vector4f{dist(rng), dist(rng), dist(rng), dist(rng)};
+    return result;
+}
+
+Matrix4x4 make_mat4(unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    Matrix4x4 m;
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j) m(i, j) = dist(rng);
+    return m;
+}
+
+std::vector<std::vector<int>> make_board(int rows, int cols, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 11);
+    std::vector<std::vector<int>> board(rows, std::vector<int>(cols));
+    for (auto& row : board)
+        for (auto& v : row) v = dist(rng);
+    return board;
+}
+
+void bench_vector(bench::Runner& runner) {
+    auto a3 = make_vec3_array(kArraySize, 1);
+    auto b3 = make_vec3_array(kArraySize, 2);
+    std::vector<Vector3f> out3(kArraySize);
+    auto a4 = make_vec4_array(kArraySize, 3);
+    auto b4 = make_vec4_array(kArraySize, 4);
+    std::vector<Vector4f> out4(kArraySize);
+
+    runner.run("vector/vec3_add", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out3[i] = a3[i] + b3[i];
+        bench::clobber_memory();
+    });
+    runner.run("vector/vec3_dot", kArraySize, [&] {
+        float sum = 0;
+        for (size_t i = 0; i < kArraySize; ++i) sum += a3[i].dot(b3[i]);
+        bench::do_not_optimize(sum);
+    });
+    runner.run("vector/vec3_normalized", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out3[i] = a3[i].normalized();
+        bench::clobber_memory();
+    });
+    runner.run("vector/vec3_fast_normalized", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out3[i] = a3[i].fast_normalized();
+        bench::clobber_memory();
+    });
+    runner.run("vector/vec4_add", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out4[i] = a4[i] + b4[i];
+        bench::clobber_memory();
+    });
+    runner.run("vector/vec4_dot", kArraySize, [&] {
+        float sum = 0;
+        for (size_t i = 0; i < kArraySize; ++i) sum += a4[i].dot(b4[i]);
+        bench::do_not_optimize(sum);
+    });
+    runner.run("vector/lerp_vec3", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out3[i] = lerp(a3[i], b3[i], 0.25f);
+        bench::clobber_memory();
+    });
+    runner.run("vector/lerp_vec4", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out4[i] = lerp(a4[i], b4[i], 0.25f);
+        bench::clobber_memory();
+    });
+    runner.run("vector/lerp_vec4_expr", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out4[i] = expr::lerp(a4[i], b4[i], 0.25f);
+        bench::clobber_memory();
+    });
+
+    Vec3Batch batchA, batchB, batchOut;
+    for (size_t i = 0; i < kArraySize; ++i) {
+        batchA.push_back(a3[i]);
+        batchB.push_back(b3[i]);
+    }
+    std::vector<float> scalars(kArraySize);
+    runner.run("batch/vec3_add", kArraySize, [&] {
+        add(batchA, batchB, batchOut);
+        bench::clobber_memory();
+    });
+    runner.run("batch/vec3_dot", kArraySize, [&] {
+        dot(batchA, batchB, scalars.data());
+        bench::clobber_memory();
+    });
+    runner.run("batch/vec3_normalize", kArraySize, [&] {
+        normalize(batchA, batchOut);
+        bench::clobber_memory();
+    });
+    runner.run("batch/vec3_normalize_high", kArraySize, [&] {
+        normalize(batchA, batchOut, Accuracy::High);
+        bench::clobber_memory();
+    });
+    runner.run("batch/vec3_normalize_low", kArraySize, [&] {
+        normalize(batchA, batchOut, Accuracy::Low);
+        bench::clobber_memory();
+    });
+}
+
+void bench_fastmath(bench::Runner& runner) {
+    std::vector<float> x(kArraySize), y(kArraySize), out(kArraySize);
+    for (size_t i = 0; i < kArraySize; ++i) {
+        x[i] = static_cast<float>(i) * 0.01f - 50.0f;
+        y[i] = static_cast<float>(kArraySize - i) * 0.007f - 20.0f;
+    }
+    runner.run("fastmath/sin_std", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = std::sin(x[i]);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/sin_high", kArraySize, [&] {
+        fast::sin(x, out, Accuracy::High);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/sin_low", kArraySize, [&] {
+        fast::sin(x, out, Accuracy::Low);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/atan2_std", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = std::atan2(y[i], x[i]);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/atan2_high", kArraySize, [&] {
+        fast::atan2(y, x, out, Accuracy::High);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/exp_std", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = std::exp(y[i]);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/exp_high", kArraySize, [&] {
+        fast::exp(y, out, Accuracy::High);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/rsqrt_exact", kArraySize, [&] {
+        fast::rsqrt(y, out, Accuracy::Exact);
+        bench::clobber_memory();
+    });
+    runner.run("fastmath/rsqrt_high", kArraySize, [&] {
+        fast::rsqrt(y, out, Accuracy::High);
+        bench::clobber_memory();
+    });
+}
+
+void bench_interpolation(bench::Runner& runner) {
+    std::vector<float> t(kArraySize), out(kArraySize);
+    for (size_t i = 0; i < kArraySize; ++i) t[i] = static_cast<float>(i) / kArraySize;
+    runner.run("interp/ease_in_out_sine_std", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = 0.5f * (1.0f - std::cos(PI * t[i]));
+        bench::clobber_memory();
+    });
+    runner.run("interp/ease_in_out_sine_batch", kArraySize, [&] {
+        ease(Ease::InOutSine, t, out);
+        bench::clobber_memory();
+    });
+    runner.run("interp/ease_out_back_batch", kArraySize, [&] {
+        ease(Ease::OutBack, t, out);
+        bench::clobber_memory();
+    });
+
+    auto keys = make_vec3_array(64, 31);
+    auto spline = Spline<Vector3f>::catmull_rom(keys, 0.0f, 1.0f / 63.0f);
+    std::vector<Vector3f> points(kArraySize);
+    runner.run("interp/spline3_scalar", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) points[i] = spline.evaluate(t[i]);
+        bench::clobber_memory();
+    });
+    runner.run("interp/spline3_batch_aos", kArraySize, [&] {
+        spline.evaluate(t, points);
+        bench::clobber_memory();
+    });
+    Vec3Batch soa;
+    runner.run("interp/spline3_batch_soa", kArraySize, [&] {
+        spline.evaluate(t, soa);
+        bench::clobber_memory();
+    });
+}
+
+void bench_matrix(bench::Runner& runner) {
+    constexpr size_t count = 256;
+    std::vector<Matrix4x4> lhs, rhs, out(count);
+    for (size_t i = 0; i < count; ++i) {
+        lhs.push_back(make_mat4(static_cast<unsigned>(i)));
+        rhs.push_back(make_mat4(static_cast<unsigned>(i + count)));
+    }
+    auto vecs = make_vec4_array(count, 5);
+    std::vector<Vector4f> vecOut(count);
+
+    runner.run("matrix/mat4_mul", count, [&] {
+        for (size_t i = 0; i < count; ++i) out[i] = lhs[i] * rhs[i];
+        bench::clobber_memory();
+    });
+    runner.run("matrix/mat4_mul_vec4", count, [&] {
+        for (size_t i = 0; i < count; ++i) vecOut[i] = lhs[i] * vecs[i];
+        bench::clobber_memory();
+    });
+    runner.run("matrix/mat4_transpose", count, [&] {
+        for (size_t i = 0; i < count; ++i) out[i] = lhs[i].transposed();
+        bench::clobber_memory();
+    });
+    runner.run("matrix/mat4_inverse", count, [&] {
+        for (size_t i = 0; i < count; ++i) out[i] = lhs[i].inverse();
+        bench::clobber_memory();
+    });
+
+    std::vector<Matrix4x4> views;
+    for (size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        views.push_back(lookAt(Vector3f(f, 2.0f, 3.0f + f), Vector3f(0.0f, 0.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f)));
+    }
+    runner.run("matrix/mat4_inverse_affine", count, [&] {
+        for (size_t i = 0; i < count; ++i) out[i] = views[i].inverse_affine();
+        bench::clobber_memory();
+    });
+    runner.run("matrix/mat4_inverse_orthonormal", count, [&] {
+        for (size_t i = 0; i < count; ++i) out[i] = views[i].inverse_orthonormal();
+        bench::clobber_memory();
+    });
+
+    Matrix3x3 m3a = Matrix3x3::identity(), m3b = Matrix3x3::identity();
+    m3b(0, 1) = 0.5f;
+    runner.run("matrix/mat3_mul", 1, [&] {
+        m3a = m3a * m3b;
+        bench::do_not_optimize(m3a);
+    });
+
+    Matrix2x2 m2a = Matrix2x2::identity(), m2b = Matrix2x2::identity();
+    m2b(0, 1) = 0.5f;
+    runner.run("matrix/mat2_mul", 1, [&] {
+        m2a = m2a * m2b;
+        bench::do_not_optimize(m2a);
+    });
+    Matrix<float, 3, 5> m35 = Matrix<float, 3, 5>(0.25f);
+    Matrix<float, 5, 3> m53 = Matrix<float, 5, 3>(0.5f);
+    runner.run("matrix/mat3x5_mul_5x3", 1, [&] {
+        auto r = m35 * m53;
+        bench::do_not_optimize(r);
+        bench::clobber_memory();
+    });
+
+    // 骨骼更新: 父节点 x 局部矩阵
+    constexpr size_t bones = 4096;
+    std::vector<Matrix4x4> boneParent(bones), boneLocal(bones), boneWorld(bones);
+    std::vector<Matrix3x4> affineParent(bones), affineLocal(bones), affineWorld(bones);
+    std::vector<uint32_t> parentIndex(bones);
+    for (size_t i = 0; i < bones; ++i) {
+        boneParent[i] = make_mat4(static_cast<unsigned>(i));
+        boneLocal[i] = make_mat4(static_cast<unsigned>(i + bones));
+        for (size_t r = 0; r < 3; ++r) {
+            affineParent[i][r] = boneParent[i][r];
+            affineLocal[i][r] = boneLocal[i][r];
+        }
+        parentIndex[i] = i % 32 == 0 ? kNoParent : static_cast<uint32_t>(i - 1);
+    }
+    runner.run("matrix/bones_mat4_loop", bones, [&] {
+        for (size_t i = 0; i < bones; ++i) boneWorld[i] = boneParent[i] * boneLocal[i];
+        bench::clobber_memory();
+    });
+    runner.run("matrix/bones_mat4_multiply_pairs", bones, [&] {
+        multiply_pairs(boneParent, boneLocal, boneWorld);
+        bench::clobber_memory();
+    });
+    runner.run("matrix/bones_affine_multiply_pairs", bones, [&] {
+        multiply_pairs(affineParent, affineLocal, affineWorld);
+        bench::clobber_memory();
+    });
+    runner.run("matrix/bones_mat4_concatenate", bones, [&] {
+        concatenate(parentIndex, boneLocal, boneWorld);
+        bench::clobber_memory();
+    });
+    runner.run("matrix/bones_affine_concatenate", bones, [&] {
+        concatenate(parentIndex, affineLocal, affineWorld);
+        bench::clobber_memory();
+    });
+
+    auto points = make_vec3_array(kArraySize, 6);
+    std::vector<Vector3f> transformed(kArraySize);
+    Matrix4x4 xf = make_mat4(7);
+    runner.run("matrix/transform_points", kArraySize, [&] {
+        transform_points(xf, points, transformed);
+        bench::clobber_memory();
+    });
+
+    Matrix<int, 8, 8> board;
+    for (size_t i = 0; i < 8; ++i)
+        for (size_t j = 0; j < 8; ++j) board(i, j) = static_cast<int>(i * 8 + j) % 12;
+    runner.run("matrix/rotate_90_clockwise_8x8", 1, [&] {
+        auto r = rotate_90_clockwise(board);
+        bench::do_not_optimize(r);
+    });
+    runner.run("matrix/rotate_90_counterclockwise_8x8", 1, [&] {
+        auto r = rotate_90_counterclockwise(board);
+        bench::do_not_optimize(r);
+    });
+    runner.run("matrix/rotate_180_8x8", 1, [&] {
+        auto r = rotate_180(board);
+        bench::do_not_optimize(r);
+    });
+    runner.run("matrix/flip_horizontal_8x8", 1, [&] {
+        auto r = flip_horizontal(board);
+        bench::do_not_optimize(r);
+    });
+    runner.run("matrix/flip_vertical_8x8", 1, [&] {
+        auto r = flip_vertical(board);
+        bench::do_not_optimize(r);
+    });
+    runner.run("matrix/rotate_90_clockwise_8x8_view", 1, [&] {
+        Matrix<int, 8, 8> r = view(board).rotated_cw().to_matrix<8, 8>();
+        bench::do_not_optimize(r);
+    });
+    runner.run("matrix/rotate_90_clockwise_8x8_in_place", 1, [&] {
+        rotate_90_clockwise_in_place(board);
+        bench::do_not_optimize(board);
+    });
+
+    // 大棋盘: 逐元素复制 vs 视图分块复制 vs 原地旋转
+    const size_t side = 512;
+    std::vector<int> cells(side * side), rotated(side * side);
+    for (size_t i = 0; i < cells.size(); ++i) cells[i] = static_cast<int>(i % 12);
+    runner.run("matrix/rotate_cw_512_naive", side * side, [&] {
+        for (size_t i = 0; i < side; ++i)
+            for (size_t j = 0; j < side; ++j) rotated[j * side + (side - 1 - i)] = cells[i * side + j];
+        bench::do_not_optimize(rotated.data());
+    });
+    runner.run("matrix/rotate_cw_512_view_copy", side * side, [&] {
+        MatrixView<const int>(cells.data(), side, side).rotated_cw().copy_to(rotated.data());
+        bench::do_not_optimize(rotated.data());
+    });
+    runner.run("matrix/rotate_cw_512_in_place", side * side, [&] {
+        rotate_90_clockwise_in_place(MatrixView<int>(cells.data(), side, side));
+        bench::do_not_optimize(cells.data());
+    });
+    runner.run("matrix/flip_horizontal_512_view_copy", side * side, [&] {
+        MatrixView<const int>(cells.data(), side, side).flipped_horizontal().copy_to(rotated.data());
+        bench::do_not_optimize(rotated.data());
+    });
+}
+
+void bench_gemm(bench::Runner& runner) {
+    // 运行时尺寸矩阵乘: 朴素三重循环 vs 分块 GEMM (单位为乘加次数)
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t n : {size_t(64), size_t(256), size_t(512)}) {
+        DynamicMatrix<float> a(n, n), b(n, n), c(n, n);
+        for (float& x : a) x = dist(rng);
+        for (float& x : b) x = dist(rng);
+        const std::string size = std::to_string(n);
+        if (n <= 256) {
+            runner.run("gemm/naive_" + size, n * n * n, [&] {
+                for (size_t i = 0; i < n; ++i)
+                    for (size_t j = 0; j < n; ++j) {
+                        float sum = 0.0f;
+                        for (size_t k = 0; k < n; ++k) sum += a(i, k) * b(k, j);
+                        c(i, j) = sum;
+                    }
+                bench::do_not_optimize(c.data());
+            });
+        }
+        runner.run("gemm/blocked_" + size, n * n * n, [&] {
+            gemm<float>(a.view(), b.view(), c.view());
+            bench::do_not_optimize(c.data());
+        });
+        if (n == 512) {
+            for (size_t threads : {size_t(1), size_t(4)}) {
+                ThreadPool pool(threads);
+                runner.run("gemm/blocked_" + size + "_threads" + std::to_string(threads), n * n * n, [&] {
+                    gemm<float>(a.view(), b.view(), c.view(), 1.0f, 0.0f, pool);
+                    bench::do_not_optimize(c.data());
+                });
+            }
+        }
+    }
+
+    // 小型网络层: 32 个输入批量乘 64x64 权重
+    DynamicMatrix<float> weights(64, 64, 0.01f), inputs(64, 32, 1.0f), outputs(64, 32);
+    runner.run("gemm/layer_64x64x32", 64 * 64 * 32, [&] {
+        gemm<float>(weights.view(), inputs.view(), outputs.view());
+        bench::do_not_optimize(outputs.data());
+    });
+}
+
+void bench_quaternion(bench::Runner& runner) {
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<Quaternion> a(kArraySize), b(kArraySize), out(kArraySize);
+    std::vector<float> t(kArraySize);
+    Vec4Batch sa, sb, so;
+    for (size_t i = 0; i < kArraySize; ++i) {
+        a[i] = Quaternion(dist(rng), dist(rng), dist(rng), dist(rng)).normalized();
+        b[i] = Quaternion(dist(rng), dist(rng), dist(rng), dist(rng)).normalized();
+        t[i] = (dist(rng) + 1.0f) * 0.5f;
+        sa.push_back(Vector4f{a[i].x, a[i].y, a[i].z, a[i].w});
+        sb.push_back(Vector4f{b[i].x, b[i].y, b[i].z, b[i].w});
+    }
+    auto points = make_vec3_array(kArraySize, 9);
+    std::vector<Vector3f> rotated(kArraySize);
+
+    runner.run("quaternion/multiply", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = a[i] * b[i];
+        bench::clobber_memory();
+    });
+    runner.run("quaternion/rotate_vec3", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) rotated[i] = a[i] * points[i];
+        bench::clobber_memory();
+    });
+    runner.run("quaternion/slerp_aos", kArraySize, [&] {
+        slerp(a, b, t, out);
+        bench::clobber_memory();
+    });
+    runner.run("quaternion/nlerp_aos", kArraySize, [&] {
+        nlerp(a, b, t, out);
+        bench::clobber_memory();
+    });
+    runner.run("quaternion/slerp_soa", kArraySize, [&] {
+        slerp(sa, sb, t, so);
+        bench::clobber_memory();
+    });
+    runner.run("quaternion/nlerp_soa", kArraySize, [&] {
+        nlerp(sa, sb, t, so);
+        bench::clobber_memory();
+    });
+}
+
+void bench_transform(bench::Runner& runner) {
+    // 1024 棵子树, 每棵 1 + 4 + 16 个节点
+    TransformHierarchy scene;
+    std::vector<TransformHierarchy::Handle> roots;
+    Quaternion spin = Quaternion::from_axis_angle(Vector3f(0.0f, 1.0f, 0.0f), 0.1f);
+    for (int r = 0; r < 1024; ++r) {
+        auto root = scene.create(TransformHierarchy::kInvalid, Vector3f(static_cast<float>(r), 0.0f, 0.0f));
+        roots.push_back(root);
+        for (int c = 0; c < 4; ++c) {
+            auto child = scene.create(root, Vector3f(0.0f, 1.0f, 0.0f), spin);
+            for (int g = 0; g < 4; ++g) scene.create(child, Vector3f(0.5f, 0.0f, 0.0f), spin);
+        }
+    }
+    scene.update();
+    const uint64_t nodes = scene.size();
+
+    runner.run("transform/update_all_dirty", nodes, [&] {
+        for (auto root : roots) scene.set_position(root, scene.position(root));
+        scene.update();
+    });
+    runner.run("transform/update_1pct_dirty", nodes, [&] {
+        for (size_t i = 0; i < roots.size(); i += 100) scene.set_position(roots[i], scene.position(roots[i]));
+        scene.update();
+    });
+    runner.run("transform/update_clean", nodes, [&] {
+        scene.update();
+    });
+}
+
+void bench_geometry(bench::Runner& runner) {
+    constexpr size_t count = 32768;
+    std::mt19937 rng(10);
+    std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> ext(0.5f, 4.0f);
+    std::vector<AABB> boxes;
+    Vec3Batch centers, extents;
+    std::vector<float> radii;
+    for (size_t i = 0; i < count; ++i) {
+        Vector3f c(pos(rng), pos(rng), pos(rng));
+        Vector3f e(ext(rng), ext(rng), ext(rng));
+        boxes.push_back(AABB::from_center_extents(c, e));
+        centers.push_back(c);
+        extents.push_back(e);
+        radii.push_back(e.length());
+    }
+    Matrix4x4 viewProj = perspective(1.2f, 16.0f / 9.0f, 0.1f, 300.0f) *
+                         lookAt(Vector3f(0.0f, 10.0f, 0.0f), Vector3f(50.0f, 0.0f, -80.0f), Vector3f(0.0f, 1.0f, 0.0f));
+    Frustum frustum = Frustum::from_matrix(viewProj);
+    std::vector<uint32_t> visible;
+    visible.reserve(count);
+
+    runner.run("geometry/cull_aabb_scalar", count, [&] {
+        visible.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (frustum.intersects(boxes[i])) visible.push_back(static_cast<uint32_t>(i));
+        }
+        bench::clobber_memory();
+    });
+    runner.run("geometry/cull_aabb_batch", count, [&] {
+        cull(frustum, centers, extents, visible);
+        bench::clobber_memory();
+    });
+    runner.run("geometry/cull_sphere_batch", count, [&] {
+        cull(frustum, centers, Span<const float>(radii), visible);
+        bench::clobber_memory();
+    });
+}
+
+void bench_broadphase(bench::Runner& runner) {
+    // 20000 个 1~3 单位大小的角色分布在 1000 x 1000 区域
+    constexpr size_t count = 20000;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(1.0f, 3.0f);
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    SpatialHash grid(4.0f);
+    std::vector<SpatialHash::Handle> handles;
+    std::vector<Vector2f> positions;
+    for (size_t i = 0; i < count; ++i) {
+        positions.push_back(Vector2f{pos(rng), pos(rng)});
+        handles.push_back(grid.insert(positions.back(), Vector2f{size(rng), size(rng)}));
+    }
+    std::vector<Vector2f> offsets(count);
+    for (auto& o : offsets) o = Vector2f{step(rng), step(rng)};
+    std::vector<SpatialHash::Pair> pairs;
+    float sign = 1.0f;
+
+    runner.run("broadphase/move_all", count, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = positions[i] + offsets[i] * sign;
+            grid.move(handles[i], positions[i]);
+        }
+        sign = -sign;
+    });
+    runner.run("broadphase/candidate_pairs", count, [&] {
+        grid.candidate_pairs(pairs);
+        bench::do_not_optimize(pairs.size());
+    });
+    runner.run("broadphase/colliding_pairs", count, [&] {
+        grid.colliding_pairs(pairs);
+        bench::do_not_optimize(pairs.size());
+    });
+}
+
+void bench_bvh(bench::Runner& runner) {
+    // 256 x 256 高度场网格, 约 13 万个三角形
+    constexpr int grid = 256;
+    std::vector<Vector3f> vertices;
+    std::vector<uint32_t> indices;
+    for (int y = 0; y <= grid; ++y) {
+        for (int x = 0; x <= grid; ++x) {
+            float fx = static_cast<float>(x), fy = static_cast<float>(y);
+            vertices.push_back(Vector3f(fx, fy, 4.0f * std::sin(fx * 0.1f) * std::cos(fy * 0.13f)));
+        }
+    }
+    for (int y = 0; y < grid; ++y) {
+        for (int x = 0; x < grid; ++x) {
+            uint32_t i = static_cast<uint32_t>(y * (grid + 1) + x);
+            indices.insert(indices.end(), {i, i + 1, i + grid + 2, i, i + grid + 2, i + grid + 1});
+        }
+    }
+    const uint64_t triangles = indices.size() / 3;
+    // 每个硬件线程一个工作线程, 以原子计数领取任务
+    auto threadedFor = [](size_t count, auto&& task) {
+        std::atomic<size_t> next{0};
+        auto worker = [&] {
+            for (size_t i = next++; i < count; i = next++) task(i);
+        };
+        size_t workers = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::thread> threads;
+        for (size_t w = 1; w < workers; ++w) threads.emplace_back(worker);
+        worker();
+        for (auto& t : threads) t.join();
+    };
+
+    BVH bvh;
+    runner.run("bvh/build_serial", triangles, [&] { bvh.build(vertices, indices); });
+    runner.run("bvh/build_parallel", triangles, [&] { bvh.build(vertices, indices, threadedFor); });
+    runner.run("bvh/refit", triangles, [&] { bvh.refit(vertices); });
+
+    // 相邻射线起点相近, 方向斜向下 (命中检测的典型分布)
+    constexpr size_t rayCount = 4096;
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    std::vector<Ray> rays;
+    for (size_t i = 0; i < rayCount; ++i) {
+        float x = static_cast<float>(i % 64) * 4.0f, y = static_cast<float>(i / 64) * 4.0f;
+        rays.emplace_back(Vector3f(x, y, 20.0f), Vector3f(0.3f + 0.01f * jitter(rng), 0.2f, -1.0f));
+    }
+    std::vector<RayHit> hits(rayCount);
+    std::vector<uint8_t> blocked(rayCount);
+
+    runner.run("bvh/raycast_single", rayCount, [&] {
+        for (size_t i = 0; i < rayCount; ++i) bvh.raycast(rays[i], hits[i]);
+        bench::clobber_memory();
+    });
+    runner.run("bvh/raycast_packet", rayCount, [&] {
+        bvh.raycast(rays, hits);
+        bench::clobber_memory();
+    });
+    runner.run("bvh/occluded_packet", rayCount, [&] {
+        bvh.occluded(rays, blocked);
+        bench::clobber_memory();
+    });
+    std::vector<uint32_t> found;
+    runner.run("bvh/query_aabb", 1, [&] {
+        found.clear();
+        bvh.query(AABB(Vector3f(100.0f, 100.0f, -10.0f), Vector3f(104.0f, 104.0f, 10.0f)), found);
+        bench::do_not_optimize(found.size());
+    });
+}
+
+void bench_memory(bench::Runner& runner) {
+    // 每帧 64 个临时缓冲区: 堆分配 vs 帧内存池
+    constexpr size_t buffers = 64;
+    runner.run("memory/frame_temporaries_heap", buffers, [&] {
+        for (size_t i = 0; i < buffers; ++i) {
+            std::unique_ptr<float[]> tmp(new float[64 + i * 16]);
+            tmp[0] = 1.0f;
+            bench::do_not_optimize(tmp.get());
+        }
+    });
+    FrameArena arena;
+    runner.run("memory/frame_temporaries_arena", buffers, [&] {
+        for (size_t i = 0; i < buffers; ++i) {
+            float* tmp = arena.allocate<float>(64 + i * 16);
+            tmp[0] = 1.0f;
+            bench::do_not_optimize(tmp);
+        }
+        arena.reset();
+    });
+}
+
+void bench_utility(bench::Runner& runner) {
+    Random::seed(42);
+    runner.run("random/range_int", 1, [&] {
+        int v = Random::range(0, 11);
+        bench::do_not_optimize(v);
+    });
+    runner.run("random/range_float", 1, [&] {
+        float v = Random::range(0.0f, 1.0f);
+        bench::do_not_optimize(v);
+    });
+    runner.run("random/in_circle", 1, [&] {
+        auto v = Random::in_circle(5.0f);
+        bench::do_not_optimize(v);
+    });
+
+    std::vector<float> values(kArraySize);
+    std::vector<Vector2f> points(kArraySize);
+    runner.run("random/range_float_loop", kArraySize, [&] {
+        for (float& v : values) v = Random::range(0.0f, 1.0f);
+        bench::clobber_memory();
+    });
+    runner.run("random/fill_range", kArraySize, [&] {
+        Random::fill_range(values, 0.0f, 1.0f);
+        bench::clobber_memory();
+    });
+    runner.run("random/in_circle_loop", kArraySize, [&] {
+        for (Vector2f& p : points) p = Random::in_circle(5.0f);
+        bench::clobber_memory();
+    });
+    runner.run("random/fill_in_circle", kArraySize, [&] {
+        Random::fill_in_circle(points, 5.0f);
+        bench::clobber_memory();
+    });
+    runner.run("random/fill_on_circle", kArraySize, [&] {
+        Random::fill_on_circle(points, 5.0f);
+        bench::clobber_memory();
+    });
+
+    std::vector<float> t(kArraySize), out(kArraySize);
+    for (size_t i = 0; i < kArraySize; ++i) t[i] = static_cast<float>(i) / kArraySize;
+    runner.run("easing/ease_in", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = ease_in(t[i]);
+        bench::clobber_memory();
+    });
+    runner.run("easing/ease_out", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = ease_out(t[i]);
+        bench::clobber_memory();
+    });
+    runner.run("easing/ease_in_out", kArraySize, [&] {
+        for (size_t i = 0; i < kArraySize; ++i) out[i] = ease_in_out(t[i]);
+        bench::clobber_memory();
+    });
+}
+
+void bench_boardgame(bench::Runner& runner) {
+    NullBuffer nullBuffer;
+    std::streambuf* original = std::cout.rdbuf(&nullBuffer);
+
+    for (int size : {6, 64, 256}) {
+        auto board = make_board(size, size, 11);
+        BoardGame game(size, size);
+        // 每次调用包含 setBoard 的拷贝开销, 以保证每轮都从同一盘面开始
+        runner.run("boardgame/play_" + std::to_string(size) + "x" + std::to_string(size),
+                   static_cast<uint64_t>(size) * size, [&] {
+            game.setBoard(board);
+            game.play();
+        });
+    }
+
+    // 单独比较两种全盘搜索: 位板逐值扫描 11 次 vs 并查集单遍标记
+    for (int size : {64, 256}) {
+        auto board = make_board(size, size, 11);
+        std::vector<int> flat;
+        for (const auto& row : board) flat.insert(flat.end(), row.begin(), row.end());
+        Bitboard bits(size, size);
+        std::vector<uint64_t> win(bits.words());
+        std::string suffix = std::to_string(size) + "x" + std::to_string(size);
+        runner.run("boardgame/components_bitboard_" + suffix, static_cast<uint64_t>(size) * size, [&] {
+            bits.load(flat.data(), 0);
+            int total = 0;
+            for (int val = 1; val <= Bitboard::MAX_VALUE; ++val) total += bits.collectWinning(val, 5, win.data());
+            bench::do_not_optimize(total);
+        });
+        ComponentLabeler labeler(size, size);
+        runner.run("boardgame/components_unionfind_" + suffix, static_cast<uint64_t>(size) * size, [&] {
+            labeler.label(flat.data(), 5);
+            bench::do_not_optimize(labeler.clearedCount());
+        });
+    }
+
+    // 连锁消除: 首轮全盘扫描, 之后只扫描下落改动的区域 (补牌恒为 1, 以轮数上限截断)
+    CascadeStats stats;
+    for (int size : {6, 64, 256}) {
+        auto board = make_board(size, size, 11);
+        BoardGame game(size, size);
+        runner.run("boardgame/cascade16_" + std::to_string(size) + "x" + std::to_string(size),
+                   static_cast<uint64_t>(size) * size, [&] {
+            game.setBoard(board);
+            game.cascade(stats, 16);
+        });
+    }
+
+    // 批量模拟: 每次 256 局 6x5 完整连锁 (随机补牌), 单位为每局
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        ThreadPool pool(threads);
+        SimulationConfig config;
+        config.games = 256;
+        uint64_t seed = 0;
+        runner.run("boardgame/simulate_6x5_threads" + std::to_string(threads), config.games, [&] {
+            config.seed = seed++;
+            bench::do_not_optimize(simulate(config, pool).rounds);
+        });
+    }
+
+    std::cout.rdbuf(original);
+}
+
+void print_usage(const char* argv0) {
+    std::printf("Usage: %s [--filter <substring>] [--json <path>] [--min-time <seconds>]\n", argv0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    double minTime = 0.2;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    bench::Runner runner(filter, minTime);
+    const char* tier = simd::tier_name(simd::active_tier());
+    std::printf("GameMath_bench  simd tier: %s  hardware counters: %s\n\n", tier,
+                runner.counters_available() ? "yes" : "no (perf_event_open unavailable)");
+
+    bench_vector(runner);
+    bench_fastmath(runner);
+    bench_interpolation(runner);
+    bench_matrix(runner);
+    bench_gemm(runner);
+    bench_quaternion(runner);
+    bench_transform(runner);
+    bench_geometry(runner);
+    bench_broadphase(runner);
+    bench_bvh(runner);
+    bench_memory(runner);
+    bench_utility(runner);
+    bench_boardgame(runner);
+
+    if (!jsonPath.empty()) {
+        if (!runner.write_json(jsonPath, tier)) {
+            std::fprintf(stderr, "Failed to write %s\n", jsonPath.c_str());
+            return 1;
+        }
+        std::printf("\nResults written to %s\n", jsonPath.c_str());
+    }
+    return 0;
+}
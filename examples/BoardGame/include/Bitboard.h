@@ -0,0 +1,62 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 棋盘位板: 每个牌值一张位掩码, 赖子格并入所有值的掩码.
+// 按行存放, 每行占 wordsPerRow() 个 64 位字, 第 c 列位于第 c / 64 个字的第 c % 64 位;
+// 列数之外的填充位恒为 0.
+// 所有缓冲区在构造时分配, load 与连通块搜索不再申请堆内存.
+class Bitboard {
+public:
+    static const int MAX_VALUE = 11;
+
+    Bitboard(int rows, int cols);
+
+    // 由行主序棋盘 cells[r * cols + c] 重建各值掩码, 值为 laizi 的格子并入 1 ~ MAX_VALUE 的所有掩码
+    void load(const int* cells, int laizi);
+
+    // 只按 dirty 中置位的格子 (限前 dirtyRows 行) 更新各值掩码, 其余格子视为未变
+    void update(const int* cells, int laizi, const uint64_t* dirty, int dirtyRows);
+
+    // 找出值 val 中格子数 >= minSize 的连通块 (上下左右相邻) 并入 win (words() 个字),
+    // 返回 win 中新增的格子数; sizes 不为空时追加每个获胜块的格子数
+    int collectWinning(int val, int minSize, uint64_t* win, std::vector<int>* sizes = nullptr);
+    // 同上, 但只从 seeds 中置位的格子 (限前 seedRows 行) 出发; 连通块本身仍可延伸到任意位置
+    int collectWinning(int val, int minSize, uint64_t* win, const uint64_t* seeds, int seedRows,
+                       std::vector<int>* sizes = nullptr);
+
+    int rows() const { return ROWS; }
+    int cols() const { return COLS; }
+    int wordsPerRow() const { return WORDS; }
+    size_t words() const { return static_cast<size_t>(ROWS) * WORDS; }
+
+    const uint64_t* mask(int val) const { return &masks[static_cast<size_t>(val) * words()]; }
+    bool test(const uint64_t* bits, int r, int c) const {
+        return (bits[static_cast<size_t>(r) * WORDS + (c >> 6)] >> (c & 63)) & 1;
+    }
+
+    static int popcount(uint64_t x);
+    static int lowestBit(uint64_t x);  // x 不为 0
+    static int popcount(const uint64_t* bits, size_t count);
+
+private:
+    int ROWS, COLS, WORDS;
+    std::vector<uint64_t> masks;   // (MAX_VALUE + 1) 张掩码, 下标 0 为赖子格
+    std::vector<uint64_t> remain;  // 当前值尚未归入任何连通块的格子
+    std::vector<uint64_t> comp;    // 正在扩展的连通块, 扩展结束后清零
+    int left = 0, right = 0;       // 正在扩展的连通块所占的字列范围
+
+    // 设置单个格子在各值掩码中的位
+    void setCell(int r, int c, int v, int laizi);
+    // 在行 r 内把 comp 沿掩码横向扩展到不动点 (必要时扩大字列范围)
+    void fillRow(const uint64_t* mask, int r);
+    // 把相邻行 from 向行 r 扩展一步后再横向扩展, 返回行 r 是否变化
+    bool growRow(const uint64_t* mask, int r, int from);
+    // 从种子格扩展出完整连通块, 写出行范围 [top, bottom], 返回格子数
+    int flood(const uint64_t* mask, int seedRow, int seedWord, uint64_t seedBit, int& top, int& bottom);
+};
+
+#endif
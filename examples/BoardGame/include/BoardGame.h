@@ -1,25 +1,76 @@
 #ifndef BOARDGAME_H
 #define BOARDGAME_H
 
+#include "Bitboard.h"
+#include "ComponentLabeler.h"
+#include <functional>
+#include <utility>
 #include <vector>
-#include <set>
-#include <map>
+
+// 单轮消除统计
+struct RoundStats {
+    int round = 0;
+    int cleared = 0;                                // 本轮消除的格子数 (各值获胜块的并集)
+    int blockCells[Bitboard::MAX_VALUE + 1] = {};   // 各值获胜块的格子数, 下标为牌值
+    int firstBlock = 0;                             // 本轮获胜块在 CascadeStats::blocks 中的区间
+    int blockCount = 0;
+};
+
+// 连锁消除统计
+struct CascadeStats {
+    int rounds = 0;             // 发生消除的轮数
+    int totalCleared = 0;
+    bool truncated = false;     // 达到轮数上限时盘面上仍有获胜块
+    std::vector<RoundStats> perRound;
+    std::vector<WinBlock> blocks;   // 各轮的获胜块, 按轮次连续存放
+};
 
 class BoardGame {
 public:
+    static const int DEFAULT_MAX_ROUNDS = 1000;
+
     BoardGame(int rows, int cols);
 
     void setBoard(const std::vector<std::vector<int>>& board);
+    // 行主序连续存储, cells[r * cols + c]
+    void setBoard(const int* cells);
+    const std::vector<int>& getCells() const { return cells; }
+    int at(int row, int col) const { return cells[row * COLS + col]; }
+
+    // 下落后补牌的来源, 参数为 (row, col); 未设置时固定补 1
+    void setCardSource(std::function<int(int, int)> source) { cardSource = std::move(source); }
+
+    // 执行一轮消除并输出 "轮次 牌值 块大小"
     void play();
 
+    // 反复消除、下落、补牌直到没有获胜块 (或达到 maxRounds 轮), 不输出.
+    // 第一轮扫描全盘, 之后只从上一轮消除与下落改动过的格子出发搜索.
+    CascadeStats cascade(int maxRounds = DEFAULT_MAX_ROUNDS);
+    // 同上, 复用 stats 中 perRound 与 blocks 的存储
+    void cascade(CascadeStats& stats, int maxRounds = DEFAULT_MAX_ROUNDS);
+
 private:
     int ROWS, COLS;
     const int LAIZI = 0;
-    std::vector<std::vector<int>> board;
+    const int MIN_BLOCK = 5;
+    std::vector<int> cells;  // 行主序棋盘
+    std::function<int(int, int)> cardSource;
+
+    // 全盘搜索用并查集标记, 连锁消除的后续轮次用位板增量搜索; 缓冲区构造时分配一次
+    ComponentLabeler labeler;
+    Bitboard bits;
+    std::vector<uint64_t> winBits;  // (MAX_VALUE + 1) * bits.words(), 下标 0 为所有值的并集
+    std::vector<uint64_t> dirty;    // 上一轮下落补牌后值可能改变的格子
+    int dirtyRows = 0;              // dirty 中有置位的行数上界
+    std::vector<int> blockSizes;    // 位板搜索单个值时的获胜块大小
 
     int getCard(int row, int col);
     bool isSame(int a, int b);
-    void bfs(int r, int c, int val, std::vector<std::vector<bool>>& visited,
-             std::vector<std::pair<int,int>>& comp);
+
+    // 搜索获胜块, 写入 winBits[0] 与 stats; blocks 不为空时追加每个获胜块.
+    // 全盘搜索使用并查集; incremental 时在位板上只从 dirty 格子出发 (位板须与 cells 一致)
+    bool findWinning(bool incremental, RoundStats& stats, std::vector<WinBlock>* blocks);
+    // 消除 winBits[0] 中的格子并下落补牌, 同时记录 dirty
+    void collapse();
 };
 #endif
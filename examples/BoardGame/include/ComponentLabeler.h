@@ -0,0 +1,80 @@
+#ifndef COMPONENTLABELER_H
+#define COMPONENTLABELER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 一个获胜块: 值 value 的一个连通块 (含其中的赖子格) 共 size 格
+struct WinBlock {
+    int value;
+    int size;
+};
+
+// 并查集连通块标记: 一次光栅扫描同时得到所有牌值的连通块, 不再按值逐一搜索.
+// 棋盘为行主序的连续存储, cells[r * cols + c].
+//
+// 赖子格可以同时属于多个值的连通块: 先把相邻的赖子格合并成赖子团,
+// 每个赖子团再为每个牌值各建一个节点 (初始大小为团的格子数), 与团周围该值的格子合并.
+// 没有任何相邻值格的赖子团也保留各值的节点, 与逐值搜索的结果一致 (纯赖子块对所有值都成立).
+// 所有缓冲区在构造时按最坏情况分配, label 不申请堆内存.
+class ComponentLabeler {
+public:
+    static const int MAX_VALUE = 11;
+
+    ComponentLabeler(int rows, int cols, int laizi = 0);
+
+    // 标记 cells 中所有值的连通块, 返回是否存在格子数 >= minSize 的块
+    bool label(const int* cells, int minSize);
+
+    // 值 val 的获胜块格子数 (与 Bitboard::collectWinning 的返回值相同)
+    int blockCells(int val) const { return blocks[val]; }
+    // 各值获胜块并集的格子数
+    int clearedCount() const { return cleared; }
+    // 每格一个字节, 非 0 表示该格属于某个获胜块
+    const uint8_t* removedCells() const { return removed.data(); }
+    // 所有获胜块; 纯赖子块对每个值各算一块. 同一值各块大小之和等于 blockCells(val)
+    const std::vector<WinBlock>& winningBlocks() const { return wins; }
+
+    int rows() const { return ROWS; }
+    int cols() const { return COLS; }
+
+private:
+    int ROWS, COLS, LAIZI;
+    // 节点: [0, cells) 为格子, 其后每个赖子团占 MAX_VALUE 个节点 (值 1 ~ MAX_VALUE)
+    std::vector<int> parent;
+    std::vector<int> size;
+    std::vector<int> clusterOf;   // 赖子团根格子 -> 团编号, 其余为 -1
+    std::vector<int> clusterRoot; // 团编号 -> 根格子
+    std::vector<int> clusterWin;  // 团编号 -> 获胜值的位集 (第 v 位表示值 v)
+    std::vector<int> wildCells;   // 本次标记中的赖子格下标
+    std::vector<uint8_t> removed;
+    std::vector<WinBlock> wins;
+    int blocks[MAX_VALUE + 1] = {};
+    int cleared = 0;
+
+    // 路径减半
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // 按大小合并
+    void unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+    }
+
+    int valueNode(int cluster, int val) const {
+        return ROWS * COLS + cluster * MAX_VALUE + (val - 1);
+    }
+};
+
+#endif
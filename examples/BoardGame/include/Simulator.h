@@ -0,0 +1,43 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "BoardGame.h"
+#include <GameMath/ThreadPool.hpp>
+#include <cstdint>
+#include <vector>
+
+// 批量模拟参数
+struct SimulationConfig {
+    int rows = 6;
+    int cols = 5;
+    uint64_t games = 1000;
+    uint64_t seed = 0;
+    int maxRounds = 100;        // 单局连锁轮数上限
+    int maxValue = 11;          // 初始盘面与补牌均匀取 0 (赖子) ~ maxValue
+    size_t gamesPerTask = 16;   // 每次领取任务的局数
+};
+
+// 批量模拟统计, 各计数均为所有局之和
+struct SimulationStats {
+    uint64_t games = 0;
+    uint64_t rounds = 0;            // 发生消除的总轮数
+    uint64_t cleared = 0;           // 消除的总格子数
+    uint64_t truncated = 0;         // 达到轮数上限的局数
+    std::vector<uint64_t> cascadeLength;  // [n] = 恰好连锁 n 轮的局数, n ∈ [0, maxRounds]
+    std::vector<uint64_t> blockSize;      // [n] = 格子数为 n 的获胜块 (单个连通块) 个数, n ∈ [0, rows * cols]
+    uint64_t valueWins[Bitboard::MAX_VALUE + 1] = {};  // 各值出现获胜块的轮次数
+    double seconds = 0.0;
+
+    double gamesPerSecond() const { return seconds > 0.0 ? games / seconds : 0.0; }
+    double averageRounds() const { return games ? double(rounds) / games : 0.0; }
+
+    void reset(int maxRounds, int cells);
+    void merge(const SimulationStats& other);
+};
+
+// 在线程池上并行模拟 config.games 局独立的连锁消除.
+// 第 i 局的初始盘面与补牌序列只由 (seed, i) 决定, 结果与线程数和调度无关.
+// 每个线程持有自己的 BoardGame、随机数引擎与统计, 模拟过程中没有锁与共享写入, 结束后由调用线程合并.
+SimulationStats simulate(const SimulationConfig& config, GameMath::ThreadPool& pool);
+
+#endif
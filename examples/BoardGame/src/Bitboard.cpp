@@ -0,0 +1,203 @@
+#include "Bitboard.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+Bitboard::Bitboard(int rows, int cols)
+    : ROWS(rows), COLS(cols), WORDS((cols + 63) / 64) {
+    masks.assign((MAX_VALUE + 1) * words(), 0);
+    remain.assign(words(), 0);
+    comp.assign(words(), 0);
+}
+
+int Bitboard::popcount(uint64_t x) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+int Bitboard::lowestBit(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+int Bitboard::popcount(const uint64_t* bits, size_t count) {
+    int total = 0;
+    for (size_t i = 0; i < count; ++i) total += popcount(bits[i]);
+    return total;
+}
+
+void Bitboard::load(const int* cells, int laizi) {
+    std::fill(masks.begin(), masks.end(), 0);
+    uint64_t* all = &masks[0];  // 掩码 0 暂存赖子格
+    for (int r = 0; r < ROWS; ++r) {
+        for (int c = 0; c < COLS; ++c) {
+            int v = cells[r * COLS + c];
+            uint64_t bit = uint64_t(1) << (c & 63);
+            size_t w = static_cast<size_t>(r) * WORDS + (c >> 6);
+            if (v == laizi) {
+                all[w] |= bit;
+            } else if (v >= 1 && v <= MAX_VALUE) {
+                masks[v * words() + w] |= bit;
+            }
+        }
+    }
+    for (int v = 1; v <= MAX_VALUE; ++v) {
+        uint64_t* m = &masks[v * words()];
+        for (size_t w = 0; w < words(); ++w) m[w] |= all[w];
+    }
+}
+
+void Bitboard::setCell(int r, int c, int v, int laizi) {
+    uint64_t bit = uint64_t(1) << (c & 63);
+    size_t w = static_cast<size_t>(r) * WORDS + (c >> 6);
+    size_t n = words();
+    if (v == laizi) {
+        for (int k = 0; k <= MAX_VALUE; ++k) masks[k * n + w] |= bit;
+        return;
+    }
+    for (int k = 0; k <= MAX_VALUE; ++k) masks[k * n + w] &= ~bit;
+    if (v >= 1 && v <= MAX_VALUE) masks[v * n + w] |= bit;
+}
+
+void Bitboard::update(const int* cells, int laizi, const uint64_t* dirty, int dirtyRows) {
+    for (int r = 0; r < dirtyRows; ++r) {
+        for (int i = 0; i < WORDS; ++i) {
+            uint64_t m = dirty[static_cast<size_t>(r) * WORDS + i];
+            while (m) {
+                int c = i * 64 + lowestBit(m);
+                m &= m - 1;
+                setCell(r, c, cells[r * COLS + c], laizi);
+            }
+        }
+    }
+}
+
+void Bitboard::fillRow(const uint64_t* mask, int r) {
+    uint64_t* x = &comp[static_cast<size_t>(r) * WORDS];
+    const uint64_t* m = mask + static_cast<size_t>(r) * WORDS;
+    bool again = true;
+    while (again) {
+        again = false;
+        for (int i = left; i <= right; ++i) {
+            uint64_t grown = x[i] | (x[i] << 1) | (x[i] >> 1);
+            if (i > 0) grown |= x[i - 1] >> 63;
+            if (i + 1 < WORDS) grown |= x[i + 1] << 63;
+            grown &= m[i];
+            if (grown != x[i]) {
+                x[i] = grown;
+                again = true;
+            }
+        }
+        // 连通块越过字边界时扩大列范围
+        if (left > 0 && (x[left] & 1) && (m[left - 1] >> 63)) {
+            --left;
+            again = true;
+        }
+        if (right + 1 < WORDS && (x[right] >> 63) && (m[right + 1] & 1)) {
+            ++right;
+            again = true;
+        }
+    }
+}
+
+bool Bitboard::growRow(const uint64_t* mask, int r, int from) {
+    uint64_t* x = &comp[static_cast<size_t>(r) * WORDS];
+    const uint64_t* y = &comp[static_cast<size_t>(from) * WORDS];
+    const uint64_t* m = mask + static_cast<size_t>(r) * WORDS;
+    bool seeded = false;
+    for (int i = left; i <= right; ++i) {
+        uint64_t grown = x[i] | (y[i] & m[i]);
+        if (grown != x[i]) {
+            x[i] = grown;
+            seeded = true;
+        }
+    }
+    // 本行没有新增种子时横向已处于不动点
+    if (!seeded) return false;
+    fillRow(mask, r);
+    return true;
+}
+
+int Bitboard::flood(const uint64_t* mask, int seedRow, int seedWord, uint64_t seedBit, int& top, int& bottom) {
+    comp[static_cast<size_t>(seedRow) * WORDS + seedWord] = seedBit;
+    top = bottom = seedRow;
+    left = right = seedWord;
+    fillRow(mask, seedRow);
+
+    // 交替向下、向上逐行扫描, 直到一整轮没有变化 (蛇形连通块需要多轮)
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int r = top + 1; r < ROWS; ++r) {
+            if (!growRow(mask, r, r - 1)) {
+                if (r > bottom) break;
+                continue;
+            }
+            changed = true;
+            bottom = std::max(bottom, r);
+        }
+        for (int r = bottom - 1; r >= 0; --r) {
+            if (!growRow(mask, r, r + 1)) {
+                if (r < top) break;
+                continue;
+            }
+            changed = true;
+            top = std::min(top, r);
+        }
+    }
+    int size = 0;
+    for (int r = top; r <= bottom; ++r) {
+        size += popcount(&comp[static_cast<size_t>(r) * WORDS + left], static_cast<size_t>(right - left + 1));
+    }
+    return size;
+}
+
+int Bitboard::collectWinning(int val, int minSize, uint64_t* win, std::vector<int>* sizes) {
+    std::fill(remain.begin(), remain.end(), ~uint64_t(0));
+    return collectWinning(val, minSize, win, remain.data(), ROWS, sizes);
+}
+
+int Bitboard::collectWinning(int val, int minSize, uint64_t* win, const uint64_t* seeds, int seedRows,
+                             std::vector<int>* sizes) {
+    const uint64_t* mask = this->mask(val);
+    size_t total = static_cast<size_t>(seedRows) * WORDS;
+    // seeds 可能就是 remain 本身 (全盘搜索), 逐字原地求交
+    for (size_t w = 0; w < total; ++w) remain[w] = mask[w] & seeds[w];
+
+    int added = 0;
+    for (size_t w = 0; w < total; ) {
+        if (remain[w] == 0) {
+            ++w;
+            continue;
+        }
+        uint64_t seed = remain[w] & (0 - remain[w]);
+        int top, bottom;
+        int size = flood(mask, static_cast<int>(w / WORDS), static_cast<int>(w % WORDS), seed, top, bottom);
+        if (sizes && size >= minSize) sizes->push_back(size);
+
+        // 连通块可能越过 seedRows, remain 只维护前 seedRows 行
+        int last = std::min(bottom, seedRows - 1);
+        for (int r = top; r <= bottom; ++r) {
+            size_t first = static_cast<size_t>(r) * WORDS;
+            for (size_t i = first + left; i <= first + right; ++i) {
+                if (r <= last) remain[i] &= ~comp[i];
+                if (size >= minSize) {
+                    added += popcount(comp[i] & ~win[i]);
+                    win[i] |= comp[i];
+                }
+                comp[i] = 0;
+            }
+        }
+    }
+    return added;
+}
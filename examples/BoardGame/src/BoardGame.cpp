@@ -1,108 +1,140 @@
 #include "BoardGame.h"
+#include <algorithm>
 #include <iostream>
-#include <queue>
 
-BoardGame::BoardGame(int rows, int cols) : ROWS(rows), COLS(cols) {
-    board.resize(ROWS, std::vector<int>(COLS, 0));
+BoardGame::BoardGame(int rows, int cols)
+    : ROWS(rows), COLS(cols), labeler(rows, cols, LAIZI), bits(rows, cols) {
+    cells.assign(static_cast<size_t>(ROWS) * COLS, 0);
+    winBits.assign((Bitboard::MAX_VALUE + 1) * bits.words(), 0);
+    dirty.assign(bits.words(), 0);
 }
 
 void BoardGame::setBoard(const std::vector<std::vector<int>>& b) {
-    board = b;
+    for(int r = 0; r < ROWS; ++r) std::copy(b[r].begin(), b[r].begin() + COLS, cells.begin() + r * COLS);
+}
+
+void BoardGame::setBoard(const int* b) {
+    std::copy(b, b + cells.size(), cells.begin());
 }
 
 int BoardGame::getCard(int row, int col) {
-    // 补牌函数示例，固定返回1，可根据需求修改
-    return 1;
+    // 补牌函数示例，默认固定返回1，可通过 setCardSource 替换
+    return cardSource ? cardSource(row, col) : 1;
 }
 
 bool BoardGame::isSame(int a, int b) {
     return a == LAIZI || b == LAIZI || a == b;
 }
 
-void BoardGame::bfs(int r, int c, int val, std::vector<std::vector<bool>>& visited,
-                    std::vector<std::pair<int,int>>& comp) {
-    // 方向向量: 向下	-> 向上	-> 向右	-> 向左
-    static const int dr[4] = {1, -1, 0, 0};
-    static const int dc[4] = {0, 0, 1, -1};
-
-    std::queue<std::pair<int,int>> q;
-    q.emplace(r,c);
-    visited[r][c] = true;
-
-    // 连通块集合
-    comp.push_back({r,c});
-
-    while(!q.empty()) {
-        auto cur = q.front(); q.pop();
-
-        int cr = cur.first, cc = cur.second;
-
-        // 遍历四个方向
-        for(int d = 0; d < 4; ++d) {
-            int nr = cr + dr[d], nc = cc + dc[d];
-            if(nr < 0 || nr >= ROWS || nc < 0 || nc >= COLS) continue;
-            if(visited[nr][nc]) continue;
-            if(board[nr][nc] == val || board[nr][nc] == LAIZI) {
-                visited[nr][nc] = true;
-                comp.push_back({nr,nc});
-                q.emplace(nr,nc);
+bool BoardGame::findWinning(bool incremental, RoundStats& stats, std::vector<WinBlock>* blocks) {
+    size_t words = bits.words();
+    uint64_t* removed = winBits.data();
+    if(!incremental) {
+        // 一次并查集扫描得到所有值的连通块
+        std::fill(removed, removed + words, 0);
+        bool anyWin = labeler.label(cells.data(), MIN_BLOCK);
+        for(int val = 1; val <= Bitboard::MAX_VALUE; ++val) stats.blockCells[val] = labeler.blockCells(val);
+        stats.cleared = labeler.clearedCount();
+        if(!anyWin) return false;
+        if(blocks) blocks->insert(blocks->end(), labeler.winningBlocks().begin(), labeler.winningBlocks().end());
+        const uint8_t* hit = labeler.removedCells();
+        for(int r = 0; r < ROWS; ++r) {
+            for(int c = 0; c < COLS; ++c) {
+                if(hit[r * COLS + c]) removed[static_cast<size_t>(r) * bits.wordsPerRow() + (c >> 6)] |= uint64_t(1) << (c & 63);
             }
         }
+        return true;
     }
-}
 
-void BoardGame::play() {
-    int round = 0;
-    ++round;
+    std::fill(winBits.begin(), winBits.end(), 0);
+    bool anyWin = false;
+    for(int val = 1; val <= Bitboard::MAX_VALUE; ++val) {
+        uint64_t* win = &winBits[val * words];
+        blockSizes.clear();
+        stats.blockCells[val] = bits.collectWinning(val, MIN_BLOCK, win, dirty.data(), dirtyRows, blocks ? &blockSizes : nullptr);
+        if(stats.blockCells[val] == 0) continue;
+        for(int size : blockSizes) blocks->push_back({val, size});
+        anyWin = true;
+        for(size_t w = 0; w < words; ++w) removed[w] |= win[w];
+    }
+    stats.cleared = anyWin ? Bitboard::popcount(removed, words) : 0;
+    return anyWin;
+}
 
-    std::map<int, std::set<std::pair<int,int>>> winBlocks;
+void BoardGame::collapse() {
+    // 自底向上压实未消除的牌, 顶部空位调用 getCard.
+    // 某列最低的消除格及其以上的格子都可能改变, 记为 dirty; 其下方的格子不动.
+    const uint64_t* removed = winBits.data();
+    int words = bits.wordsPerRow();
+    std::fill(dirty.begin(), dirty.begin() + static_cast<size_t>(dirtyRows) * words, 0);
+    dirtyRows = 0;
+    for(int c = 0; c < COLS; ++c) {
+        int lowest = ROWS - 1;
+        while(lowest >= 0 && !bits.test(removed, lowest, c)) --lowest;
+        if(lowest < 0) continue;
 
-    // 对每个数字1~11做连通块搜索
-    for(int val = 1; val <= 11; ++val) {
-        std::vector<std::vector<bool>> visited(ROWS, std::vector<bool>(COLS, false));
-        for(int r = 0; r < ROWS; ++r) {
-            for(int c = 0; c < COLS; ++c) {
-                if(!visited[r][c] && (board[r][c] == val || board[r][c] == LAIZI)) {
-                    std::vector<std::pair<int,int>> comp;
-                    bfs(r, c, val, visited, comp);
-                    if((int)comp.size() >= 5) {
-                        for(auto &p : comp) {
-                            winBlocks[val].insert(p);
-                        }
-                    }
-                }
-            }
+        int dst = lowest;
+        for(int r = lowest; r >= 0; --r) {
+            if(!bits.test(removed, r, c)) cells[(dst--) * COLS + c] = cells[r * COLS + c];
         }
+        for(int r = 0; r <= dst; ++r) cells[r * COLS + c] = getCard(r, c);
+
+        uint64_t bit = uint64_t(1) << (c & 63);
+        for(int r = 0; r <= lowest; ++r) dirty[static_cast<size_t>(r) * words + (c >> 6)] |= bit;
+        dirtyRows = std::max(dirtyRows, lowest + 1);
     }
+}
 
-    if(winBlocks.empty()) {
+void BoardGame::play() {
+    int round = 0;
+    ++round;
+
+    RoundStats stats;
+    if(!findWinning(false, stats, nullptr)) {
         // 无获胜块，结束
         return;
     }
 
     // 输出获胜块信息
-    for(auto &kv : winBlocks) {
-        std::cout << round << " " << kv.first << " " << kv.second.size() << "\n";
+    for(int val = 1; val <= Bitboard::MAX_VALUE; ++val) {
+        if(stats.blockCells[val] > 0) std::cout << round << " " << val << " " << stats.blockCells[val] << "\n";
     }
 
-    // 标记消除
-    std::vector<std::vector<bool>> toRemove(ROWS, std::vector<bool>(COLS, false));
-    for(auto &kv : winBlocks) {
-        for(auto &p : kv.second) {
-            toRemove[p.first][p.second] = true;
-        }
-    }
+    collapse();
+}
 
-    // 消除并下落补牌
-    for(int c = 0; c < COLS; ++c) {
-        std::vector<int> colCards;
-        for(int r = 0; r < ROWS; ++r) {
-            if(!toRemove[r][c]) colCards.push_back(board[r][c]);
+CascadeStats BoardGame::cascade(int maxRounds) {
+    CascadeStats stats;
+    cascade(stats, maxRounds);
+    return stats;
+}
+
+void BoardGame::cascade(CascadeStats& stats, int maxRounds) {
+    stats.rounds = 0;
+    stats.totalCleared = 0;
+    stats.truncated = false;
+    stats.perRound.clear();
+    stats.blocks.clear();
+
+    bits.load(cells.data(), LAIZI);
+    RoundStats round;
+    bool incremental = false;
+    round.firstBlock = 0;
+    while(findWinning(incremental, round, &stats.blocks)) {
+        if(stats.rounds == maxRounds) {
+            // 丢弃未计入的这一轮的获胜块
+            stats.blocks.resize(round.firstBlock);
+            stats.truncated = true;
+            return;
         }
-        int newCount = ROWS - (int)colCards.size();
-        std::vector<int> newCol;
-        for(int i = 0; i < newCount; ++i) newCol.push_back(getCard(i, c));
-        for(int v : colCards) newCol.push_back(v);
-        for(int r = 0; r < ROWS; ++r) board[r][c] = newCol[r];
+        round.round = ++stats.rounds;
+        round.blockCount = static_cast<int>(stats.blocks.size()) - round.firstBlock;
+        stats.totalCleared += round.cleared;
+        stats.perRound.push_back(round);
+
+        collapse();
+        bits.update(cells.data(), LAIZI, dirty.data(), dirtyRows);
+        incremental = true;
+        round.firstBlock = static_cast<int>(stats.blocks.size());
     }
 }
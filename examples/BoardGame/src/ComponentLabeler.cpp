@@ -0,0 +1,99 @@
+#include "ComponentLabeler.h"
+#include <algorithm>
+
+ComponentLabeler::ComponentLabeler(int rows, int cols, int laizi)
+    : ROWS(rows), COLS(cols), LAIZI(laizi) {
+    size_t cells = static_cast<size_t>(rows) * cols;
+    // 最坏情况每格都是一个赖子团
+    parent.resize(cells * (MAX_VALUE + 1));
+    size.resize(cells * (MAX_VALUE + 1));
+    clusterOf.assign(cells, -1);
+    clusterRoot.resize(cells);
+    clusterWin.resize(cells);
+    wildCells.resize(cells);
+    removed.resize(cells);
+    // 每块至少 1 格, 每格至多属于 MAX_VALUE 个块
+    wins.reserve(cells * MAX_VALUE);
+}
+
+bool ComponentLabeler::label(const int* cells, int minSize) {
+    // 第一遍: 光栅扫描, 相同值 (包括赖子与赖子) 的左邻、上邻合并
+    int wild = 0;
+    for (int r = 0; r < ROWS; ++r) {
+        for (int c = 0; c < COLS; ++c) {
+            int i = r * COLS + c;
+            int v = cells[i];
+            size[i] = 1;
+            parent[i] = (c > 0 && cells[i - 1] == v) ? find(i - 1) : i;
+            if (parent[i] != i) ++size[parent[i]];
+            if (r > 0 && cells[i - COLS] == v) unite(i, i - COLS);
+            if (v == LAIZI) wildCells[wild++] = i;
+        }
+    }
+
+    // 第二遍 (只看赖子格): 为每个赖子团建立各值节点, 与团周围该值的格子合并
+    int clusters = 0;
+    for (int k = 0; k < wild; ++k) {
+        int i = wildCells[k];
+        int root = find(i);
+        int cluster = clusterOf[root];
+        if (cluster < 0) {
+            cluster = clusterOf[root] = clusters;
+            clusterRoot[clusters++] = root;
+            for (int v = 1; v <= MAX_VALUE; ++v) {
+                int node = valueNode(cluster, v);
+                parent[node] = node;
+                size[node] = size[root];
+            }
+        }
+        int r = i / COLS, c = i % COLS;
+        int neighbors[4] = {r > 0 ? i - COLS : -1, r + 1 < ROWS ? i + COLS : -1,
+                            c > 0 ? i - 1 : -1, c + 1 < COLS ? i + 1 : -1};
+        for (int j : neighbors) {
+            if (j < 0) continue;
+            int v = cells[j];
+            if (v != LAIZI && v >= 1 && v <= MAX_VALUE) unite(j, valueNode(cluster, v));
+        }
+    }
+
+    // 统计: 普通格只属于自身值的块, 赖子团按值逐一判断
+    // 每个连通块的根恰好是一个普通格或赖子团的值节点, 以此逐块记录
+    std::fill(blocks, blocks + MAX_VALUE + 1, 0);
+    cleared = 0;
+    wins.clear();
+    for (int k = 0; k < clusters; ++k) {
+        int win = 0;
+        int count = size[clusterRoot[k]];
+        for (int v = 1; v <= MAX_VALUE; ++v) {
+            int node = valueNode(k, v);
+            int root = find(node);
+            if (size[root] >= minSize) {
+                win |= 1 << v;
+                blocks[v] += count;
+                if (root == node) wins.push_back({v, size[node]});
+            }
+        }
+        clusterWin[k] = win;
+        if (win) cleared += count;
+    }
+    int total = ROWS * COLS;
+    for (int i = 0; i < total; ++i) {
+        int v = cells[i];
+        bool hit;
+        if (v == LAIZI) {
+            hit = clusterWin[clusterOf[find(i)]] != 0;
+        } else {
+            int root = find(i);
+            hit = v >= 1 && v <= MAX_VALUE && size[root] >= minSize;
+            if (hit) {
+                ++blocks[v];
+                ++cleared;
+                if (root == i) wins.push_back({v, size[i]});
+            }
+        }
+        removed[i] = hit;
+    }
+
+    for (int k = 0; k < clusters; ++k) clusterOf[clusterRoot[k]] = -1;
+    return cleared > 0;
+}
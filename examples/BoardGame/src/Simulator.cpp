@@ -0,0 +1,84 @@
+#include "Simulator.h"
+#include <GameMath/Random.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+    // 每个线程的私有状态, 按缓存行对齐避免伪共享
+    struct alignas(64) Worker {
+        std::unique_ptr<BoardGame> game;
+        GameMath::Xoshiro128 rng;
+        std::vector<int> cells;
+        CascadeStats cascade;
+        SimulationStats stats;
+    };
+
+    // 由种子与局号得到该局引擎的种子 (SplitMix64 的一步)
+    uint64_t gameSeed(uint64_t seed, uint64_t game) {
+        uint64_t z = seed + (game + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+}
+
+void SimulationStats::reset(int maxRounds, int cells) {
+    *this = SimulationStats();
+    cascadeLength.assign(maxRounds + 1, 0);
+    blockSize.assign(cells + 1, 0);
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    games += other.games;
+    rounds += other.rounds;
+    cleared += other.cleared;
+    truncated += other.truncated;
+    for(size_t i = 0; i < cascadeLength.size() && i < other.cascadeLength.size(); ++i) cascadeLength[i] += other.cascadeLength[i];
+    for(size_t i = 0; i < blockSize.size() && i < other.blockSize.size(); ++i) blockSize[i] += other.blockSize[i];
+    for(int v = 0; v <= Bitboard::MAX_VALUE; ++v) valueWins[v] += other.valueWins[v];
+}
+
+SimulationStats simulate(const SimulationConfig& config, GameMath::ThreadPool& pool) {
+    if(config.rows <= 0 || config.cols <= 0 || config.maxRounds < 0 ||
+       config.maxValue < 1 || config.maxValue > Bitboard::MAX_VALUE) {
+        throw std::invalid_argument("Invalid simulation config");
+    }
+    int cellCount = config.rows * config.cols;
+    uint32_t values = static_cast<uint32_t>(config.maxValue) + 1;
+
+    std::vector<Worker> workers(pool.size());
+    for(Worker& w : workers) w.stats.reset(config.maxRounds, cellCount);
+
+    auto start = std::chrono::steady_clock::now();
+    pool.parallel_for(config.games, [&](size_t game, size_t worker) {
+        Worker& w = workers[worker];
+        if(!w.game) {
+            // 每个线程首次领取任务时分配, 之后各局复用
+            w.game.reset(new BoardGame(config.rows, config.cols));
+            w.game->setCardSource([&w, values](int, int) { return static_cast<int>(w.rng.next_below(values)); });
+            w.cells.resize(cellCount);
+        }
+        w.rng.seed(gameSeed(config.seed, game));
+        for(int& v : w.cells) v = static_cast<int>(w.rng.next_below(values));
+        w.game->setBoard(w.cells.data());
+        w.game->cascade(w.cascade, config.maxRounds);
+
+        SimulationStats& s = w.stats;
+        ++s.games;
+        s.rounds += w.cascade.rounds;
+        s.cleared += w.cascade.totalCleared;
+        s.truncated += w.cascade.truncated;
+        ++s.cascadeLength[w.cascade.rounds];
+        for(const RoundStats& round : w.cascade.perRound) {
+            for(int v = 1; v <= Bitboard::MAX_VALUE; ++v) s.valueWins[v] += round.blockCells[v] > 0;
+        }
+        for(const WinBlock& block : w.cascade.blocks) ++s.blockSize[block.size];
+    }, config.gamesPerTask);
+
+    SimulationStats total;
+    total.reset(config.maxRounds, cellCount);
+    for(const Worker& w : workers) total.merge(w.stats);
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
@@ -11,27 +11,23 @@ int main() {
         {2, 2, 0, 0, 0, 0}
     };
 
-    auto rotated = GameMath::rotate_90_clockwise(originalBoard);
+    // 旋转只改变视图的起点与步长, 复制一次到连续的行主序棋盘
+    auto rotated = GameMath::view(originalBoard).rotated_cw();
 
-    std::vector<std::vector<int>> result(rotated.numRows(), std::vector<int>(rotated.numCols()));
-
-    for (int i = 0; i < rotated.numRows(); ++i) {
-        for (int j = 0; j < rotated.numCols(); ++j) {
-            result[i][j] = rotated(i, j);
-        }
-    }
+    std::vector<int> cells(rotated.size());
+    rotated.copy_to(cells.data());
 
     std::cout << "rotated:\n";
-    for (const auto& row : result) {
-        for (const auto& val : row) {
-            std::cout << val << " ";
+    for (size_t i = 0; i < rotated.rows(); ++i) {
+        for (size_t j = 0; j < rotated.cols(); ++j) {
+            std::cout << cells[i * rotated.cols() + j] << " ";
         }
         std::cout << "\n";
     }
     std::cout << "\n";
 
     BoardGame game(6, 5);
-    game.setBoard(result);
+    game.setBoard(cells.data());
     game.play();
     
     return 0;
@@ -0,0 +1,349 @@
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "Bitboard.h"
+#include "BoardGame.h"
+#include "ComponentLabeler.h"
+#include "Simulator.h"
+
+namespace {
+
+const int LAIZI = 0;
+const int MIN_BLOCK = 5;
+
+// 逐值 BFS 的参考实现 (与改写前的 play() 相同)
+struct Reference {
+    std::vector<std::vector<uint8_t>> win;      // win[v][i]: 格子 i 属于值 v 的获胜块
+    int blockCells[Bitboard::MAX_VALUE + 1] = {};
+    std::vector<std::pair<int, int>> blocks;    // 每个获胜块的 (值, 格子数)
+};
+
+Reference referenceSearch(const std::vector<int>& cells, int rows, int cols) {
+    Reference ref;
+    ref.win.assign(Bitboard::MAX_VALUE + 1, std::vector<uint8_t>(cells.size(), 0));
+    std::vector<int> comp;
+    for (int val = 1; val <= Bitboard::MAX_VALUE; ++val) {
+        std::vector<uint8_t> visited(cells.size(), 0);
+        auto match = [&](int i) { return cells[i] == val || cells[i] == LAIZI; };
+        for (int start = 0; start < rows * cols; ++start) {
+            if (visited[start] || !match(start)) continue;
+            comp.clear();
+            std::queue<int> q;
+            q.push(start);
+            visited[start] = 1;
+            while (!q.empty()) {
+                int i = q.front();
+                q.pop();
+                comp.push_back(i);
+                int r = i / cols, c = i % cols;
+                int next[4] = {r > 0 ? i - cols : -1, r + 1 < rows ? i + cols : -1,
+                               c > 0 ? i - 1 : -1, c + 1 < cols ? i + 1 : -1};
+                for (int j : next) {
+                    if (j < 0 || visited[j] || !match(j)) continue;
+                    visited[j] = 1;
+                    q.push(j);
+                }
+            }
+            if (static_cast<int>(comp.size()) < MIN_BLOCK) continue;
+            for (int i : comp) ref.win[val][i] = 1;
+            ref.blockCells[val] += static_cast<int>(comp.size());
+            ref.blocks.emplace_back(val, static_cast<int>(comp.size()));
+        }
+    }
+    return ref;
+}
+
+// 按 (值, 格子数) 排序后比较获胜块
+template<typename It>
+void checkBlocks(It first, It last, std::vector<std::pair<int, int>> expected) {
+    std::vector<std::pair<int, int>> actual;
+    for (It it = first; it != last; ++it) actual.emplace_back(it->value, it->size);
+    std::sort(actual.begin(), actual.end());
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(actual == expected);
+}
+
+// 值取 0 ~ maxValue, laiziPercent 控制赖子比例
+std::vector<int> randomBoard(std::mt19937& rng, int rows, int cols, int maxValue, int laiziPercent) {
+    std::uniform_int_distribution<int> value(1, maxValue);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<int> cells(static_cast<size_t>(rows) * cols);
+    for (int& v : cells) v = percent(rng) < laiziPercent ? LAIZI : value(rng);
+    return cells;
+}
+
+// 随机尺寸, 列数经常落在 64 位字边界附近
+void randomShape(std::mt19937& rng, int& rows, int& cols) {
+    static const int edgeCols[] = {1, 5, 63, 64, 65, 127, 128, 129, 140};
+    std::uniform_int_distribution<int> pick(0, 17);
+    int k = pick(rng);
+    cols = k < 9 ? edgeCols[k] : std::uniform_int_distribution<int>(2, 140)(rng);
+    rows = std::uniform_int_distribution<int>(1, 70)(rng);
+}
+
+// 并查集标记的结果与参考实现逐项比较
+void checkLabeler(ComponentLabeler& labeler, const std::vector<int>& cells, int rows, int cols) {
+    Reference ref = referenceSearch(cells, rows, cols);
+    bool anyWin = labeler.label(cells.data(), MIN_BLOCK);
+    int cleared = 0;
+    for (int i = 0; i < rows * cols; ++i) {
+        bool hit = false;
+        for (int val = 1; val <= Bitboard::MAX_VALUE; ++val) hit = hit || ref.win[val][i];
+        REQUIRE((labeler.removedCells()[i] != 0) == hit);
+        cleared += hit;
+    }
+    for (int val = 1; val <= Bitboard::MAX_VALUE; ++val) REQUIRE(labeler.blockCells(val) == ref.blockCells[val]);
+    REQUIRE(labeler.clearedCount() == cleared);
+    REQUIRE(anyWin == (cleared > 0));
+    checkBlocks(labeler.winningBlocks().begin(), labeler.winningBlocks().end(), ref.blocks);
+}
+
+// 补牌来源: 按调用顺序取随机牌, 相同种子的两个棋盘得到相同的补牌序列
+std::function<int(int, int)> randomCards(unsigned seed, int maxValue, int laiziPercent) {
+    std::mt19937 rng(seed);
+    return [rng, maxValue, laiziPercent](int, int) mutable {
+        if (std::uniform_int_distribution<int>(0, 99)(rng) < laiziPercent) return LAIZI;
+        return std::uniform_int_distribution<int>(1, maxValue)(rng);
+    };
+}
+
+// 执行一轮全盘扫描的 play(), 丢弃其输出
+void playQuietly(BoardGame& game) {
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+    game.play();
+    std::cout.rdbuf(saved);
+}
+
+} // namespace
+
+TEST_CASE("Bitboard flood fill matches per-value BFS", "[bitboard]") {
+    std::mt19937 rng(2024);
+    for (int board = 0; board < 1000; ++board) {
+        int rows, cols;
+        randomShape(rng, rows, cols);
+        int maxValue = 1 + board % 4;
+        int laiziPercent = board % 3 == 0 ? 60 : 10;
+        std::vector<int> cells = randomBoard(rng, rows, cols, maxValue, laiziPercent);
+        Reference ref = referenceSearch(cells, rows, cols);
+
+        Bitboard bits(rows, cols);
+        bits.load(cells.data(), LAIZI);
+        std::vector<uint64_t> win(bits.words());
+        std::vector<WinBlock> blocks;
+        std::vector<int> sizes;
+        for (int val = 1; val <= Bitboard::MAX_VALUE; ++val) {
+            std::fill(win.begin(), win.end(), 0);
+            sizes.clear();
+            REQUIRE(bits.collectWinning(val, MIN_BLOCK, win.data(), &sizes) == ref.blockCells[val]);
+            for (int size : sizes) blocks.push_back({val, size});
+            for (int r = 0; r < rows; ++r) {
+                for (int c = 0; c < cols; ++c) {
+                    REQUIRE(bits.test(win.data(), r, c) == (ref.win[val][r * cols + c] != 0));
+                }
+            }
+            // 列数之外的填充位保持为 0
+            if (cols % 64) {
+                for (int r = 0; r < rows; ++r) REQUIRE((win[static_cast<size_t>(r) * bits.wordsPerRow() + cols / 64] >> (cols % 64)) == 0);
+            }
+        }
+        checkBlocks(blocks.begin(), blocks.end(), ref.blocks);
+    }
+
+    // 蛇形块跨越字边界: 第 63、64 列来回连通
+    const int rows = 6, cols = 130;
+    std::vector<int> cells(rows * cols, 2);
+    for (int r = 0; r < rows; ++r) cells[r * cols + (r % 2 ? 63 : 64)] = 1;
+    for (int r = 0; r + 1 < rows; ++r) cells[r * cols + (r % 2 ? 64 : 63)] = 1;
+    Reference ref = referenceSearch(cells, rows, cols);
+    Bitboard bits(rows, cols);
+    bits.load(cells.data(), LAIZI);
+    std::vector<uint64_t> win(bits.words(), 0);
+    REQUIRE(bits.collectWinning(1, MIN_BLOCK, win.data()) == ref.blockCells[1]);
+    REQUIRE(ref.blockCells[1] == 11);
+}
+
+TEST_CASE("Incremental cascade matches repeated full-rescan rounds", "[cascade]") {
+    std::mt19937 rng(7);
+    int truncatedRuns = 0;
+    for (int board = 0; board < 300; ++board) {
+        int rows, cols;
+        randomShape(rng, rows, cols);
+        rows = 1 + rows % 12;
+        int maxValue = 2 + board % 3;
+        int laiziPercent = board % 4 == 0 ? 40 : 8;
+        int maxRounds = board % 5 == 0 ? 1 + board % 3 : 40;
+        std::vector<int> cells = randomBoard(rng, rows, cols, maxValue, laiziPercent);
+        unsigned seed = static_cast<unsigned>(rng());
+
+        BoardGame game(rows, cols), reference(rows, cols);
+        game.setBoard(cells.data());
+        reference.setBoard(cells.data());
+        game.setCardSource(randomCards(seed, maxValue, laiziPercent));
+        reference.setCardSource(randomCards(seed, maxValue, laiziPercent));
+
+        CascadeStats stats = game.cascade(maxRounds);
+
+        // 参考: 每轮先用逐值 BFS 求期望统计, 再由 play() 全盘扫描、消除并下落补牌
+        int rounds = 0, totalCleared = 0;
+        bool truncated = false;
+        for (;;) {
+            Reference ref = referenceSearch(reference.getCells(), rows, cols);
+            int cleared = 0;
+            for (int i = 0; i < rows * cols; ++i) {
+                bool hit = false;
+                for (int val = 1; val <= Bitboard::MAX_VALUE; ++val) hit = hit || ref.win[val][i];
+                cleared += hit;
+            }
+            if (cleared == 0) break;
+            if (rounds == maxRounds) {
+                truncated = true;
+                break;
+            }
+            REQUIRE(rounds < static_cast<int>(stats.perRound.size()));
+            const RoundStats& round = stats.perRound[rounds];
+            ++rounds;
+            REQUIRE(round.round == rounds);
+            REQUIRE(round.cleared == cleared);
+            for (int val = 1; val <= Bitboard::MAX_VALUE; ++val) REQUIRE(round.blockCells[val] == ref.blockCells[val]);
+            REQUIRE(round.firstBlock + round.blockCount <= static_cast<int>(stats.blocks.size()));
+            auto first = stats.blocks.begin() + round.firstBlock;
+            checkBlocks(first, first + round.blockCount, ref.blocks);
+            totalCleared += cleared;
+            playQuietly(reference);
+        }
+
+        REQUIRE(stats.rounds == rounds);
+        REQUIRE(static_cast<int>(stats.perRound.size()) == rounds);
+        REQUIRE(stats.totalCleared == totalCleared);
+        REQUIRE(stats.truncated == truncated);
+        REQUIRE(static_cast<int>(stats.blocks.size()) == (rounds ? stats.perRound.back().firstBlock + stats.perRound.back().blockCount : 0));
+        REQUIRE(game.getCells() == reference.getCells());
+        truncatedRuns += truncated;
+    }
+    // 随机棋盘中须覆盖到截断的情况
+    REQUIRE(truncatedRuns > 0);
+}
+
+TEST_CASE("ComponentLabeler matches per-value BFS", "[labeler]") {
+    SECTION("random boards") {
+        std::mt19937 rng(99);
+        for (int board = 0; board < 1000; ++board) {
+            int rows, cols;
+            randomShape(rng, rows, cols);
+            int maxValue = 1 + board % 5;
+            int laiziPercent = board % 3 == 0 ? 50 : 12;
+            std::vector<int> cells = randomBoard(rng, rows, cols, maxValue, laiziPercent);
+            ComponentLabeler labeler(rows, cols, LAIZI);
+            checkLabeler(labeler, cells, rows, cols);
+            // 复用同一标记器, 前一次的赖子团状态不能残留
+            checkLabeler(labeler, randomBoard(rng, rows, cols, maxValue, 100 - laiziPercent), rows, cols);
+        }
+    }
+
+    SECTION("pure wildcard block wins for every value") {
+        std::vector<int> cells = {
+            0, 0, 0, 3,
+            0, 0, 4, 3,
+            5, 6, 7, 8,
+        };
+        ComponentLabeler labeler(3, 4, LAIZI);
+        checkLabeler(labeler, cells, 3, 4);
+        // 相邻的 3、4、5、6 把各自的块扩大, 其余值只有 5 个赖子格
+        REQUIRE(labeler.blockCells(1) == 5);
+        REQUIRE(labeler.blockCells(3) == 7);
+        REQUIRE(labeler.blockCells(4) == 6);
+        REQUIRE(labeler.blockCells(6) == 6);
+        REQUIRE(labeler.blockCells(7) == 5);
+        REQUIRE(labeler.blockCells(11) == 5);
+        REQUIRE(labeler.clearedCount() == 10);
+    }
+
+    SECTION("wildcard bridges two components of the same value") {
+        // 3 个 2 + 1 个赖子 + 3 个 2, 两侧各自不足 5 格
+        std::vector<int> cells = {
+            2, 2, 2, 0, 2, 2, 2,
+            1, 3, 1, 3, 1, 3, 1,
+        };
+        ComponentLabeler labeler(2, 7, LAIZI);
+        checkLabeler(labeler, cells, 2, 7);
+        REQUIRE(labeler.blockCells(2) == 7);
+        REQUIRE(labeler.blockCells(3) == 0);
+        REQUIRE(labeler.clearedCount() == 7);
+
+        // 两个赖子团分别与同一个值的块相连, 不能重复计数
+        std::vector<int> twoClusters = {
+            0, 2, 2, 2, 0,
+            1, 3, 1, 3, 1,
+        };
+        ComponentLabeler small(2, 5, LAIZI);
+        checkLabeler(small, twoClusters, 2, 5);
+        REQUIRE(small.blockCells(2) == 5);
+        REQUIRE(small.clearedCount() == 5);
+    }
+}
+
+TEST_CASE("Cascade reports each winning block separately", "[cascade]") {
+    // 值 2 的两个互不相连的块 (5 格与 6 格), 其余格子互不成块
+    std::vector<int> cells = {
+        2, 2, 2, 2, 2, 1,
+        3, 4, 3, 4, 3, 4,
+        2, 2, 2, 2, 2, 2,
+    };
+    BoardGame game(3, 6);
+    game.setBoard(cells.data());
+    game.setCardSource([](int row, int col) { return 5 + (row + col) % 6; });
+    CascadeStats stats = game.cascade(1);
+    REQUIRE(stats.rounds == 1);
+    REQUIRE(stats.perRound[0].blockCells[2] == 11);
+    REQUIRE(stats.perRound[0].blockCount == 2);
+    checkBlocks(stats.blocks.begin(), stats.blocks.end(), {{2, 5}, {2, 6}});
+}
+
+TEST_CASE("Simulation results do not depend on thread count", "[simulator]") {
+    SimulationConfig config;
+    config.rows = 8;
+    config.cols = 7;
+    config.games = 400;
+    config.seed = 42;
+    config.maxRounds = 20;
+    config.maxValue = 4;
+    config.gamesPerTask = 3;
+
+    auto run = [&](size_t threads) {
+        GameMath::ThreadPool pool(threads);
+        return simulate(config, pool);
+    };
+    SimulationStats one = run(1);
+    REQUIRE(one.games == config.games);
+    REQUIRE(one.truncated > 0);
+
+    // 直方图按单个获胜块计数, 块大小之和等于各值获胜格子数之和
+    uint64_t blocks = 0, blockCells = 0;
+    for (size_t n = 0; n < one.blockSize.size(); ++n) {
+        blocks += one.blockSize[n];
+        blockCells += one.blockSize[n] * n;
+    }
+    for (size_t n = 0; n < static_cast<size_t>(MIN_BLOCK); ++n) REQUIRE(one.blockSize[n] == 0);
+    uint64_t valueWins = 0;
+    for (int v = 1; v <= Bitboard::MAX_VALUE; ++v) valueWins += one.valueWins[v];
+    REQUIRE(blocks >= valueWins);
+    REQUIRE(blockCells >= one.cleared);
+
+    for (size_t threads : {4u, 7u}) {
+        SimulationStats many = run(threads);
+        REQUIRE(many.games == one.games);
+        REQUIRE(many.rounds == one.rounds);
+        REQUIRE(many.cleared == one.cleared);
+        REQUIRE(many.truncated == one.truncated);
+        REQUIRE(many.cascadeLength == one.cascadeLength);
+        REQUIRE(many.blockSize == one.blockSize);
+        for (int v = 0; v <= Bitboard::MAX_VALUE; ++v) REQUIRE(many.valueWins[v] == one.valueWins[v]);
+    }
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include "GameMath/Dispatch.hpp"
 #if defined(__x86_64__) || defined(_M_X64)
 #include <cpuid.h>
 void checkSIMD() {
@@ -7,6 +8,7 @@ void checkSIMD() {
 
     std::cout << "SSE:  " << (edx & (1 << 25) ? "YES" : "NO") << "\n";
     std::cout << "AVX:  " << (ecx & (1 << 28) ? "YES" : "NO") << "\n";
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
     std::cout << "AVX2: " << (ebx & (1 << 5)  ? "YES" : "NO") << "\n";
 }
 #else
@@ -17,5 +19,9 @@ void checkSIMD() {
 
 int main() {
     checkSIMD();
+
+    // GameMath 运行时分派选定的档位
+    std::cout << "GameMath tier: "
+              << GameMath::simd::tier_name(GameMath::simd::active_tier()) << "\n";
     return 0;
-}
\ No newline at end of file
+}
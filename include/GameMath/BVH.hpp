@@ -0,0 +1,758 @@
+/******************************
+ *     层次包围盒 (SAH BVH)      *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Geometry.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace GameMath {
+
+/**
+ * @brief 射线检测结果
+ */
+struct RayHit {
+    static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+    float t = std::numeric_limits<float>::infinity();
+    uint32_t primitive = kNone;  // 构建时传入的图元下标
+    float u = 0.0f, v = 0.0f;    // 三角形重心坐标 (包围盒图元为 0)
+
+    bool hit() const { return primitive != kNone; }
+};
+
+/**
+ * @brief 层次包围盒, 用于射线检测与包围盒重叠查询
+ *
+ * 图元可以是任意包围盒 (射线命中包围盒即算命中), 也可以是三角形网格.
+ * 构建使用分箱 SAH (表面积启发式); 传入并行调度函数时, 顶层划分后的各子树并行构建.
+ *
+ * 每个节点占一条 64 字节缓存行, 同时存放两个子节点的包围盒, 遍历时一次访存即可
+ * 测试两个子节点. 批量射线按 SIMD 通道宽度组成射线包, 同一包内的射线共享遍历.
+ *
+ * 图元移动后可调用 refit() 自底向上更新包围盒而不改变树结构;
+ * 移动幅度较大时树的质量会下降, 此时应重新 build().
+ */
+class BVH {
+public:
+    // 叶节点最多包含的图元数
+    static constexpr uint32_t kMaxLeafSize = 8;
+
+    BVH() = default;
+
+    size_t primitive_count() const { return m_primIndices.size(); }
+    size_t node_count() const { return m_nodes.size(); }
+    bool empty() const { return m_primIndices.empty(); }
+    bool is_triangle_mesh() const { return m_triangleMode; }
+
+    // 所有图元的包围盒
+    const AABB& bounds() const { return m_root.bounds; }
+
+    /**
+     * @brief 以包围盒为图元构建
+     *
+     * @param parallelFor 并行调度函数, 约定见 detail::SerialFor
+     */
+    template<typename ParallelFor>
+    void build(Span<const AABB> primitives, ParallelFor&& parallelFor) {
+        m_triangleMode = false;
+        m_indices.clear();
+        m_tris.clear();
+        m_refs.resize(primitives.size());
+        for (size_t i = 0; i < primitives.size(); ++i) m_refs[i] = PrimRef(primitives[i], uint32_t(i));
+        build_tree(parallelFor);
+    }
+
+    void build(Span<const AABB> primitives) {
+        build(primitives, detail::SerialFor());
+    }
+
+    /**
+     * @brief 以三角形网格为图元构建, 每 3 个下标组成一个三角形, 图元编号为三角形序号
+     * @throws std::invalid_argument 当下标数不是 3 的倍数或越界时
+     */
+    template<typename ParallelFor>
+    void build(Span<const Vector3f> vertices, Span<const uint32_t> indices, ParallelFor&& parallelFor) {
+        if (indices.size() % 3 != 0) {
+            throw std::invalid_argument("Triangle index count must be a multiple of 3");
+        }
+        for (uint32_t index : indices) {
+            if (index >= vertices.size()) {
+                throw std::invalid_argument("Triangle index out of range");
+            }
+        }
+        m_triangleMode = true;
+        m_indices.assign(indices.begin(), indices.end());
+        m_refs.resize(indices.size() / 3);
+        for (size_t i = 0; i < m_refs.size(); ++i) {
+            AABB b = AABB::empty();
+            for (size_t k = 0; k < 3; ++k) b.expand(vertices[indices[3 * i + k]]);
+            m_refs[i] = PrimRef(b, uint32_t(i));
+        }
+        build_tree(parallelFor);
+        gather_triangles(vertices);
+    }
+
+    void build(Span<const Vector3f> vertices, Span<const uint32_t> indices) {
+        build(vertices, indices, detail::SerialFor());
+    }
+
+    /**
+     * @brief 图元包围盒改变后自底向上更新节点, 树结构不变
+     * @throws std::invalid_argument 当图元数量不一致或不是以包围盒构建时
+     */
+    void refit(Span<const AABB> primitives) {
+        if (m_triangleMode || primitives.size() != m_bounds.size()) {
+            throw std::invalid_argument("Refit primitives do not match the built BVH");
+        }
+        for (size_t i = 0; i < m_bounds.size(); ++i) m_bounds[i] = primitives[m_primIndices[i]];
+        refit_nodes();
+    }
+
+    /**
+     * @brief 顶点移动后更新三角形与节点 (下标与构建时相同)
+     * @throws std::invalid_argument 当不是以三角形构建或顶点数不足时
+     */
+    void refit(Span<const Vector3f> vertices) {
+        if (!m_triangleMode) {
+            throw std::invalid_argument("Refit primitives do not match the built BVH");
+        }
+        for (uint32_t index : m_indices) {
+            if (index >= vertices.size()) {
+                throw std::invalid_argument("Triangle index out of range");
+            }
+        }
+        gather_triangles(vertices);
+        refit_nodes();
+    }
+
+    /**
+     * @brief 最近命中点
+     * @return 是否命中; 未命中时 hit 为默认值
+     */
+    bool raycast(const Ray& ray, RayHit& hit) const {
+        Packet<simd::scalar<float>> packet;
+        packet.set(0, ray);
+        trace<simd::scalar<float>, false>(packet);
+        hit = packet.result(0);
+        return hit.hit();
+    }
+
+    /**
+     * @brief 射线在 [tmin, tmax] 内是否被任意图元遮挡 (视线检测), 找到第一个命中即返回
+     */
+    bool occluded(const Ray& ray) const {
+        Packet<simd::scalar<float>> packet;
+        packet.set(0, ray);
+        trace<simd::scalar<float>, true>(packet);
+        return packet.hit != 0;
+    }
+
+    /**
+     * @brief 批量最近命中, 射线按 SIMD 通道宽度组成射线包共享遍历
+     *
+     * 射线起点与方向相近 (如同一角色的多条检测线) 时效果最好.
+     * @throws std::invalid_argument 当 rays 与 hits 大小不一致时
+     */
+    void raycast(Span<const Ray> rays, Span<RayHit> hits) const {
+        if (rays.size() != hits.size()) {
+            throw std::invalid_argument("Input and output sizes do not match");
+        }
+        for_packets(rays, [&](auto& packet, size_t base, size_t lanes) {
+            trace<PacketType, false>(packet);
+            for (size_t k = 0; k < lanes; ++k) hits[base + k] = packet.result(k);
+        });
+    }
+
+    /**
+     * @brief 批量遮挡检测, occluded[i] 为 1 表示 rays[i] 被遮挡
+     * @throws std::invalid_argument 当 rays 与 occluded 大小不一致时
+     */
+    void occluded(Span<const Ray> rays, Span<uint8_t> occluded) const {
+        if (rays.size() != occluded.size()) {
+            throw std::invalid_argument("Input and output sizes do not match");
+        }
+        for_packets(rays, [&](auto& packet, size_t base, size_t lanes) {
+            trace<PacketType, true>(packet);
+            for (size_t k = 0; k < lanes; ++k) occluded[base + k] = uint8_t((packet.hit >> k) & 1u);
+        });
+    }
+
+    /**
+     * @brief 包围盒与 box 相交的图元 (三角形按其包围盒判断), 结果追加到 out
+     */
+    void query(const AABB& box, std::vector<uint32_t>& out) const {
+        if (empty() || !m_root.bounds.intersects(box)) return;
+        if (m_root.count > 0) {
+            query_leaf(m_root.child, m_root.count, box, out);
+            return;
+        }
+        uint32_t stack[kStackSize];
+        size_t sp = 0;
+        stack[sp++] = m_root.child;
+        while (sp > 0) {
+            const Node& node = m_nodes[stack[--sp]];
+            for (int c = 0; c < 2; ++c) {
+                if (!node.child_bounds(c).intersects(box)) continue;
+                if (node.count[c] > 0) {
+                    query_leaf(node.child[c], node.count[c], box, out);
+                } else {
+                    stack[sp++] = node.child[c];
+                }
+            }
+        }
+    }
+
+private:
+    using PacketType = simd::native_t<float>;
+
+    static constexpr uint32_t kBinCount = 16;
+    static constexpr uint32_t kStackSize = 128;
+    // 超过该深度后改用中位数划分, 保证遍历栈不会溢出
+    static constexpr uint32_t kMaxSahDepth = 48;
+    // 图元数少于该值时不再拆分并行任务
+    static constexpr uint32_t kParallelMinCount = 4096;
+    static constexpr uint32_t kParallelDepth = 6;
+    static constexpr uint32_t kPending = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * 64 字节节点: 两个子节点的包围盒按分量交错存放.
+     * count[c] > 0 时子节点 c 为叶, child[c] 为 m_primIndices 中的起点; 否则 child[c] 为节点下标.
+     */
+    struct alignas(64) Node {
+        float minX[2], minY[2], minZ[2];
+        float maxX[2], maxY[2], maxZ[2];
+        uint32_t child[2];
+        uint32_t count[2];
+
+        AABB child_bounds(int c) const {
+            return AABB(Vector3f(minX[c], minY[c], minZ[c]), Vector3f(maxX[c], maxY[c], maxZ[c]));
+        }
+
+        void set_child(int c, const AABB& b, uint32_t index, uint32_t n) {
+            minX[c] = b.min.x; minY[c] = b.min.y; minZ[c] = b.min.z;
+            maxX[c] = b.max.x; maxY[c] = b.max.y; maxZ[c] = b.max.z;
+            child[c] = index;
+            count[c] = n;
+        }
+    };
+    static_assert(sizeof(Node) == 64, "BVH node must fit one cache line");
+
+    // 子树引用: 包围盒 + 节点下标或叶的图元区间
+    struct Ref {
+        AABB bounds = AABB::empty();
+        uint32_t child = 0;
+        uint32_t count = 0;
+    };
+
+    // 并行构建的子树任务
+    struct Task {
+        uint32_t first, count, depth;
+        uint32_t node = kPending;  // 结果写入 m_nodes[node] 的 side 子节点, kPending 表示根
+        int side = 0;
+        Ref result;
+        std::vector<Node> nodes;
+    };
+
+    // 三角形: v0 与两条边
+    struct Triangle {
+        Vector3f v0, e1, e2;
+    };
+
+    // 构建时的图元引用, 划分时整体移动以保持连续访问
+    struct PrimRef {
+        AABB bounds;
+        Vector3f centroid;
+        uint32_t index = 0;
+
+        PrimRef() = default;
+        PrimRef(const AABB& b, uint32_t i) : bounds(b), centroid(b.center()), index(i) {}
+    };
+
+    // 射线包 (SoA), 宽度为打包类型的通道数
+    template<typename P>
+    struct Packet {
+        static constexpr size_t W = P::width;
+        float ox[W], oy[W], oz[W];
+        float dx[W], dy[W], dz[W];
+        float ix[W], iy[W], iz[W];
+        float tmin[W], tmax[W], u[W], v[W];
+        uint32_t prim[W];
+        unsigned active = 0;
+        unsigned hit = 0;
+
+        Packet() {
+            for (size_t k = 0; k < W; ++k) {
+                ox[k] = oy[k] = oz[k] = dx[k] = dy[k] = dz[k] = 0.0f;
+                ix[k] = iy[k] = iz[k] = 0.0f;
+                u[k] = v[k] = 0.0f;
+                // 空通道: 区间为空, 不会命中任何包围盒
+                tmin[k] = 0.0f;
+                tmax[k] = -1.0f;
+                prim[k] = RayHit::kNone;
+            }
+        }
+
+        // 方向分量为 0 时以极小值代替, 避免 0 * inf 产生 NaN
+        static float safe_inverse(float d) {
+            constexpr float kTiny = 1e-20f;
+            return 1.0f / (std::fabs(d) < kTiny ? std::copysign(kTiny, d) : d);
+        }
+
+        void set(size_t k, const Ray& r) {
+            ox[k] = r.origin.x; oy[k] = r.origin.y; oz[k] = r.origin.z;
+            dx[k] = r.direction.x; dy[k] = r.direction.y; dz[k] = r.direction.z;
+            ix[k] = safe_inverse(dx[k]); iy[k] = safe_inverse(dy[k]); iz[k] = safe_inverse(dz[k]);
+            tmin[k] = r.tmin;
+            tmax[k] = r.tmax;
+            active |= 1u << k;
+        }
+
+        RayHit result(size_t k) const {
+            RayHit h;
+            if ((hit >> k) & 1u) {
+                h.t = tmax[k];
+                h.primitive = prim[k];
+                h.u = u[k];
+                h.v = v[k];
+            }
+            return h;
+        }
+    };
+
+    std::vector<Node> m_nodes;
+    Ref m_root;
+    // 图元数据按叶区间顺序存放, 遍历时连续访问
+    std::vector<uint32_t> m_primIndices;  // 叶区间 -> 原图元下标
+    std::vector<AABB> m_bounds;           // 图元包围盒
+    std::vector<Triangle> m_tris;         // 三角形 (三角形模式)
+    std::vector<uint32_t> m_indices;      // 三角形下标 (三角形模式, 按原图元下标)
+    std::vector<PrimRef> m_refs;          // 仅构建时使用
+    bool m_triangleMode = false;
+
+    // 按叶区间顺序收集三角形并更新其包围盒
+    void gather_triangles(Span<const Vector3f> vertices) {
+        m_tris.resize(m_primIndices.size());
+        for (size_t i = 0; i < m_primIndices.size(); ++i) {
+            const uint32_t* tri = &m_indices[3 * size_t(m_primIndices[i])];
+            const Vector3f& v0 = vertices[tri[0]];
+            m_tris[i] = Triangle{v0, vertices[tri[1]] - v0, vertices[tri[2]] - v0};
+            AABB b(v0, v0);
+            b.expand(vertices[tri[1]]);
+            b.expand(vertices[tri[2]]);
+            m_bounds[i] = b;
+        }
+    }
+
+    /******************************
+     *            构建             *
+     ******************************/
+
+    template<typename ParallelFor>
+    void build_tree(ParallelFor&& parallelFor) {
+        uint32_t count = static_cast<uint32_t>(m_refs.size());
+        m_nodes.clear();
+        m_root = Ref();
+        m_primIndices.resize(count);
+        m_bounds.resize(count);
+        if (count == 0) return;
+
+        // 顶层串行划分, 其余子树作为任务并行构建
+        std::vector<Task> tasks;
+        m_root = build_top(0, count, 0, tasks);
+        parallelFor(tasks.size(), [&](size_t t) {
+            Task& task = tasks[t];
+            task.result = build_range(task.first, task.count, task.depth, task.nodes);
+        });
+        for (Task& task : tasks) {
+            uint32_t offset = static_cast<uint32_t>(m_nodes.size());
+            for (Node& node : task.nodes) {
+                for (int c = 0; c < 2; ++c) {
+                    if (node.count[c] == 0) node.child[c] += offset;
+                }
+                m_nodes.push_back(node);
+            }
+            Ref ref = task.result;
+            if (ref.count == 0) ref.child += offset;
+            if (task.node == kPending) {
+                m_root = ref;
+            } else {
+                m_nodes[task.node].set_child(task.side, ref.bounds, ref.child, ref.count);
+            }
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            m_primIndices[i] = m_refs[i].index;
+            m_bounds[i] = m_refs[i].bounds;
+        }
+        m_refs.clear();
+        m_refs.shrink_to_fit();
+    }
+
+    Ref build_top(uint32_t first, uint32_t count, uint32_t depth, std::vector<Task>& tasks) {
+        if (count < kParallelMinCount || depth >= kParallelDepth) {
+            Task task;
+            task.first = first;
+            task.count = count;
+            task.depth = depth;
+            tasks.push_back(std::move(task));
+            Ref pending;
+            pending.child = static_cast<uint32_t>(tasks.size() - 1);
+            pending.count = kPending;
+            return pending;
+        }
+        AABB bounds;
+        uint32_t mid = split(first, count, depth, bounds);
+        if (mid == first) {
+            return make_leaf(first, count, bounds);
+        }
+        uint32_t index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+        Ref children[2] = {build_top(first, mid - first, depth + 1, tasks),
+                           build_top(mid, first + count - mid, depth + 1, tasks)};
+        for (int c = 0; c < 2; ++c) {
+            if (children[c].count == kPending) {
+                tasks[children[c].child].node = index;
+                tasks[children[c].child].side = c;
+            } else {
+                m_nodes[index].set_child(c, children[c].bounds, children[c].child, children[c].count);
+            }
+        }
+        Ref ref;
+        ref.child = index;
+        ref.bounds = bounds;
+        return ref;
+    }
+
+    // 递归构建 [first, first + count), 节点按先序写入 nodes
+    Ref build_range(uint32_t first, uint32_t count, uint32_t depth, std::vector<Node>& nodes) {
+        AABB bounds;
+        uint32_t mid = split(first, count, depth, bounds);
+        if (mid == first) {
+            return make_leaf(first, count, bounds);
+        }
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        Ref left = build_range(first, mid - first, depth + 1, nodes);
+        Ref right = build_range(mid, first + count - mid, depth + 1, nodes);
+        nodes[index].set_child(0, left.bounds, left.child, left.count);
+        nodes[index].set_child(1, right.bounds, right.child, right.count);
+        Ref ref;
+        ref.child = index;
+        ref.bounds = bounds;
+        return ref;
+    }
+
+    static Ref make_leaf(uint32_t first, uint32_t count, const AABB& bounds) {
+        Ref ref;
+        ref.bounds = bounds;
+        ref.child = first;
+        ref.count = count;
+        return ref;
+    }
+
+    /**
+     * 分箱 SAH 划分: 沿质心跨度最大的轴分为 kBinCount 个箱, 选代价最小的分界.
+     * 返回右半部分的起点; 返回 first 表示作为叶节点. bounds 输出区间的包围盒.
+     */
+    uint32_t split(uint32_t first, uint32_t count, uint32_t depth, AABB& bounds) {
+        bounds = AABB::empty();
+        AABB centroidBounds = AABB::empty();
+        for (uint32_t i = first; i < first + count; ++i) {
+            bounds.expand(m_refs[i].bounds);
+            centroidBounds.expand(m_refs[i].centroid);
+        }
+        if (count <= 2) return first;
+
+        Vector3f extent = centroidBounds.size();
+        int axis = 0;
+        if (extent.y > extent.x) axis = 1;
+        if (extent.z > extent.unchecked(axis)) axis = 2;
+        float lo = centroidBounds.min.unchecked(axis);
+        float span = extent.unchecked(axis);
+        PrimRef* begin = m_refs.data() + first;
+        auto* end = begin + count;
+
+        // 质心重合或过深: 按下标中位数划分 (图元足够少时直接作为叶)
+        auto median_split = [&]() {
+            if (count <= kMaxLeafSize) return first;
+            uint32_t mid = first + count / 2;
+            std::nth_element(begin, m_refs.data() + mid, end, [&](const PrimRef& a, const PrimRef& b) {
+                return a.centroid.unchecked(axis) < b.centroid.unchecked(axis);
+            });
+            return mid;
+        };
+        if (!(span > 0.0f) || depth >= kMaxSahDepth) return median_split();
+
+        struct Bin {
+            AABB bounds = AABB::empty();
+            uint32_t count = 0;
+        };
+        Bin bins[kBinCount];
+        float scale = kBinCount / span;
+        auto bin_of = [&](const PrimRef& p) {
+            int b = static_cast<int>((p.centroid.unchecked(axis) - lo) * scale);
+            return static_cast<uint32_t>(std::clamp(b, 0, int(kBinCount) - 1));
+        };
+        for (PrimRef* it = begin; it != end; ++it) {
+            Bin& bin = bins[bin_of(*it)];
+            bin.bounds.expand(it->bounds);
+            ++bin.count;
+        }
+
+        // 从右向左累计右侧代价, 再从左向右扫描
+        float rightArea[kBinCount];
+        uint32_t rightCount[kBinCount];
+        AABB acc = AABB::empty();
+        uint32_t n = 0;
+        for (uint32_t b = kBinCount - 1; b > 0; --b) {
+            acc.expand(bins[b].bounds);
+            n += bins[b].count;
+            rightArea[b] = n > 0 ? acc.surface_area() : 0.0f;
+            rightCount[b] = n;
+        }
+        float bestCost = std::numeric_limits<float>::infinity();
+        uint32_t bestBin = 0;
+        acc = AABB::empty();
+        n = 0;
+        for (uint32_t b = 1; b < kBinCount; ++b) {
+            acc.expand(bins[b - 1].bounds);
+            n += bins[b - 1].count;
+            if (n == 0 || rightCount[b] == 0) continue;
+            float cost = acc.surface_area() * n + rightArea[b] * rightCount[b];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBin = b;
+            }
+        }
+        if (bestBin == 0) return median_split();
+
+        // 遍历代价计为 1, 单个图元求交代价计为 1
+        float area = bounds.surface_area();
+        float splitCost = area > 0.0f ? 1.0f + bestCost / area : float(count);
+        if (count <= kMaxLeafSize && splitCost >= float(count)) return first;
+
+        PrimRef* mid = std::partition(begin, end, [&](const PrimRef& p) { return bin_of(p) < bestBin; });
+        return first + static_cast<uint32_t>(mid - begin);
+    }
+
+    // 自底向上更新: 子节点的下标总大于父节点, 逆序遍历即可
+    void refit_nodes() {
+        auto leaf_bounds = [this](uint32_t first, uint32_t count) {
+            AABB b = AABB::empty();
+            for (uint32_t i = first; i < first + count; ++i) b.expand(m_bounds[i]);
+            return b;
+        };
+        for (size_t i = m_nodes.size(); i-- > 0;) {
+            Node& node = m_nodes[i];
+            for (int c = 0; c < 2; ++c) {
+                AABB b;
+                if (node.count[c] > 0) {
+                    b = leaf_bounds(node.child[c], node.count[c]);
+                } else {
+                    const Node& child = m_nodes[node.child[c]];
+                    b = child.child_bounds(0);
+                    b.expand(child.child_bounds(1));
+                }
+                node.set_child(c, b, node.child[c], node.count[c]);
+            }
+        }
+        if (empty()) return;
+        if (m_root.count > 0) {
+            m_root.bounds = leaf_bounds(m_root.child, m_root.count);
+        } else {
+            m_root.bounds = m_nodes[m_root.child].child_bounds(0);
+            m_root.bounds.expand(m_nodes[m_root.child].child_bounds(1));
+        }
+    }
+
+    /******************************
+     *            查询             *
+     ******************************/
+
+    void query_leaf(uint32_t first, uint32_t count, const AABB& box, std::vector<uint32_t>& out) const {
+        for (uint32_t i = first; i < first + count; ++i) {
+            if (m_bounds[i].intersects(box)) out.push_back(m_primIndices[i]);
+        }
+    }
+
+    template<typename F>
+    void for_packets(Span<const Ray> rays, F&& f) const {
+        constexpr size_t W = PacketType::width;
+        for (size_t base = 0; base < rays.size(); base += W) {
+            size_t lanes = std::min(W, rays.size() - base);
+            Packet<PacketType> packet;
+            for (size_t k = 0; k < lanes; ++k) packet.set(k, rays[base + k]);
+            f(packet, base, lanes);
+        }
+    }
+
+    // 射线包在寄存器中的常量部分
+    template<typename P>
+    struct PacketRegs {
+        typename P::reg ix, iy, iz;     // 方向倒数
+        typename P::reg oix, oiy, oiz;  // -origin * 方向倒数
+        typename P::reg tmin;
+
+        explicit PacketRegs(const Packet<P>& p)
+            : ix(P::load(p.ix)), iy(P::load(p.iy)), iz(P::load(p.iz)),
+              oix(P::mul(P::sub(P::zero(), P::load(p.ox)), ix)),
+              oiy(P::mul(P::sub(P::zero(), P::load(p.oy)), iy)),
+              oiz(P::mul(P::sub(P::zero(), P::load(p.oz)), iz)),
+              tmin(P::load(p.tmin)) {}
+    };
+
+    // 射线包与包围盒的 slab 测试, 返回命中通道掩码; tnear 输出进入距离
+    template<typename P>
+    static unsigned slab(const PacketRegs<P>& r, typename P::reg tmax,
+                         float minX, float minY, float minZ, float maxX, float maxY, float maxZ,
+                         typename P::reg& tnear) {
+        auto x0 = P::fmadd(P::set1(minX), r.ix, r.oix);
+        auto x1 = P::fmadd(P::set1(maxX), r.ix, r.oix);
+        auto y0 = P::fmadd(P::set1(minY), r.iy, r.oiy);
+        auto y1 = P::fmadd(P::set1(maxY), r.iy, r.oiy);
+        auto z0 = P::fmadd(P::set1(minZ), r.iz, r.oiz);
+        auto z1 = P::fmadd(P::set1(maxZ), r.iz, r.oiz);
+        tnear = P::max(P::max(P::min(x0, x1), P::min(y0, y1)), P::max(P::min(z0, z1), r.tmin));
+        auto tfar = P::min(P::min(P::max(x0, x1), P::max(y0, y1)), P::min(P::max(z0, z1), tmax));
+        return P::mask_ge(tfar, tnear);
+    }
+
+    // 叶节点求交, 更新各通道的最近命中
+    template<typename P>
+    void intersect_leaf(uint32_t first, uint32_t count, Packet<P>& pk, const PacketRegs<P>& r) const {
+        constexpr size_t W = P::width;
+        alignas(64) float t[W], u[W], v[W];
+        for (uint32_t i = first; i < first + count; ++i) {
+            auto tmax = P::load(pk.tmax);
+            unsigned mask;
+            if (m_triangleMode) {
+                mask = intersect_triangle<P>(m_tris[i], pk, r, tmax, t, u, v);
+            } else {
+                const AABB& b = m_bounds[i];
+                typename P::reg tnear;
+                mask = slab<P>(r, tmax, b.min.x, b.min.y, b.min.z, b.max.x, b.max.y, b.max.z, tnear) & pk.active;
+                P::store(t, tnear);
+                for (size_t k = 0; k < W; ++k) u[k] = v[k] = 0.0f;
+            }
+            for (size_t k = 0; k < W; ++k) {
+                if (!((mask >> k) & 1u) || !(t[k] <= pk.tmax[k])) continue;
+                pk.tmax[k] = t[k];
+                pk.prim[k] = m_primIndices[i];
+                pk.u[k] = u[k];
+                pk.v[k] = v[k];
+                pk.hit |= 1u << k;
+            }
+        }
+    }
+
+    // Möller-Trumbore 射线三角形求交 (射线包 x 单个三角形)
+    template<typename P>
+    static unsigned intersect_triangle(const Triangle& tri, const Packet<P>& pk, const PacketRegs<P>&,
+                                       typename P::reg tmax, float* t, float* u, float* v) {
+        auto dx = P::load(pk.dx), dy = P::load(pk.dy), dz = P::load(pk.dz);
+        auto e1x = P::set1(tri.e1.x), e1y = P::set1(tri.e1.y), e1z = P::set1(tri.e1.z);
+        auto e2x = P::set1(tri.e2.x), e2y = P::set1(tri.e2.y), e2z = P::set1(tri.e2.z);
+        // p = d x e2
+        auto px = P::sub(P::mul(dy, e2z), P::mul(dz, e2y));
+        auto py = P::sub(P::mul(dz, e2x), P::mul(dx, e2z));
+        auto pz = P::sub(P::mul(dx, e2y), P::mul(dy, e2x));
+        auto det = P::fmadd(e1x, px, P::fmadd(e1y, py, P::mul(e1z, pz)));
+        auto inv = P::div(P::set1(1.0f), det);
+        // s = o - v0
+        auto sx = P::sub(P::load(pk.ox), P::set1(tri.v0.x));
+        auto sy = P::sub(P::load(pk.oy), P::set1(tri.v0.y));
+        auto sz = P::sub(P::load(pk.oz), P::set1(tri.v0.z));
+        auto uu = P::mul(P::fmadd(sx, px, P::fmadd(sy, py, P::mul(sz, pz))), inv);
+        // q = s x e1
+        auto qx = P::sub(P::mul(sy, e1z), P::mul(sz, e1y));
+        auto qy = P::sub(P::mul(sz, e1x), P::mul(sx, e1z));
+        auto qz = P::sub(P::mul(sx, e1y), P::mul(sy, e1x));
+        auto vv = P::mul(P::fmadd(dx, qx, P::fmadd(dy, qy, P::mul(dz, qz))), inv);
+        auto tt = P::mul(P::fmadd(e2x, qx, P::fmadd(e2y, qy, P::mul(e2z, qz))), inv);
+
+        auto zero = P::zero();
+        unsigned mask = P::mask_gt(P::mul(det, det), P::set1(1e-24f)) &
+                        P::mask_ge(uu, zero) & P::mask_ge(vv, zero) &
+                        P::mask_ge(P::set1(1.0f), P::add(uu, vv)) &
+                        P::mask_ge(tt, P::load(pk.tmin)) & P::mask_ge(tmax, tt) & pk.active;
+        P::store(t, tt);
+        P::store(u, uu);
+        P::store(v, vv);
+        return mask;
+    }
+
+    // 按射线方向选择先访问的子节点: 沿两子节点中心相距最远的轴, 先访问迎向射线的一侧
+    template<typename P>
+    static int near_child(const Node& n, const Packet<P>& pk) {
+        float cx = (n.minX[1] + n.maxX[1]) - (n.minX[0] + n.maxX[0]);
+        float cy = (n.minY[1] + n.maxY[1]) - (n.minY[0] + n.maxY[0]);
+        float cz = (n.minZ[1] + n.maxZ[1]) - (n.minZ[0] + n.maxZ[0]);
+        float d;
+        if (std::fabs(cx) >= std::fabs(cy) && std::fabs(cx) >= std::fabs(cz)) {
+            d = cx * pk.dx[0];
+        } else if (std::fabs(cy) >= std::fabs(cz)) {
+            d = cy * pk.dy[0];
+        } else {
+            d = cz * pk.dz[0];
+        }
+        return d >= 0.0f ? 0 : 1;
+    }
+
+    /**
+     * 射线包遍历. AnyHit 为真时所有有效通道都命中后立即返回 (遮挡检测).
+     * 只要包内有一条射线命中子节点就继续向下, 其余通道由 slab 掩码屏蔽.
+     */
+    template<typename P, bool AnyHit>
+    void trace(Packet<P>& pk) const {
+        if (empty() || pk.active == 0) return;
+        PacketRegs<P> r(pk);
+        typename P::reg tnear;
+        const AABB& rb = m_root.bounds;
+        if (!(slab<P>(r, P::load(pk.tmax), rb.min.x, rb.min.y, rb.min.z, rb.max.x, rb.max.y, rb.max.z, tnear) &
+              pk.active)) {
+            return;
+        }
+        if (m_root.count > 0) {
+            intersect_leaf<P>(m_root.child, m_root.count, pk, r);
+            return;
+        }
+
+        uint32_t stack[kStackSize];
+        size_t sp = 0;
+        stack[sp++] = m_root.child;
+        while (sp > 0) {
+            const Node& node = m_nodes[stack[--sp]];
+            auto tmax = P::load(pk.tmax);
+            unsigned mask[2];
+            for (int c = 0; c < 2; ++c) {
+                mask[c] = slab<P>(r, tmax, node.minX[c], node.minY[c], node.minZ[c],
+                                  node.maxX[c], node.maxY[c], node.maxZ[c], tnear) & pk.active;
+                if constexpr (AnyHit) mask[c] &= ~pk.hit;
+            }
+            int nearC = near_child(node, pk);
+            // 叶节点立即求交 (近侧先), 内部节点远侧先入栈
+            for (int k = 0; k < 2; ++k) {
+                int c = k == 0 ? nearC : 1 - nearC;
+                if (mask[c] && node.count[c] > 0) {
+                    intersect_leaf<P>(node.child[c], node.count[c], pk, r);
+                    if constexpr (AnyHit) {
+                        if (pk.hit == pk.active) return;
+                    }
+                }
+            }
+            for (int k = 0; k < 2; ++k) {
+                int c = k == 0 ? 1 - nearC : nearC;
+                if (mask[c] && node.count[c] == 0) stack[sp++] = node.child[c];
+            }
+        }
+    }
+};
+
+} // namespace GameMath
@@ -0,0 +1,524 @@
+/******************************
+ *    SoA 批量向量容器与运算     *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Simd.hpp"
+#include "Dispatch.hpp"
+#include "FastMath.hpp"
+#include "Span.hpp"
+#include "Memory.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace GameMath {
+
+/**
+ * @brief 结构数组(SoA)形式的向量批量容器
+ *
+ * 每个分量单独连续存储 (x[], y[], z[] ...), 起始地址按缓存行对齐, 批量运算按 SIMD 通道宽度
+ * 一次处理 4/8/16 个向量. Vec3Batch 的 dot/length/normalize/transform_* 经
+ * simd::kernels() 在运行时按 CPU 档位分派, 其余组合使用编译期选定的指令集.
+ */
+template<typename T, size_t N>
+class VectorBatch {
+    static_assert(std::is_floating_point_v<T>, "VectorBatch requires a floating point type");
+
+    AlignedVector<T> m_data[N];
+
+public:
+    // 构造函数
+    VectorBatch() = default;
+
+    explicit VectorBatch(size_t count) { resize(count); }
+
+    // 容量
+    size_t size() const { return m_data[0].size(); }
+    bool empty() const { return m_data[0].empty(); }
+
+    void resize(size_t count) {
+        for (auto& comp : m_data) comp.resize(count);
+    }
+
+    void reserve(size_t count) {
+        for (auto& comp : m_data) comp.reserve(count);
+    }
+
+    void clear() {
+        for (auto& comp : m_data) comp.clear();
+    }
+
+    // 元素读写
+    void push_back(const Vector<T, N>& v) {
+        for (size_t c = 0; c < N; ++c) m_data[c].push_back(v.data[c]);
+    }
+
+    Vector<T, N> get(size_t index) const {
+        Vector<T, N> result;
+        for (size_t c = 0; c < N; ++c) result.data[c] = m_data[c][index];
+        return result;
+    }
+
+    void set(size_t index, const Vector<T, N>& v) {
+        for (size_t c = 0; c < N; ++c) m_data[c][index] = v.data[c];
+    }
+
+    // 分量数组访问
+    T* component(size_t c) { return m_data[c].data(); }
+    const T* component(size_t c) const { return m_data[c].data(); }
+
+    T* x() { return component(0); }
+    const T* x() const { return component(0); }
+
+    T* y() { static_assert(N >= 2, "y() requires N >= 2"); return component(1); }
+    const T* y() const { static_assert(N >= 2, "y() requires N >= 2"); return component(1); }
+
+    T* z() { static_assert(N >= 3, "z() requires N >= 3"); return component(2); }
+    const T* z() const { static_assert(N >= 3, "z() requires N >= 3"); return component(2); }
+
+    T* w() { static_assert(N >= 4, "w() requires N >= 4"); return component(3); }
+    const T* w() const { static_assert(N >= 4, "w() requires N >= 4"); return component(3); }
+};
+
+// 常用特化别名
+using Vec2Batch = VectorBatch<float, 2>;
+using Vec3Batch = VectorBatch<float, 3>;
+using Vec4Batch = VectorBatch<float, 4>;
+
+namespace detail {
+#include "detail/BatchKernels.inl"
+
+    template<typename T, size_t N>
+    void check_batch_size(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b) {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument("VectorBatch sizes do not match");
+        }
+    }
+
+    template<typename T, size_t N>
+    void component_pointers(const VectorBatch<T, N>& batch, const T* (&ptrs)[N]) {
+        for (size_t c = 0; c < N; ++c) ptrs[c] = batch.component(c);
+    }
+}
+
+/******************************
+ *        批量运算函数          *
+ ******************************/
+
+/**
+ * @brief 批量加法 out = a + b
+ */
+template<typename T, size_t N>
+void add(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b, VectorBatch<T, N>& out) {
+    using P = simd::native_t<T>;
+    detail::check_batch_size(a, b);
+    out.resize(a.size());
+    for (size_t c = 0; c < N; ++c) {
+        size_t i = detail::batch_add<P>(a.component(c), b.component(c), out.component(c), 0, a.size());
+        detail::batch_add<simd::scalar<T>>(a.component(c), b.component(c), out.component(c), i, a.size());
+    }
+}
+
+/**
+ * @brief 批量减法 out = a - b
+ */
+template<typename T, size_t N>
+void sub(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b, VectorBatch<T, N>& out) {
+    using P = simd::native_t<T>;
+    detail::check_batch_size(a, b);
+    out.resize(a.size());
+    for (size_t c = 0; c < N; ++c) {
+        size_t i = detail::batch_sub<P>(a.component(c), b.component(c), out.component(c), 0, a.size());
+        detail::batch_sub<simd::scalar<T>>(a.component(c), b.component(c), out.component(c), i, a.size());
+    }
+}
+
+/**
+ * @brief 批量缩放 out = a * s
+ */
+template<typename T, size_t N>
+void scale(const VectorBatch<T, N>& a, T s, VectorBatch<T, N>& out) {
+    using P = simd::native_t<T>;
+    out.resize(a.size());
+    for (size_t c = 0; c < N; ++c) {
+        size_t i = detail::batch_scale<P>(a.component(c), s, out.component(c), 0, a.size());
+        detail::batch_scale<simd::scalar<T>>(a.component(c), s, out.component(c), i, a.size());
+    }
+}
+
+/**
+ * @brief 批量线性插值 out = a + (b - a) * t
+ */
+template<typename T, size_t N>
+void lerp(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b, T t, VectorBatch<T, N>& out) {
+    using P = simd::native_t<T>;
+    detail::check_batch_size(a, b);
+    out.resize(a.size());
+    for (size_t c = 0; c < N; ++c) {
+        size_t i = detail::batch_lerp<P>(a.component(c), b.component(c), t, out.component(c), 0, a.size());
+        detail::batch_lerp<simd::scalar<T>>(a.component(c), b.component(c), t, out.component(c), i, a.size());
+    }
+}
+
+/**
+ * @brief 批量点积
+ * @param out 输出数组, 至少包含 a.size() 个元素
+ */
+template<typename T, size_t N>
+void dot(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b, T* out) {
+    using P = simd::native_t<T>;
+    detail::check_batch_size(a, b);
+    const T* pa[N];
+    const T* pb[N];
+    detail::component_pointers(a, pa);
+    detail::component_pointers(b, pb);
+    if constexpr (std::is_same_v<T, float> && N == 3) {
+        simd::kernels().dot3(pa, pb, out, a.size());
+        return;
+    }
+    size_t i = detail::batch_dot<P, N>(pa, pb, out, 0, a.size());
+    detail::batch_dot<simd::scalar<T>, N>(pa, pb, out, i, a.size());
+}
+
+namespace detail {
+    // 将运行时精度档位转为编译期参数
+    template<typename F>
+    void with_accuracy(Accuracy accuracy, F&& f) {
+        switch (accuracy) {
+            case Accuracy::High: return f(std::integral_constant<Accuracy, Accuracy::High>{});
+            case Accuracy::Low: return f(std::integral_constant<Accuracy, Accuracy::Low>{});
+            default: return f(std::integral_constant<Accuracy, Accuracy::Exact>{});
+        }
+    }
+}
+
+/**
+ * @brief 批量求向量长度
+ * @param out 输出数组, 至少包含 a.size() 个元素
+ * @param accuracy 开方精度档位 (见 FastMath.hpp)
+ */
+template<typename T, size_t N>
+void length(const VectorBatch<T, N>& a, T* out, Accuracy accuracy = Accuracy::Exact) {
+    using P = simd::native_t<T>;
+    const T* pa[N];
+    detail::component_pointers(a, pa);
+    if constexpr (std::is_same_v<T, float> && N == 3) {
+        simd::kernels().length3(pa, out, a.size(), accuracy);
+        return;
+    }
+    detail::with_accuracy(accuracy, [&](auto tag) {
+        size_t i = detail::batch_length<P, N, tag.value>(pa, out, 0, a.size());
+        detail::batch_length<simd::scalar<T>, N, tag.value>(pa, out, i, a.size());
+    });
+}
+
+/**
+ * @brief 批量归一化 (out 可以与 a 相同), 零向量保持为零
+ * @param accuracy 倒数平方根精度档位, High 为一次牛顿迭代的近似值 (见 FastMath.hpp)
+ */
+template<typename T, size_t N>
+void normalize(const VectorBatch<T, N>& a, VectorBatch<T, N>& out, Accuracy accuracy = Accuracy::Exact) {
+    using P = simd::native_t<T>;
+    out.resize(a.size());
+    const T* pa[N];
+    T* po[N];
+    detail::component_pointers(a, pa);
+    for (size_t c = 0; c < N; ++c) po[c] = out.component(c);
+    if constexpr (std::is_same_v<T, float> && N == 3) {
+        simd::kernels().normalize3(pa, po, a.size(), accuracy);
+        return;
+    }
+    detail::with_accuracy(accuracy, [&](auto tag) {
+        size_t i = detail::batch_normalize<P, N, tag.value>(pa, po, 0, a.size());
+        detail::batch_normalize<simd::scalar<T>, N, tag.value>(pa, po, i, a.size());
+    });
+}
+
+/**
+ * @brief 批量矩形碰撞检测 (rect_collision 的 SoA 版本)
+ *
+ * a 与 b 的每个元素为矩形 (x, y, w, h), 逐对检测 a[i] 与 b[i] 是否相交,
+ * 相交的下标按原顺序写入 hits, 返回相交数量. 按运行时检测的 CPU 档位分派.
+ */
+inline size_t rect_collision(const Vec4Batch& a, const Vec4Batch& b, std::vector<uint32_t>& hits) {
+    detail::check_batch_size(a, b);
+    const float* pa[4];
+    const float* pb[4];
+    detail::component_pointers(a, pa);
+    detail::component_pointers(b, pb);
+    hits.resize(a.size());
+    hits.resize(simd::kernels().rect_overlap(pa, pb, hits.data(), a.size()));
+    return hits.size();
+}
+
+/******************************
+ *        批量矩阵变换          *
+ ******************************/
+
+namespace detail {
+    // 超过该元素数量时 Vector4f 变换改用非临时存储, 避免输出污染缓存
+    constexpr size_t kStreamStoreThreshold = size_t(1) << 16;
+
+    inline void check_span_size(size_t in, size_t out) {
+        if (in != out) {
+            throw std::invalid_argument("Input and output sizes do not match");
+        }
+    }
+
+    inline void matrix_elements(const Matrix4x4& m, float (&out)[4][4]) {
+        for (size_t r = 0; r < 4; ++r) {
+            for (size_t c = 0; c < 4; ++c) out[r][c] = m.rows[r].data[c];
+        }
+    }
+
+    // AoS Vector3f 变换, w 为齐次分量 (点为 1, 方向为 0)
+    template<bool Divide>
+    void transform3_aos(const Matrix4x4& m, float w, const Vector3f* in, Vector3f* out, size_t count) {
+#if defined(GM_SIMD_SSE)
+        Vector4f cols[4];
+        detail::mat4_transpose(m.rows, cols);
+        __m128 c3 = _mm_mul_ps(cols[3].simd, _mm_set1_ps(w));
+        for (size_t i = 0; i < count; ++i) {
+            __m128 r = _mm_add_ps(_mm_mul_ps(cols[0].simd, _mm_set1_ps(in[i].x)), c3);
+            r = _mm_add_ps(r, _mm_mul_ps(cols[1].simd, _mm_set1_ps(in[i].y)));
+            r = _mm_add_ps(r, _mm_mul_ps(cols[2].simd, _mm_set1_ps(in[i].z)));
+            if constexpr (Divide) {
+                r = _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+            _mm_storel_pi(reinterpret_cast<__m64*>(&out[i].x), r);
+            _mm_store_ss(&out[i].z, _mm_movehl_ps(r, r));
+        }
+#else
+        float e[4][4];
+        matrix_elements(m, e);
+        for (size_t i = 0; i < count; ++i) {
+            float p[3] = {in[i].x, in[i].y, in[i].z};
+            float o[4];
+            for (size_t r = 0; r < 4; ++r) {
+                o[r] = e[r][0] * p[0] + e[r][1] * p[1] + e[r][2] * p[2] + e[r][3] * w;
+            }
+            if constexpr (Divide) {
+                float inv = 1.0f / o[3];
+                o[0] *= inv; o[1] *= inv; o[2] *= inv;
+            }
+            out[i] = Vector3f(o[0], o[1], o[2]);
+        }
+#endif
+    }
+
+    template<bool Divide>
+    void transform3_soa(const Matrix4x4& m, float w, const Vec3Batch& in, Vec3Batch& out) {
+        out.resize(in.size());
+        float e[4][4];
+        matrix_elements(m, e);
+        const float* pi[3];
+        float* po[3];
+        component_pointers(in, pi);
+        for (size_t c = 0; c < 3; ++c) po[c] = out.component(c);
+        if constexpr (Divide) {
+            simd::kernels().transform3_projected(e, w, pi, po, in.size());
+        } else {
+            simd::kernels().transform3(e, w, pi, po, in.size());
+        }
+    }
+}
+
+/**
+ * @brief 批量变换点 (w = 1): out[i] = (M * [in[i], 1]).xyz
+ * @param out 输出数组, 大小必须与 in 相同, 可以与 in 相同
+ */
+inline void transform_points(const Matrix4x4& m, Span<const Vector3f> in, Span<Vector3f> out) {
+    detail::check_span_size(in.size(), out.size());
+    detail::transform3_aos<false>(m, 1.0f, in.data(), out.data(), in.size());
+}
+
+/**
+ * @brief 批量变换方向 (w = 0, 不受平移影响)
+ */
+inline void transform_directions(const Matrix4x4& m, Span<const Vector3f> in, Span<Vector3f> out) {
+    detail::check_span_size(in.size(), out.size());
+    detail::transform3_aos<false>(m, 0.0f, in.data(), out.data(), in.size());
+}
+
+/**
+ * @brief 批量变换点并做齐次除法 (用于投影矩阵), w 为 0 时结果为无穷大
+ */
+inline void transform_points_projected(const Matrix4x4& m, Span<const Vector3f> in, Span<Vector3f> out) {
+    detail::check_span_size(in.size(), out.size());
+    detail::transform3_aos<true>(m, 1.0f, in.data(), out.data(), in.size());
+}
+
+/**
+ * @brief 批量变换齐次向量: out[i] = M * in[i]
+ *
+ * 大数组使用非临时存储直接写回内存.
+ */
+inline void transform(const Matrix4x4& m, Span<const Vector4f> in, Span<Vector4f> out) {
+    detail::check_span_size(in.size(), out.size());
+#if defined(GM_SIMD_SSE)
+    Vector4f cols[4];
+    detail::mat4_transpose(m.rows, cols);
+    auto apply = [&](const Vector4f& v) {
+        __m128 r = _mm_mul_ps(cols[0].simd, _mm_shuffle_ps(v.simd, v.simd, 0x00));
+        r = _mm_add_ps(r, _mm_mul_ps(cols[1].simd, _mm_shuffle_ps(v.simd, v.simd, 0x55)));
+        r = _mm_add_ps(r, _mm_mul_ps(cols[2].simd, _mm_shuffle_ps(v.simd, v.simd, 0xAA)));
+        return _mm_add_ps(r, _mm_mul_ps(cols[3].simd, _mm_shuffle_ps(v.simd, v.simd, 0xFF)));
+    };
+    if (in.size() >= detail::kStreamStoreThreshold) {
+        for (size_t i = 0; i < in.size(); ++i) {
+            _mm_stream_ps(out[i].data, apply(in[i]));
+        }
+        _mm_sfence();
+    } else {
+        for (size_t i = 0; i < in.size(); ++i) {
+            out[i].simd = apply(in[i]);
+        }
+    }
+#else
+    for (size_t i = 0; i < in.size(); ++i) {
+        out[i] = m * in[i];
+    }
+#endif
+}
+
+/**
+ * @brief SoA 批量变换点, 一次处理 4/8/16 个点 (按运行时检测的档位分派)
+ */
+inline void transform_points(const Matrix4x4& m, const Vec3Batch& in, Vec3Batch& out) {
+    detail::transform3_soa<false>(m, 1.0f, in, out);
+}
+
+/**
+ * @brief SoA 批量变换方向
+ */
+inline void transform_directions(const Matrix4x4& m, const Vec3Batch& in, Vec3Batch& out) {
+    detail::transform3_soa<false>(m, 0.0f, in, out);
+}
+
+/**
+ * @brief SoA 批量变换点并做齐次除法
+ */
+inline void transform_points_projected(const Matrix4x4& m, const Vec3Batch& in, Vec3Batch& out) {
+    detail::transform3_soa<true>(m, 1.0f, in, out);
+}
+
+/******************************
+ *        批量矩阵乘法          *
+ ******************************/
+
+// concatenate 中表示根节点的父节点下标
+constexpr uint32_t kNoParent = 0xFFFFFFFFu;
+
+namespace detail {
+    // out[i] = mul(a[i], b[i]); 大数组的结果用非临时存储写回, 不占用缓存
+    template<typename M, typename Mul>
+    void multiply_pairs_impl(Span<const M> a, Span<const M> b, Span<M> out, Mul mul) {
+        check_span_size(a.size(), out.size());
+        check_span_size(b.size(), out.size());
+#if defined(GM_SIMD_SSE)
+        constexpr size_t kRows = sizeof(M) / sizeof(Vector4f);
+        if (out.size() * kRows >= kStreamStoreThreshold) {
+            for (size_t i = 0; i < out.size(); ++i) {
+                M r = mul(a[i], b[i]);
+                for (size_t k = 0; k < kRows; ++k) _mm_stream_ps(out[i].rows[k].data, r.rows[k].simd);
+            }
+            _mm_sfence();
+            return;
+        }
+#endif
+        for (size_t i = 0; i < out.size(); ++i) out[i] = mul(a[i], b[i]);
+    }
+
+    template<typename M, typename Mul>
+    void concatenate_impl(Span<const uint32_t> parents, Span<const M> local, Span<M> world, Mul mul) {
+        check_span_size(parents.size(), world.size());
+        check_span_size(local.size(), world.size());
+        for (size_t i = 0; i < world.size(); ++i) {
+            uint32_t p = parents[i];
+            if (p == kNoParent) {
+                world[i] = local[i];
+            } else if (p < i) {
+                world[i] = mul(world[p], local[i]);
+            } else {
+                throw std::invalid_argument("concatenate: parent index must precede its child");
+            }
+        }
+    }
+}
+
+/**
+ * @brief 逐对相乘: out[i] = a[i] * b[i] (如父节点世界矩阵 x 骨骼局部矩阵)
+ *
+ * 一次顺序遍历三个数组; 大数组使用非临时存储. out 可以与 a 或 b 相同.
+ * @throws std::invalid_argument 当大小不一致时
+ */
+inline void multiply_pairs(Span<const Matrix4x4> a, Span<const Matrix4x4> b, Span<Matrix4x4> out) {
+    detail::multiply_pairs_impl(a, b, out, [](const Matrix4x4& x, const Matrix4x4& y) { return x * y; });
+}
+
+/**
+ * @brief 仿射 3x4 版本: out[i] = mul_affine(a[i], b[i])
+ */
+inline void multiply_pairs(Span<const Matrix3x4> a, Span<const Matrix3x4> b, Span<Matrix3x4> out) {
+    detail::multiply_pairs_impl(a, b, out, [](const Matrix3x4& x, const Matrix3x4& y) { return mul_affine(x, y); });
+}
+
+/**
+ * @brief 层级连乘: world[i] = world[parents[i]] * local[i], 根节点 (kNoParent) 的 world[i] = local[i]
+ *
+ * 节点须按父节点在前的顺序排列 (先序或按层), 一次顺序遍历得到所有世界矩阵.
+ * world 可以与 local 相同. 抛出异常时出错节点之前的结果已写入.
+ * @throws std::invalid_argument 当大小不一致或父节点下标不小于自身时
+ */
+inline void concatenate(Span<const uint32_t> parents, Span<const Matrix4x4> local, Span<Matrix4x4> world) {
+    detail::concatenate_impl(parents, local, world, [](const Matrix4x4& x, const Matrix4x4& y) { return x * y; });
+}
+
+inline void concatenate(Span<const uint32_t> parents, Span<const Matrix3x4> local, Span<Matrix3x4> world) {
+    detail::concatenate_impl(parents, local, world, [](const Matrix3x4& x, const Matrix3x4& y) { return mul_affine(x, y); });
+}
+
+/******************************
+ *        批量近似数学函数        *
+ ******************************/
+
+namespace detail {
+    inline void math_array(simd::MathOp op, Accuracy accuracy, Span<const float> a, const float* b, Span<float> out) {
+        check_span_size(a.size(), out.size());
+        simd::kernels().math(op, accuracy, a.data(), b, out.data(), a.size());
+    }
+}
+
+// 逐元素计算, out 可以与输入相同, 按运行时检测的 CPU 档位分派.
+// 大小不一致时抛出 std::invalid_argument. 各档位误差与输入范围见 FastMath.hpp.
+namespace fast {
+    inline void sqrt(Span<const float> x, Span<float> out, Accuracy accuracy = Accuracy::High) {
+        detail::math_array(simd::MathOp::Sqrt, accuracy, x, nullptr, out);
+    }
+
+    inline void rsqrt(Span<const float> x, Span<float> out, Accuracy accuracy = Accuracy::High) {
+        detail::math_array(simd::MathOp::Rsqrt, accuracy, x, nullptr, out);
+    }
+
+    inline void sin(Span<const float> x, Span<float> out, Accuracy accuracy = Accuracy::High) {
+        detail::math_array(simd::MathOp::Sin, accuracy, x, nullptr, out);
+    }
+
+    inline void cos(Span<const float> x, Span<float> out, Accuracy accuracy = Accuracy::High) {
+        detail::math_array(simd::MathOp::Cos, accuracy, x, nullptr, out);
+    }
+
+    inline void atan2(Span<const float> y, Span<const float> x, Span<float> out, Accuracy accuracy = Accuracy::High) {
+        detail::check_span_size(y.size(), x.size());
+        detail::math_array(simd::MathOp::Atan2, accuracy, y, x.data(), out);
+    }
+
+    inline void exp(Span<const float> x, Span<float> out, Accuracy accuracy = Accuracy::High) {
+        detail::math_array(simd::MathOp::Exp, accuracy, x, nullptr, out);
+    }
+}
+
+} // namespace GameMath
@@ -13,6 +13,92 @@
     #define GM_SIMD_SSE 1
 #endif
 
+#if defined(__AVX__)
+    #define GM_SIMD_AVX 1
+#endif
+
+#if defined(__AVX2__)
+    #define GM_SIMD_AVX2 1
+#endif
+
+#if defined(__AVX512F__)
+    #define GM_SIMD_AVX512 1
+#endif
+
+#if defined(__FMA__)
+    #define GM_SIMD_FMA 1
+#endif
+
+#if defined(GM_SIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+#include <cstddef>
+
+// 运行时CPU分派 (仅x86): 定义 GM_NO_SIMD_DISPATCH 可关闭
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+    #define GM_ARCH_X86 1
+#endif
+
+#if defined(GM_ARCH_X86) && defined(GM_SIMD_SSE) && !defined(GM_NO_SIMD_DISPATCH)
+    #define GM_SIMD_DISPATCH 1
+#endif
+
+// 指令集目标区域: 区域内定义的函数按指定指令集编译, 供运行时分派使用
+#if defined(__clang__)
+    #define GM_TARGET_AVX2_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx2,fma\"))), apply_to = function)")
+    #define GM_TARGET_AVX512_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx512f,avx2,fma\"))), apply_to = function)")
+    #define GM_TARGET_END _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+    #define GM_TARGET_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma\")")
+    #define GM_TARGET_AVX512_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx2,fma\")")
+    #define GM_TARGET_END _Pragma("GCC pop_options")
+#else
+    #define GM_TARGET_AVX2_BEGIN
+    #define GM_TARGET_AVX512_BEGIN
+    #define GM_TARGET_END
+#endif
+
+// 错误检查策略: GM_CHECKED 为 1 时下标越界、除零、零向量归一化抛出异常;
+// 为 0 时热路径不做检查且访问器为 noexcept. 默认随 NDEBUG 切换, 可显式定义覆盖.
+#if !defined(GM_CHECKED)
+    #if defined(NDEBUG)
+        #define GM_CHECKED 0
+    #else
+        #define GM_CHECKED 1
+    #endif
+#endif
+
+namespace GameMath {
+    // 编译期错误检查策略
+    constexpr bool kChecked = GM_CHECKED != 0;
+
+namespace detail {
+    // 是否处于常量求值中: SIMD 特化在编译期改走标量路径
+    constexpr bool is_constant_evaluated() noexcept {
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+        return __builtin_is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 串行调度: 按顺序对 [0, count) 中每个 i 调用 task(i)
+     *
+     * 接受 parallelFor 参数的接口 (BVH::build、TransformHierarchy::update、gemm 等) 均采用
+     * parallelFor(size_t count, F task) 的形式, 各次 task(i) 可以并发执行;
+     * ThreadPool 可直接传入, 不传时使用本调度.
+     */
+    struct SerialFor {
+        template<typename F>
+        void operator()(size_t count, F&& task) const {
+            for (size_t i = 0; i < count; ++i) task(i);
+        }
+    };
+}
+}
+
 // 数学常量
 namespace GameMath {
     constexpr float PI = 3.14159265358979323846f;
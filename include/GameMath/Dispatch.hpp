@@ -0,0 +1,215 @@
+/******************************
+ *     运行时 CPU 特性分派       *
+ ******************************/
+#pragma once
+#include "Config.hpp"
+#include "Simd.hpp"
+#include "FastMath.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(GM_SIMD_DISPATCH) && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace GameMath {
+namespace simd {
+
+// 指令集档位, 数值越大能力越强
+enum class Tier {
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2,   // AVX2 + FMA
+    AVX512 = 3  // AVX-512F
+};
+
+inline const char* tier_name(Tier tier) {
+    switch (tier) {
+        case Tier::Scalar: return "Scalar";
+        case Tier::SSE2: return "SSE2";
+        case Tier::AVX2: return "AVX2";
+        case Tier::AVX512: return "AVX512";
+    }
+    return "Unknown";
+}
+
+// 批量近似数学函数的种类
+enum class MathOp {
+    Sqrt,
+    Rsqrt,
+    Sin,
+    Cos,
+    Atan2,  // out = atan2(a, b)
+    Exp
+};
+
+/**
+ * @brief 可分派的批量内核函数表 (SoA 三维向量)
+ *
+ * 每个档位各有一份表, 启动时按 CPU 检测结果选定, 也可用 force_tier() 指定.
+ */
+struct KernelTable {
+    // out = (M * [in, w]).xyz
+    void (*transform3)(const float (&m)[4][4], float w, const float* const* in, float* const* out, size_t count);
+    // 同上, 再除以齐次分量
+    void (*transform3_projected)(const float (&m)[4][4], float w, const float* const* in, float* const* out, size_t count);
+    void (*dot3)(const float* const* a, const float* const* b, float* out, size_t count);
+    void (*length3)(const float* const* a, float* out, size_t count, Accuracy accuracy);
+    // 零向量归一化为零向量
+    void (*normalize3)(const float* const* a, float* const* out, size_t count, Accuracy accuracy);
+    // 视锥剔除 (6 个平面), 可见下标写入 out, 返回可见数量; out 至少包含 count 个元素
+    size_t (*cull_aabb)(const float (&planes)[6][4], const float* const* center, const float* const* extent,
+                        uint32_t* out, size_t count);
+    size_t (*cull_sphere)(const float (&planes)[6][4], const float* const* center, const float* radius,
+                          uint32_t* out, size_t count);
+    // 矩形相交 (x, y, w, h 四个分量数组), 相交下标写入 out, 返回相交数量
+    size_t (*rect_overlap)(const float* const* a, const float* const* b, uint32_t* out, size_t count);
+    // 16 通道 xoshiro128** (state[字][通道]), out[b * 16 + k] = lo + scale * u, 共 blocks * 16 个
+    void (*random_uniform)(uint32_t (&state)[4][16], float lo, float hi, float* out, size_t blocks);
+    // 圆内 / 圆周均匀采样, (x, y) 交错写入 out, 共 count 个点
+    void (*random_in_circle)(uint32_t (&state)[4][16], float radius, float* out, size_t count);
+    void (*random_on_circle)(uint32_t (&state)[4][16], float radius, float* out, size_t count);
+    // 逐元素近似数学函数 (见 FastMath.hpp), b 只在 Atan2 时使用
+    void (*math)(MathOp op, Accuracy accuracy, const float* a, const float* b, float* out, size_t count);
+};
+
+} // namespace simd
+
+// 各档位的内核实例
+namespace detail {
+namespace tier_scalar {
+#include "detail/FastMath.inl"
+#include "detail/BatchKernels.inl"
+inline constexpr simd::KernelTable table = make_kernel_table<simd::scalar<float>>();
+}
+
+#if defined(GM_SIMD_DISPATCH)
+namespace tier_sse2 {
+#include "detail/FastMath.inl"
+#include "detail/BatchKernels.inl"
+inline constexpr simd::KernelTable table = make_kernel_table<simd::f32x4>();
+}
+
+GM_TARGET_AVX2_BEGIN
+namespace tier_avx2 {
+#include "detail/FastMath.inl"
+#include "detail/BatchKernels.inl"
+inline constexpr simd::KernelTable table = make_kernel_table<simd::f32x8>();
+}
+GM_TARGET_END
+
+GM_TARGET_AVX512_BEGIN
+namespace tier_avx512 {
+#include "detail/FastMath.inl"
+#include "detail/BatchKernels.inl"
+inline constexpr simd::KernelTable table = make_kernel_table<simd::f32x16>();
+}
+GM_TARGET_END
+#endif
+} // namespace detail
+
+namespace detail {
+    inline simd::Tier detect_tier() {
+#if defined(GM_SIMD_DISPATCH) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool fma = (info[2] & (1 << 12)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        bool avx2 = false, avx512f = false;
+        if (maxLeaf >= 7) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+            avx512f = (info[1] & (1 << 16)) != 0;
+        }
+        // 还需操作系统保存 YMM/ZMM 状态
+        unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+        bool ymm = (xcr0 & 0x6) == 0x6;
+        bool zmm = (xcr0 & 0xE6) == 0xE6;
+        if (avx512f && avx2 && fma && zmm) return simd::Tier::AVX512;
+        if (avx2 && avx && fma && ymm) return simd::Tier::AVX2;
+        if (sse2) return simd::Tier::SSE2;
+#elif defined(GM_SIMD_DISPATCH)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") &&
+            __builtin_cpu_supports("fma")) {
+            return simd::Tier::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return simd::Tier::AVX2;
+        if (__builtin_cpu_supports("sse2")) return simd::Tier::SSE2;
+#endif
+        return simd::Tier::Scalar;
+    }
+
+    inline const simd::KernelTable& table_for(simd::Tier tier) {
+        switch (tier) {
+#if defined(GM_SIMD_DISPATCH)
+            case simd::Tier::AVX512: return tier_avx512::table;
+            case simd::Tier::AVX2: return tier_avx2::table;
+            case simd::Tier::SSE2: return tier_sse2::table;
+#endif
+            default: return tier_scalar::table;
+        }
+    }
+
+    // CPU 检测只在首次访问时执行一次
+    inline simd::Tier detected_tier_cached() {
+        static const simd::Tier tier = detect_tier();
+        return tier;
+    }
+
+    // 当前生效的档位
+    inline std::atomic<simd::Tier>& active_tier_storage() {
+        static std::atomic<simd::Tier> tier{detected_tier_cached()};
+        return tier;
+    }
+}
+
+namespace simd {
+
+/**
+ * @brief 本机 CPU 支持的最高档位 (只检测一次)
+ */
+inline Tier detected_tier() {
+    return detail::detected_tier_cached();
+}
+
+/**
+ * @brief 当前批量内核使用的档位
+ */
+inline Tier active_tier() {
+    return detail::active_tier_storage().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 强制使用指定档位 (用于测试或对比性能)
+ * @throws std::runtime_error 当 CPU 不支持该档位时
+ */
+inline void force_tier(Tier tier) {
+    if (tier > detected_tier()) {
+        throw std::runtime_error("SIMD tier not supported by this CPU");
+    }
+    detail::active_tier_storage().store(tier, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 恢复为检测到的最高档位
+ */
+inline void reset_tier() {
+    detail::active_tier_storage().store(detected_tier(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief 当前档位的批量内核函数表
+ */
+inline const KernelTable& kernels() {
+    return detail::table_for(active_tier());
+}
+
+} // namespace simd
+} // namespace GameMath
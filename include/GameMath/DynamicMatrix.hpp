@@ -0,0 +1,508 @@
+/******************************
+ *     运行时尺寸矩阵与 GEMM       *
+ ******************************/
+#pragma once
+#include "Config.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "Memory.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace GameMath {
+
+namespace detail {
+    template<typename T>
+    struct type_identity { using type = T; };
+
+    template<typename T>
+    using type_identity_t = typename type_identity<T>::type;
+
+    /******************************
+     *        GEMM 分块内核          *
+     ******************************/
+
+    // 浮点使用编译期最宽的打包类型, 其他类型走标量.
+    // 不经过运行时分派: AVX2/AVX-512 内核需要以 -mavx2 -mfma / -mavx512f (或 -march) 编译
+    template<typename T>
+    struct gemm_traits {
+        using P = simd::scalar<T>;
+        static constexpr size_t MR = 4;
+        static constexpr size_t NR = 4;
+    };
+
+    template<>
+    struct gemm_traits<float> {
+        using P = simd::native_t<float>;
+        // 微内核 MR x NR 的累加器占 MR * 2 个寄存器
+        static constexpr size_t MR = P::width == 1 ? 4 : 6;
+        static constexpr size_t NR = P::width == 1 ? 4 : 2 * P::width;
+    };
+
+    // 缓存分块: 每个计算任务反复读取一个 A 块 (MC x KC, 约为 L2 大小), B 面板 (KC x NR) 留在 L1.
+    // 每个 KC 步先把整列 A 面板 (m x KC) 与 B 面板一起打包, 再分给各任务计算
+    constexpr size_t kGemmKC = 256;
+    constexpr size_t kGemmMC = 96;     // 4 与 6 的公倍数
+    constexpr size_t kGemmNC = 2048;   // 所有 NR 的公倍数
+    constexpr size_t kGemmNChunk = 256; // 并行计算时每个任务负责的列数
+    // 不打包直接计算的规模上限 (m * n * k)
+    constexpr size_t kGemmSmall = 32 * 32 * 32;
+    // 低于此规模 (m * n * k) 时不拆分到多个线程
+    constexpr size_t kGemmParallel = 128 * 128 * 128;
+
+    // 把 A 的 mc x kc 块按 MR 行一组打包: 组内按 k 顺序排列, 不足 MR 行补 0
+    template<typename T, size_t MR>
+    void gemm_pack_a(MatrixView<const T> a, size_t row, size_t col, size_t mc, size_t kc, T* out) {
+        for (size_t i0 = 0; i0 < mc; i0 += MR) {
+            size_t mr = std::min(MR, mc - i0);
+            for (size_t p = 0; p < kc; ++p) {
+                for (size_t i = 0; i < mr; ++i) out[i] = a(row + i0 + i, col + p);
+                for (size_t i = mr; i < MR; ++i) out[i] = T(0);
+                out += MR;
+            }
+        }
+    }
+
+    // 把 B 的 kc x nc 块按 NR 列一组打包, 不足 NR 列补 0
+    template<typename T, size_t NR>
+    void gemm_pack_b(MatrixView<const T> b, size_t row, size_t col, size_t kc, size_t nc, T* out) {
+        for (size_t j0 = 0; j0 < nc; j0 += NR) {
+            size_t nr = std::min(NR, nc - j0);
+            for (size_t p = 0; p < kc; ++p) {
+                if (nr == NR && b.col_stride() == 1) {
+                    std::memcpy(out, &b(row + p, col + j0), NR * sizeof(T));
+                } else {
+                    for (size_t j = 0; j < nr; ++j) out[j] = b(row + p, col + j0 + j);
+                    for (size_t j = nr; j < NR; ++j) out[j] = T(0);
+                }
+                out += NR;
+            }
+        }
+    }
+
+    // 寄存器分块微内核: tile(MR x NR) = Apanel(MR x kc) * Bpanel(kc x NR)
+    template<typename T, typename P, size_t MR, size_t NR>
+    void gemm_micro(size_t kc, const T* a, const T* b, T* tile) {
+        constexpr size_t W = P::width;
+        constexpr size_t NV = NR / W;
+        typename P::reg acc[MR][NV];
+        for (size_t i = 0; i < MR; ++i)
+            for (size_t v = 0; v < NV; ++v) acc[i][v] = P::zero();
+        for (size_t p = 0; p < kc; ++p) {
+            typename P::reg bv[NV];
+            for (size_t v = 0; v < NV; ++v) bv[v] = P::load(b + v * W);
+            for (size_t i = 0; i < MR; ++i) {
+                auto av = P::set1(a[i]);
+                for (size_t v = 0; v < NV; ++v) acc[i][v] = P::fmadd(av, bv[v], acc[i][v]);
+            }
+            a += MR;
+            b += NR;
+        }
+        for (size_t i = 0; i < MR; ++i)
+            for (size_t v = 0; v < NV; ++v) P::store(tile + i * NR + v * W, acc[i][v]);
+    }
+
+    // c = alpha * tile + beta * c (beta 为 0 时不读取 c)
+    template<typename T>
+    void gemm_write(MatrixView<T> c, size_t row, size_t col, size_t mr, size_t nr, size_t ldt,
+                    const T* tile, T alpha, T beta) {
+        for (size_t i = 0; i < mr; ++i) {
+            for (size_t j = 0; j < nr; ++j) {
+                T& out = c(row + i, col + j);
+                T v = alpha * tile[i * ldt + j];
+                out = beta == T(0) ? v : v + beta * out;
+            }
+        }
+    }
+
+    // 小矩阵: 不打包, 按行做 c_row += a_ik * b_row (要求 b 与 c 的列步长为 1)
+    template<typename T>
+    void gemm_small(MatrixView<const T> a, MatrixView<const T> b, MatrixView<T> c, T alpha, T beta) {
+        using P = typename gemm_traits<T>::P;
+        using S = simd::scalar<T>;
+        constexpr size_t W = P::width;
+        size_t n = c.cols();
+        for (size_t i = 0; i < c.rows(); ++i) {
+            T* out = &c(i, 0);
+            if (beta == T(0)) {
+                std::fill(out, out + n, T(0));
+            } else if (beta != T(1)) {
+                for (size_t j = 0; j < n; ++j) out[j] *= beta;
+            }
+            for (size_t p = 0; p < a.cols(); ++p) {
+                T s = alpha * a(i, p);
+                const T* in = &b(p, 0);
+                size_t j = 0;
+                auto sv = P::set1(s);
+                for (; j + W <= n; j += W) P::store(out + j, P::fmadd(sv, P::load(in + j), P::load(out + j)));
+                for (; j < n; ++j) out[j] = S::fmadd(s, in[j], out[j]);
+            }
+        }
+    }
+
+    // 打包缓冲区, 容量只增不减
+    template<typename T>
+    struct GemmBuffers {
+        AlignedArray<T> a, b;
+        size_t aCapacity = 0, bCapacity = 0;
+        bool busy = false;
+
+        static T* reserve(AlignedArray<T>& data, size_t& capacity, size_t count) {
+            if (count > capacity) {
+                data = make_aligned_array<T>(count);
+                capacity = count;
+            }
+            return data.get();
+        }
+    };
+
+    // 占用调用线程缓存的打包缓冲区, 同规模的重复调用不再申请堆内存.
+    // 同一线程重入时 (如 parallelFor 等待期间执行了另一个 gemm) 改用临时缓冲区
+    template<typename T>
+    class GemmScratch {
+    public:
+        GemmScratch(size_t aCount, size_t bCount) {
+            thread_local GemmBuffers<T> cached;
+            m_buffers = cached.busy ? &m_own : &cached;
+            m_buffers->busy = true;
+            m_a = GemmBuffers<T>::reserve(m_buffers->a, m_buffers->aCapacity, aCount);
+            m_b = GemmBuffers<T>::reserve(m_buffers->b, m_buffers->bCapacity, bCount);
+        }
+        ~GemmScratch() { m_buffers->busy = false; }
+
+        GemmScratch(const GemmScratch&) = delete;
+        GemmScratch& operator=(const GemmScratch&) = delete;
+
+        T* a() const { return m_a; }
+        T* b() const { return m_b; }
+
+    private:
+        GemmBuffers<T> m_own;
+        GemmBuffers<T>* m_buffers;
+        T* m_a;
+        T* m_b;
+    };
+
+    template<typename T, typename ParallelFor>
+    void gemm_blocked(MatrixView<const T> a, MatrixView<const T> b, MatrixView<T> c, T alpha, T beta,
+                      ParallelFor&& parallelFor) {
+        using Traits = gemm_traits<T>;
+        using P = typename Traits::P;
+        constexpr size_t MR = Traits::MR;
+        constexpr size_t NR = Traits::NR;
+        const size_t m = c.rows(), n = c.cols(), k = a.cols();
+
+        const size_t mBlocks = (m + kGemmMC - 1) / kGemmMC;
+        const size_t mPadded = (m + MR - 1) / MR * MR;
+        GemmScratch<T> scratch(mPadded * kGemmKC, kGemmKC * ((std::min(n, kGemmNC) + NR - 1) / NR * NR));
+        T* const packedA = scratch.a();
+        T* const packedB = scratch.b();
+
+        for (size_t jc = 0; jc < n; jc += kGemmNC) {
+            const size_t nc = std::min(kGemmNC, n - jc);
+            const size_t nChunks = (nc + kGemmNChunk - 1) / kGemmNChunk;
+            for (size_t pc = 0; pc < k; pc += kGemmKC) {
+                const size_t kc = std::min(kGemmKC, k - pc);
+                const T betaNow = pc == 0 ? beta : T(1);
+
+                // 第一阶段: 打包所有 A 块与 B 的各列组
+                parallelFor(mBlocks + nChunks, [&](size_t task) {
+                    if (task < mBlocks) {
+                        size_t ic = task * kGemmMC;
+                        gemm_pack_a<T, MR>(a, ic, pc, std::min(kGemmMC, m - ic), kc, packedA + ic * kc);
+                    } else {
+                        size_t jr = (task - mBlocks) * kGemmNChunk;
+                        gemm_pack_b<T, NR>(b, pc, jc + jr, kc, std::min(kGemmNChunk, nc - jr), packedB + jr * kc);
+                    }
+                });
+
+                // 第二阶段: 每个任务计算一个 MC x NChunk 的 C 块
+                parallelFor(mBlocks * nChunks, [&](size_t task) {
+                    size_t ic = (task / nChunks) * kGemmMC;
+                    size_t jr0 = (task % nChunks) * kGemmNChunk;
+                    size_t mc = std::min(kGemmMC, m - ic);
+                    size_t jrEnd = std::min(nc, jr0 + kGemmNChunk);
+                    alignas(64) T tile[MR * NR];
+                    for (size_t jr = jr0; jr < jrEnd; jr += NR) {
+                        const T* bp = packedB + jr * kc;
+                        size_t nr = std::min(NR, nc - jr);
+                        for (size_t ir = 0; ir < mc; ir += MR) {
+                            gemm_micro<T, P, MR, NR>(kc, packedA + (ic + ir) * kc, bp, tile);
+                            gemm_write(c, ic + ir, jc + jr, std::min(MR, mc - ir), nr, NR, tile, alpha, betaNow);
+                        }
+                    }
+                });
+            }
+        }
+    }
+
+    template<typename T, typename ParallelFor>
+    void gemm_dispatch(MatrixView<const T> a, MatrixView<const T> b, MatrixView<T> c, T alpha, T beta,
+                       ParallelFor&& parallelFor, bool parallel) {
+        if (a.rows() != c.rows() || b.cols() != c.cols() || a.cols() != b.rows()) {
+            throw std::invalid_argument("gemm: matrix dimensions do not match");
+        }
+        const size_t m = c.rows(), n = c.cols(), k = a.cols();
+        if (m == 0 || n == 0) return;
+        if (k == 0) {
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < n; ++j) c(i, j) = beta == T(0) ? T(0) : beta * c(i, j);
+            return;
+        }
+        const size_t work = m * n * k;
+        if (work <= kGemmSmall && b.col_stride() == 1 && c.col_stride() == 1) {
+            gemm_small(a, b, c, alpha, beta);
+        } else if (parallel && work >= kGemmParallel) {
+            gemm_blocked(a, b, c, alpha, beta, parallelFor);
+        } else {
+            gemm_blocked(a, b, c, alpha, beta, SerialFor{});
+        }
+    }
+}
+
+/**
+ * @brief 通用矩阵乘 c = alpha * a * b + beta * c
+ *
+ * a、b 可以是任意跨步视图 (如转置、子块), 打包时统一重排为连续面板;
+ * 内核按 Goto 的分块方式: 每个任务读取的 A 块 (MC x KC) 留在 L2, B 面板留在 L1, MR x NR 的累加器常驻寄存器.
+ * 打包缓冲区按调用线程缓存复用 (容量为所遇到的最大规模).
+ * float 内核使用编译期的最宽指令集, 不经过运行时分派; 需要 AVX2/AVX-512 内核时以相应的 -march 编译.
+ * beta 为 0 时不读取 c 的原值. c 不得与 a、b 重叠.
+ * @throws std::invalid_argument 当尺寸不匹配时
+ */
+template<typename T>
+void gemm(detail::type_identity_t<MatrixView<const T>> a, detail::type_identity_t<MatrixView<const T>> b,
+          MatrixView<T> c, T alpha = T(1), T beta = T(0)) {
+    detail::gemm_dispatch(a, b, c, alpha, beta, detail::SerialFor{}, false);
+}
+
+/**
+ * @brief 同上, 规模较大时把分块任务交给 parallelFor 并行执行
+ * @param parallelFor 并行调度函数 (如 ThreadPool), 约定见 detail::SerialFor
+ */
+template<typename T, typename ParallelFor>
+void gemm(detail::type_identity_t<MatrixView<const T>> a, detail::type_identity_t<MatrixView<const T>> b,
+          MatrixView<T> c, T alpha, T beta, ParallelFor&& parallelFor) {
+    detail::gemm_dispatch(a, b, c, alpha, beta, parallelFor, true);
+}
+
+/**
+ * @brief 运行时尺寸的稠密矩阵 (行主序, 64 字节对齐的堆存储)
+ *
+ * 用于影响力图、小型神经网络等尺寸在运行时决定的场合;
+ * 乘法使用分块 GEMM, 可通过 multiply(a, b, parallelFor) 拆分到多个线程.
+ */
+template<typename T>
+class DynamicMatrix {
+    static_assert(std::is_arithmetic_v<T>, "DynamicMatrix type must be arithmetic");
+
+    detail::AlignedArray<T> m_data;
+    size_t m_rows = 0;
+    size_t m_cols = 0;
+
+public:
+    // 构造函数
+    DynamicMatrix() = default;
+
+    DynamicMatrix(size_t rows, size_t cols, T value = T(0))
+        : m_data(detail::make_aligned_array<T>(rows * cols)), m_rows(rows), m_cols(cols) {
+        std::fill(begin(), end(), value);
+    }
+
+    DynamicMatrix(std::initializer_list<std::initializer_list<T>> init)
+        : DynamicMatrix(init.size(), init.size() > 0 ? init.begin()->size() : 0) {
+        size_t i = 0;
+        for (const auto& row : init) {
+            if (row.size() != m_cols) {
+                throw std::invalid_argument("DynamicMatrix rows must have the same length");
+            }
+            std::copy(row.begin(), row.end(), m_data.get() + i * m_cols);
+            ++i;
+        }
+    }
+
+    explicit DynamicMatrix(MatrixView<const T> v) : DynamicMatrix(v.rows(), v.cols()) {
+        v.copy_to(m_data.get(), ptrdiff_t(m_cols));
+    }
+
+    template<size_t Rows, size_t Cols>
+    explicit DynamicMatrix(const Matrix<T, Rows, Cols>& m) : DynamicMatrix(GameMath::view(m)) {}
+
+    DynamicMatrix(const DynamicMatrix& other) : DynamicMatrix(other.m_rows, other.m_cols) {
+        std::copy(other.begin(), other.end(), begin());
+    }
+
+    DynamicMatrix(DynamicMatrix&& other) noexcept
+        : m_data(std::move(other.m_data)), m_rows(other.m_rows), m_cols(other.m_cols) {
+        other.m_rows = other.m_cols = 0;
+    }
+
+    DynamicMatrix& operator=(const DynamicMatrix& other) {
+        if (this != &other) {
+            if (size() != other.size()) m_data = detail::make_aligned_array<T>(other.size());
+            m_rows = other.m_rows;
+            m_cols = other.m_cols;
+            std::copy(other.begin(), other.end(), begin());
+        }
+        return *this;
+    }
+
+    DynamicMatrix& operator=(DynamicMatrix&& other) noexcept {
+        m_data = std::move(other.m_data);
+        m_rows = other.m_rows;
+        m_cols = other.m_cols;
+        other.m_rows = other.m_cols = 0;
+        return *this;
+    }
+
+    // 静态工厂方法
+    static DynamicMatrix identity(size_t size) {
+        DynamicMatrix result(size, size);
+        for (size_t i = 0; i < size; ++i) result.m_data[i * size + i] = T(1);
+        return result;
+    }
+
+    static DynamicMatrix zero(size_t rows, size_t cols) { return DynamicMatrix(rows, cols); }
+
+    // 尺寸与存储
+    size_t rows() const { return m_rows; }
+    size_t cols() const { return m_cols; }
+    size_t size() const { return m_rows * m_cols; }
+    bool empty() const { return size() == 0; }
+    T* data() { return m_data.get(); }
+    const T* data() const { return m_data.get(); }
+    T* begin() { return m_data.get(); }
+    T* end() { return m_data.get() + size(); }
+    const T* begin() const { return m_data.get(); }
+    const T* end() const { return m_data.get() + size(); }
+
+    // 行列访问 (GM_CHECKED 为 0 时不检查下标)
+    T& operator()(size_t row, size_t col) noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (row >= m_rows || col >= m_cols) {
+                throw std::out_of_range("DynamicMatrix indices out of range");
+            }
+        }
+        return m_data[row * m_cols + col];
+    }
+
+    const T& operator()(size_t row, size_t col) const noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (row >= m_rows || col >= m_cols) {
+                throw std::out_of_range("DynamicMatrix indices out of range");
+            }
+        }
+        return m_data[row * m_cols + col];
+    }
+
+    // 始终检查下标的访问
+    T& at(size_t row, size_t col) {
+        if (row >= m_rows || col >= m_cols) {
+            throw std::out_of_range("DynamicMatrix indices out of range");
+        }
+        return m_data[row * m_cols + col];
+    }
+
+    const T& at(size_t row, size_t col) const {
+        if (row >= m_rows || col >= m_cols) {
+            throw std::out_of_range("DynamicMatrix indices out of range");
+        }
+        return m_data[row * m_cols + col];
+    }
+
+    Span<T> row(size_t index) {
+        if (index >= m_rows) throw std::out_of_range("DynamicMatrix row out of range");
+        return Span<T>(m_data.get() + index * m_cols, m_cols);
+    }
+
+    Span<const T> row(size_t index) const {
+        if (index >= m_rows) throw std::out_of_range("DynamicMatrix row out of range");
+        return Span<const T>(m_data.get() + index * m_cols, m_cols);
+    }
+
+    MatrixView<T> view() { return MatrixView<T>(m_data.get(), m_rows, m_cols); }
+    MatrixView<const T> view() const { return MatrixView<const T>(m_data.get(), m_rows, m_cols); }
+
+    void fill(T value) { std::fill(begin(), end(), value); }
+
+    // 矩阵操作
+    DynamicMatrix transposed() const { return DynamicMatrix(view().transposed()); }
+
+    // 运算符重载
+    DynamicMatrix& operator+=(const DynamicMatrix& rhs) {
+        check_same_shape(rhs);
+        for (size_t i = 0; i < size(); ++i) m_data[i] += rhs.m_data[i];
+        return *this;
+    }
+
+    DynamicMatrix& operator-=(const DynamicMatrix& rhs) {
+        check_same_shape(rhs);
+        for (size_t i = 0; i < size(); ++i) m_data[i] -= rhs.m_data[i];
+        return *this;
+    }
+
+    DynamicMatrix& operator*=(T scalar) {
+        for (size_t i = 0; i < size(); ++i) m_data[i] *= scalar;
+        return *this;
+    }
+
+    DynamicMatrix operator+(const DynamicMatrix& rhs) const { return DynamicMatrix(*this) += rhs; }
+    DynamicMatrix operator-(const DynamicMatrix& rhs) const { return DynamicMatrix(*this) -= rhs; }
+    DynamicMatrix operator*(T scalar) const { return DynamicMatrix(*this) *= scalar; }
+
+    DynamicMatrix operator*(const DynamicMatrix& rhs) const {
+        if (m_cols != rhs.m_rows) {
+            throw std::invalid_argument("DynamicMatrix multiply: dimensions do not match");
+        }
+        DynamicMatrix result(m_rows, rhs.m_cols);
+        gemm<T>(view(), rhs.view(), result.view());
+        return result;
+    }
+
+    bool operator==(const DynamicMatrix& rhs) const {
+        return m_rows == rhs.m_rows && m_cols == rhs.m_cols && std::equal(begin(), end(), rhs.begin());
+    }
+
+    bool operator!=(const DynamicMatrix& rhs) const { return !(*this == rhs); }
+
+private:
+    void check_same_shape(const DynamicMatrix& rhs) const {
+        if (m_rows != rhs.m_rows || m_cols != rhs.m_cols) {
+            throw std::invalid_argument("DynamicMatrix dimensions do not match");
+        }
+    }
+};
+
+template<typename T>
+DynamicMatrix<T> operator*(T scalar, const DynamicMatrix<T>& matrix) {
+    return matrix * scalar;
+}
+
+template<typename T>
+MatrixView<T> view(DynamicMatrix<T>& m) { return m.view(); }
+
+template<typename T>
+MatrixView<const T> view(const DynamicMatrix<T>& m) { return m.view(); }
+
+/**
+ * @brief a * b, 规模较大时通过 parallelFor 拆分到多个线程
+ * @throws std::invalid_argument 当尺寸不匹配时
+ */
+template<typename T, typename ParallelFor>
+DynamicMatrix<T> multiply(const DynamicMatrix<T>& a, const DynamicMatrix<T>& b, ParallelFor&& parallelFor) {
+    if (a.cols() != b.rows()) {
+        throw std::invalid_argument("DynamicMatrix multiply: dimensions do not match");
+    }
+    DynamicMatrix<T> result(a.rows(), b.cols());
+    gemm<T>(a.view(), b.view(), result.view(), T(1), T(0), parallelFor);
+    return result;
+}
+
+} // namespace GameMath
@@ -0,0 +1,279 @@
+/******************************
+ *    表达式模板 (延迟求值)      *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Simd.hpp"
+#include <cmath>
+#include <type_traits>
+
+namespace GameMath {
+
+/**
+ * @brief 可选的表达式模板层
+ *
+ * Vector/Matrix 的运算符默认按值返回结果; 用 expr::lazy() 包装操作数后,
+ * 运算符只构建表达式树, 在赋值给 Vector/Matrix 时一次遍历求值, 不产生临时对象.
+ * 形如 a + b * s 与 a - b * s 的节点以乘加 (FMA) 求值;
+ * Vector4f 及 Matrix4x4 按行使用 __m128 打包求值.
+ *
+ *   Vector4f r = expr::lazy(a) + (expr::lazy(b) - expr::lazy(a)) * t;
+ *
+ * 叶子节点只保存引用, 表达式不得比操作数存活更久.
+ */
+namespace expr {
+
+// 表达式基类 (CRTP)
+template<typename E>
+struct Expr {
+    constexpr const E& self() const noexcept { return static_cast<const E&>(*this); }
+
+    // 隐式转换为结果类型时求值
+    template<typename V, typename Self = E,
+             typename = std::enable_if_t<std::is_same_v<V, typename Self::result_type>>>
+    operator V() const noexcept {
+        return eval(*this);
+    }
+};
+
+namespace detail {
+    // 求值结果的形状: Vector 视为 1 行
+    template<typename V>
+    struct shape;
+
+    template<typename T, size_t N>
+    struct shape<Vector<T, N>> {
+        using value_type = T;
+        using row_type = Vector<T, N>;
+        static constexpr size_t rows = 1;
+        static constexpr size_t cols = N;
+
+        static row_type& row(Vector<T, N>& v, size_t) noexcept { return v; }
+        static const row_type& row(const Vector<T, N>& v, size_t) noexcept { return v; }
+    };
+
+    template<typename T, size_t R, size_t C>
+    struct shape<Matrix<T, R, C>> {
+        using value_type = T;
+        using row_type = Vector<T, C>;
+        static constexpr size_t rows = R;
+        static constexpr size_t cols = C;
+
+        static row_type& row(Matrix<T, R, C>& m, size_t r) noexcept { return m.rows[r]; }
+        static const row_type& row(const Matrix<T, R, C>& m, size_t r) noexcept { return m.rows[r]; }
+    };
+
+    // 行类型为 Vector4f 时可按 __m128 打包求值
+    template<typename V>
+    constexpr bool is_packet_v =
+#if defined(GM_SIMD_SSE)
+        std::is_same_v<typename shape<V>::row_type, Vector4f>;
+#else
+        false;
+#endif
+
+    // 标量乘加: a * b + c
+    template<typename T>
+    inline T fmadd(T a, T b, T c) noexcept {
+#if defined(GM_SIMD_FMA)
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::fma(a, b, c);
+        }
+#endif
+        return a * b + c;
+    }
+}
+
+// 叶子节点: 引用一个 Vector 或 Matrix
+template<typename V>
+class Terminal : public Expr<Terminal<V>> {
+    const V* m_value;
+
+public:
+    using result_type = V;
+    using value_type = typename detail::shape<V>::value_type;
+
+    explicit Terminal(const V& value) noexcept : m_value(&value) {}
+
+    value_type coeff(size_t r, size_t c) const noexcept {
+        return detail::shape<V>::row(*m_value, r).unchecked(c);
+    }
+
+#if defined(GM_SIMD_SSE)
+    __m128 packet(size_t r) const noexcept {
+        return detail::shape<V>::row(*m_value, r).simd;
+    }
+#endif
+};
+
+// 数乘节点: e * s
+template<typename E>
+class Scaled : public Expr<Scaled<E>> {
+public:
+    using result_type = typename E::result_type;
+    using value_type = typename E::value_type;
+
+    E expr;
+    value_type scalar;
+
+    Scaled(const E& e, value_type s) noexcept : expr(e), scalar(s) {}
+
+    value_type coeff(size_t r, size_t c) const noexcept {
+        return expr.coeff(r, c) * scalar;
+    }
+
+#if defined(GM_SIMD_SSE)
+    __m128 packet(size_t r) const noexcept {
+        return simd::f32x4::mul(expr.packet(r), simd::f32x4::set1(scalar));
+    }
+#endif
+};
+
+namespace detail {
+    template<typename E>
+    struct is_scaled : std::false_type {};
+
+    template<typename E>
+    struct is_scaled<Scaled<E>> : std::true_type {};
+}
+
+// 加减节点: l + r 或 l - r; 任一侧为数乘节点时以乘加求值
+template<typename L, typename R, bool Subtract>
+class Binary : public Expr<Binary<L, R, Subtract>> {
+    L m_lhs;
+    R m_rhs;
+
+public:
+    using result_type = typename L::result_type;
+    using value_type = typename L::value_type;
+
+    static_assert(std::is_same_v<result_type, typename R::result_type>,
+                  "Expression operands must have the same type and dimensions");
+
+    Binary(const L& lhs, const R& rhs) noexcept : m_lhs(lhs), m_rhs(rhs) {}
+
+    value_type coeff(size_t r, size_t c) const noexcept {
+        if constexpr (detail::is_scaled<R>::value) {
+            value_type s = Subtract ? -m_rhs.scalar : m_rhs.scalar;
+            return detail::fmadd(m_rhs.expr.coeff(r, c), s, m_lhs.coeff(r, c));
+        } else if constexpr (detail::is_scaled<L>::value && !Subtract) {
+            return detail::fmadd(m_lhs.expr.coeff(r, c), m_lhs.scalar, m_rhs.coeff(r, c));
+        } else if constexpr (Subtract) {
+            return m_lhs.coeff(r, c) - m_rhs.coeff(r, c);
+        } else {
+            return m_lhs.coeff(r, c) + m_rhs.coeff(r, c);
+        }
+    }
+
+#if defined(GM_SIMD_SSE)
+    __m128 packet(size_t r) const noexcept {
+        using P = simd::f32x4;
+        if constexpr (detail::is_scaled<R>::value) {
+            __m128 s = P::set1(Subtract ? -m_rhs.scalar : m_rhs.scalar);
+            return P::fmadd(m_rhs.expr.packet(r), s, m_lhs.packet(r));
+        } else if constexpr (detail::is_scaled<L>::value && !Subtract) {
+            return P::fmadd(m_lhs.expr.packet(r), P::set1(m_lhs.scalar), m_rhs.packet(r));
+        } else if constexpr (Subtract) {
+            return P::sub(m_lhs.packet(r), m_rhs.packet(r));
+        } else {
+            return P::add(m_lhs.packet(r), m_rhs.packet(r));
+        }
+    }
+#endif
+};
+
+/**
+ * @brief 包装操作数, 之后的运算构建表达式而不是立即求值
+ */
+template<typename T, size_t N>
+Terminal<Vector<T, N>> lazy(const Vector<T, N>& v) noexcept {
+    return Terminal<Vector<T, N>>(v);
+}
+
+template<typename T, size_t R, size_t C>
+Terminal<Matrix<T, R, C>> lazy(const Matrix<T, R, C>& m) noexcept {
+    return Terminal<Matrix<T, R, C>>(m);
+}
+
+// 禁止包装临时对象, 否则叶子节点会悬空
+template<typename T, size_t N>
+void lazy(const Vector<T, N>&&) = delete;
+
+template<typename T, size_t R, size_t C>
+void lazy(const Matrix<T, R, C>&&) = delete;
+
+/**
+ * @brief 将表达式写入 out (逐元素求值, out 可与操作数相同)
+ */
+template<typename E>
+void assign(typename E::result_type& out, const Expr<E>& e) noexcept {
+    using V = typename E::result_type;
+    using S = detail::shape<V>;
+    const E& x = e.self();
+    for (size_t r = 0; r < S::rows; ++r) {
+#if defined(GM_SIMD_SSE)
+        if constexpr (detail::is_packet_v<V>) {
+            S::row(out, r).simd = x.packet(r);
+            continue;
+        }
+#endif
+        for (size_t c = 0; c < S::cols; ++c) {
+            S::row(out, r).unchecked(c) = x.coeff(r, c);
+        }
+    }
+}
+
+/**
+ * @brief 求值表达式, 返回 Vector 或 Matrix
+ */
+template<typename E>
+typename E::result_type eval(const Expr<E>& e) noexcept {
+    typename E::result_type out;
+    assign(out, e);
+    return out;
+}
+
+// 运算符
+template<typename L, typename R>
+Binary<L, R, false> operator+(const Expr<L>& lhs, const Expr<R>& rhs) noexcept {
+    return Binary<L, R, false>(lhs.self(), rhs.self());
+}
+
+template<typename L, typename R>
+Binary<L, R, true> operator-(const Expr<L>& lhs, const Expr<R>& rhs) noexcept {
+    return Binary<L, R, true>(lhs.self(), rhs.self());
+}
+
+template<typename E>
+Scaled<E> operator*(const Expr<E>& e, typename E::value_type s) noexcept {
+    return Scaled<E>(e.self(), s);
+}
+
+template<typename E>
+Scaled<E> operator*(typename E::value_type s, const Expr<E>& e) noexcept {
+    return Scaled<E>(e.self(), s);
+}
+
+// 嵌套数乘合并为一个系数
+template<typename E>
+Scaled<E> operator*(const Scaled<E>& e, typename E::value_type s) noexcept {
+    return Scaled<E>(e.expr, e.scalar * s);
+}
+
+template<typename E>
+Scaled<E> operator*(typename E::value_type s, const Scaled<E>& e) noexcept {
+    return Scaled<E>(e.expr, e.scalar * s);
+}
+
+/**
+ * @brief 线性插值 a + (b - a) * t, 每个元素一次减法与一次乘加
+ */
+template<typename V, typename U>
+V lerp(const V& a, const V& b, U t) noexcept {
+    using T = typename detail::shape<V>::value_type;
+    return eval(lazy(a) + (lazy(b) - lazy(a)) * static_cast<T>(t));
+}
+
+} // namespace expr
+} // namespace GameMath
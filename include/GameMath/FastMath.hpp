@@ -0,0 +1,65 @@
+/******************************
+ *         近似数学函数          *
+ ******************************/
+#pragma once
+#include "Config.hpp"
+#include "Simd.hpp"
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace GameMath {
+
+/**
+ * @brief 近似精度档位
+ *
+ * Exact 与标准库一致; High 误差在 1e-7 量级, 适合绝大多数游戏逻辑;
+ * Low 误差在 1e-3 ~ 1e-4 量级, 适合粒子、动画等对精度不敏感的场合.
+ * 各函数的具体误差见 detail/FastMath.inl.
+ */
+enum class Accuracy {
+    Exact = 0,
+    High,
+    Low
+};
+
+namespace detail {
+#include "detail/FastMath.inl"
+}
+
+/**
+ * @brief 标量近似函数, 与批量版本 (Batch.hpp 中的 fast::sin 等) 使用同一套多项式
+ *
+ * 精度档位为模板参数, 默认 Accuracy::High:
+ * @code
+ * float s = fast::sin(angle);
+ * float inv = fast::rsqrt<Accuracy::Low>(len2);
+ * @endcode
+ */
+namespace fast {
+    using P1 = simd::scalar<float>;
+
+    // x 须为正规正数 (>= FLT_MIN), 0 与非规格化数的结果未定义
+    template<Accuracy A = Accuracy::High>
+    inline float rsqrt(float x) { return detail::fast_rsqrt<A, P1>(x); }
+
+    template<Accuracy A = Accuracy::High>
+    inline float sqrt(float x) { return detail::fast_sqrt<A, P1>(x); }
+
+    template<Accuracy A = Accuracy::High>
+    inline float sin(float x) { return detail::fast_sin<A, P1>(x); }
+
+    template<Accuracy A = Accuracy::High>
+    inline float cos(float x) { return detail::fast_cos<A, P1>(x); }
+
+    template<Accuracy A = Accuracy::High>
+    inline void sincos(float x, float& s, float& c) { detail::fast_sincos<A, P1>(x, s, c); }
+
+    template<Accuracy A = Accuracy::High>
+    inline float atan2(float y, float x) { return detail::fast_atan2<A, P1>(y, x); }
+
+    template<Accuracy A = Accuracy::High>
+    inline float exp(float x) { return detail::fast_exp<A, P1>(x); }
+}
+
+} // namespace GameMath
@@ -6,13 +6,21 @@
 // 基础数学类型
 #include "GameMath/Vector.hpp"
 #include "GameMath/Matrix.hpp"
-// #include "GameMath/Quaternion.hpp"
+#include "GameMath/Memory.hpp"
+#include "GameMath/MatrixView.hpp"
+#include "GameMath/DynamicMatrix.hpp"
+#include "GameMath/Batch.hpp"
+#include "GameMath/Expr.hpp"
+#include "GameMath/Quaternion.hpp"
 
 // 高级功能
-// #include "GameMath/Transform.hpp"
-// #include "GameMath/Geometry.hpp"
-// #include "GameMath/Random.hpp"
-// #include "GameMath/Interpolation.hpp"
+#include "GameMath/Transform.hpp"
+#include "GameMath/Geometry.hpp"
+#include "GameMath/SpatialHash.hpp"
+#include "GameMath/BVH.hpp"
+#include "GameMath/Random.hpp"
+#include "GameMath/Interpolation.hpp"
+#include "GameMath/ThreadPool.hpp"
 #include "GameMath/Utility.hpp"
 
 // 常用类型别名
@@ -26,6 +34,6 @@ namespace GameMath {
     using Mat3 = Matrix<float, 3, 3>;
     using Mat4 = Matrix<float, 4, 4>;
     
-    // // 四元数
-    // using Quat = Quaternion;
+    // 四元数
+    using Quat = Quaternion;
 }
\ No newline at end of file
@@ -0,0 +1,286 @@
+/******************************
+ *      几何图元与视锥剔除       *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Batch.hpp"
+#include "Dispatch.hpp"
+#include "Span.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace GameMath {
+
+/**
+ * @brief 平面 dot(normal, p) + d = 0, 法线一侧为正
+ */
+struct Plane {
+    Vector3f normal{0.0f, 1.0f, 0.0f};
+    float d = 0.0f;
+
+    constexpr Plane() = default;
+    constexpr Plane(const Vector3f& n, float distance) : normal(n), d(distance) {}
+
+    // 过点 point, 法线为 n (n 须为单位向量)
+    static constexpr Plane from_point_normal(const Vector3f& point, const Vector3f& n) {
+        return Plane(n, -n.dot(point));
+    }
+
+    // 有符号距离 (法线为单位向量时即为欧氏距离)
+    constexpr float distance(const Vector3f& p) const { return normal.dot(p) + d; }
+
+    /**
+     * @brief 法线归一化, 距离同比缩放
+     * @throws std::runtime_error 当法线为零向量时
+     */
+    Plane normalized() const {
+        float len = normal.length();
+        if (len == 0.0f) {
+            throw std::runtime_error("Cannot normalize plane with zero normal");
+        }
+        float inv = 1.0f / len;
+        return Plane(normal * inv, d * inv);
+    }
+};
+
+/**
+ * @brief 轴对齐包围盒, 以最小/最大角点表示
+ */
+struct AABB {
+    Vector3f min{0.0f, 0.0f, 0.0f};
+    Vector3f max{0.0f, 0.0f, 0.0f};
+
+    constexpr AABB() = default;
+    constexpr AABB(const Vector3f& lo, const Vector3f& hi) : min(lo), max(hi) {}
+
+    static constexpr AABB from_center_extents(const Vector3f& center, const Vector3f& extents) {
+        return AABB(center - extents, center + extents);
+    }
+
+    // 空包围盒: 与任意点合并后即为该点
+    static constexpr AABB empty() {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        return AABB(Vector3f(inf, inf, inf), Vector3f(-inf, -inf, -inf));
+    }
+
+    constexpr Vector3f center() const { return (min + max) * 0.5f; }
+    constexpr Vector3f extents() const { return (max - min) * 0.5f; }
+    constexpr Vector3f size() const { return max - min; }
+
+    constexpr bool valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    constexpr float surface_area() const {
+        Vector3f s = max - min;
+        return 2.0f * (s.x * s.y + s.y * s.z + s.z * s.x);
+    }
+
+    constexpr bool contains(const Vector3f& p) const {
+        return p.x >= min.x && p.x <= max.x &&
+               p.y >= min.y && p.y <= max.y &&
+               p.z >= min.z && p.z <= max.z;
+    }
+
+    constexpr bool intersects(const AABB& o) const {
+        return min.x <= o.max.x && max.x >= o.min.x &&
+               min.y <= o.max.y && max.y >= o.min.y &&
+               min.z <= o.max.z && max.z >= o.min.z;
+    }
+
+    // 扩展以包含点 p 或另一个包围盒
+    constexpr void expand(const Vector3f& p) {
+        min = Vector3f(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+        max = Vector3f(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+    }
+
+    constexpr void expand(const AABB& o) {
+        min = Vector3f(std::min(min.x, o.min.x), std::min(min.y, o.min.y), std::min(min.z, o.min.z));
+        max = Vector3f(std::max(max.x, o.max.x), std::max(max.y, o.max.y), std::max(max.z, o.max.z));
+    }
+
+    /**
+     * @brief 经仿射矩阵变换后的包围盒 (包含变换后的 8 个角点)
+     */
+    AABB transformed(const Matrix4x4& m) const {
+        Vector3f c = center();
+        Vector3f e = extents();
+        float nc[3], ne[3];
+        for (size_t r = 0; r < 3; ++r) {
+            const Vector4f& row = m.rows[r];
+            nc[r] = row.x * c.x + row.y * c.y + row.z * c.z + row.w;
+            ne[r] = std::fabs(row.x) * e.x + std::fabs(row.y) * e.y + std::fabs(row.z) * e.z;
+        }
+        return from_center_extents(Vector3f(nc[0], nc[1], nc[2]), Vector3f(ne[0], ne[1], ne[2]));
+    }
+};
+
+/**
+ * @brief 包围球
+ */
+struct Sphere {
+    Vector3f center{0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;
+
+    constexpr Sphere() = default;
+    constexpr Sphere(const Vector3f& c, float r) : center(c), radius(r) {}
+
+    constexpr bool contains(const Vector3f& p) const {
+        return (p - center).length_squared() <= radius * radius;
+    }
+
+    constexpr bool intersects(const Sphere& o) const {
+        float r = radius + o.radius;
+        return (o.center - center).length_squared() <= r * r;
+    }
+
+    constexpr bool intersects(const AABB& box) const {
+        float dx = std::max(std::max(box.min.x - center.x, 0.0f), center.x - box.max.x);
+        float dy = std::max(std::max(box.min.y - center.y, 0.0f), center.y - box.max.y);
+        float dz = std::max(std::max(box.min.z - center.z, 0.0f), center.z - box.max.z);
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+};
+
+/**
+ * @brief 射线 origin + t * direction, t 取值范围 [tmin, tmax]
+ *
+ * direction 不要求为单位向量, t 以 direction 的长度为单位.
+ */
+struct Ray {
+    Vector3f origin{0.0f, 0.0f, 0.0f};
+    Vector3f direction{0.0f, 0.0f, 1.0f};
+    float tmin = 0.0f;
+    float tmax = std::numeric_limits<float>::infinity();
+
+    constexpr Ray() = default;
+    constexpr Ray(const Vector3f& o, const Vector3f& d,
+                  float start = 0.0f, float end = std::numeric_limits<float>::infinity())
+        : origin(o), direction(d), tmin(start), tmax(end) {}
+
+    // 线段 from -> to (t 范围 [0, 1])
+    static constexpr Ray segment(const Vector3f& from, const Vector3f& to) {
+        return Ray(from, to - from, 0.0f, 1.0f);
+    }
+
+    constexpr Vector3f at(float t) const { return origin + direction * t; }
+};
+
+/**
+ * @brief 视锥, 由 6 个法线指向内部的单位平面组成
+ *
+ * 剔除测试是保守的: 与视锥角落附近相交的物体可能被判为可见, 但可见物体不会被剔除.
+ */
+struct Frustum {
+    enum Side { Left = 0, Right, Bottom, Top, Near, Far };
+
+    Plane planes[6];
+
+    /**
+     * @brief 从观察投影矩阵提取视锥平面 (Gribb-Hartmann)
+     *
+     * 约定与 perspective()/orthographic() 一致: 列向量, 裁剪空间 z 范围 [-1, 1].
+     * 传入投影矩阵得到观察空间视锥, 传入 P * V 得到世界空间视锥.
+     */
+    static Frustum from_matrix(const Matrix4x4& m) {
+        const Vector4f& r0 = m.rows[0];
+        const Vector4f& r1 = m.rows[1];
+        const Vector4f& r2 = m.rows[2];
+        const Vector4f& r3 = m.rows[3];
+        auto make = [&](const Vector4f& r, float s) {
+            return Plane(Vector3f(r3.x + s * r.x, r3.y + s * r.y, r3.z + s * r.z), r3.w + s * r.w).normalized();
+        };
+        Frustum f;
+        f.planes[Left] = make(r0, 1.0f);
+        f.planes[Right] = make(r0, -1.0f);
+        f.planes[Bottom] = make(r1, 1.0f);
+        f.planes[Top] = make(r1, -1.0f);
+        f.planes[Near] = make(r2, 1.0f);
+        f.planes[Far] = make(r2, -1.0f);
+        return f;
+    }
+
+    bool contains(const Vector3f& p) const {
+        for (const Plane& plane : planes) {
+            if (plane.distance(p) < 0.0f) return false;
+        }
+        return true;
+    }
+
+    bool intersects(const Sphere& s) const {
+        for (const Plane& plane : planes) {
+            if (plane.distance(s.center) < -s.radius) return false;
+        }
+        return true;
+    }
+
+    // 以包围盒在平面法线上的投影半径判断 (中心-半长形式)
+    bool intersects(const AABB& box) const {
+        Vector3f c = box.center();
+        Vector3f e = box.extents();
+        for (const Plane& plane : planes) {
+            const Vector3f& n = plane.normal;
+            float r = std::fabs(n.x) * e.x + std::fabs(n.y) * e.y + std::fabs(n.z) * e.z;
+            if (plane.distance(c) < -r) return false;
+        }
+        return true;
+    }
+
+    // 平面系数 (nx, ny, nz, d), 供批量内核使用
+    void coefficients(float (&out)[6][4]) const {
+        for (size_t p = 0; p < 6; ++p) {
+            out[p][0] = planes[p].normal.x;
+            out[p][1] = planes[p].normal.y;
+            out[p][2] = planes[p].normal.z;
+            out[p][3] = planes[p].d;
+        }
+    }
+};
+
+/******************************
+ *         批量视锥剔除         *
+ ******************************/
+
+/**
+ * @brief 批量剔除包围盒 (SoA 中心与半长), 一次测试 4/8/16 个包围盒
+ *
+ * 可见包围盒的下标按原顺序写入 visible, 返回可见数量.
+ * 按运行时检测的 CPU 档位分派; visible 的容量会被复用, 每帧调用不会重复分配.
+ * @throws std::invalid_argument 当 centers 与 extents 大小不一致时
+ */
+inline size_t cull(const Frustum& frustum, const Vec3Batch& centers, const Vec3Batch& extents,
+                   std::vector<uint32_t>& visible) {
+    detail::check_batch_size(centers, extents);
+    float planes[6][4];
+    frustum.coefficients(planes);
+    const float* pc[3];
+    const float* pe[3];
+    detail::component_pointers(centers, pc);
+    detail::component_pointers(extents, pe);
+    visible.resize(centers.size());
+    visible.resize(simd::kernels().cull_aabb(planes, pc, pe, visible.data(), centers.size()));
+    return visible.size();
+}
+
+/**
+ * @brief 批量剔除包围球 (SoA 球心与半径)
+ * @throws std::invalid_argument 当 centers 与 radii 大小不一致时
+ */
+inline size_t cull(const Frustum& frustum, const Vec3Batch& centers, Span<const float> radii,
+                   std::vector<uint32_t>& visible) {
+    if (centers.size() != radii.size()) {
+        throw std::invalid_argument("VectorBatch sizes do not match");
+    }
+    float planes[6][4];
+    frustum.coefficients(planes);
+    const float* pc[3];
+    detail::component_pointers(centers, pc);
+    visible.resize(centers.size());
+    visible.resize(simd::kernels().cull_sphere(planes, pc, radii.data(), visible.data(), centers.size()));
+    return visible.size();
+}
+
+} // namespace GameMath
@@ -0,0 +1,500 @@
+/******************************
+ *        缓动与样条插值          *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Batch.hpp"
+#include "FastMath.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace GameMath {
+
+/******************************
+ *           缓动函数           *
+ ******************************/
+
+/**
+ * @brief 缓动曲线种类, 输入 t 会被截断到 [0, 1]
+ *
+ * 正弦与指数曲线使用 fast::cos / fast::exp (Accuracy::High).
+ */
+enum class Ease {
+    Linear,
+    InQuad, OutQuad, InOutQuad,
+    InCubic, OutCubic, InOutCubic,
+    InSine, OutSine, InOutSine,
+    InExpo, OutExpo,
+    InBack, OutBack,   // 越过端点后回弹 (c1 = 1.70158)
+    SmoothStep         // 3t^2 - 2t^3
+};
+
+namespace detail {
+    // 将运行时缓动种类转为编译期参数
+    template<typename F>
+    void with_ease(Ease ease, F&& f) {
+        switch (ease) {
+            case Ease::Linear: return f(std::integral_constant<Ease, Ease::Linear>{});
+            case Ease::InQuad: return f(std::integral_constant<Ease, Ease::InQuad>{});
+            case Ease::OutQuad: return f(std::integral_constant<Ease, Ease::OutQuad>{});
+            case Ease::InOutQuad: return f(std::integral_constant<Ease, Ease::InOutQuad>{});
+            case Ease::InCubic: return f(std::integral_constant<Ease, Ease::InCubic>{});
+            case Ease::OutCubic: return f(std::integral_constant<Ease, Ease::OutCubic>{});
+            case Ease::InOutCubic: return f(std::integral_constant<Ease, Ease::InOutCubic>{});
+            case Ease::InSine: return f(std::integral_constant<Ease, Ease::InSine>{});
+            case Ease::OutSine: return f(std::integral_constant<Ease, Ease::OutSine>{});
+            case Ease::InOutSine: return f(std::integral_constant<Ease, Ease::InOutSine>{});
+            case Ease::InExpo: return f(std::integral_constant<Ease, Ease::InExpo>{});
+            case Ease::OutExpo: return f(std::integral_constant<Ease, Ease::OutExpo>{});
+            case Ease::InBack: return f(std::integral_constant<Ease, Ease::InBack>{});
+            case Ease::OutBack: return f(std::integral_constant<Ease, Ease::OutBack>{});
+            case Ease::SmoothStep: return f(std::integral_constant<Ease, Ease::SmoothStep>{});
+        }
+        throw std::invalid_argument("Unknown easing curve");
+    }
+
+    template<typename P, Ease E>
+    typename P::reg ease_eval(typename P::reg t) {
+        constexpr float kBack = 1.70158f;
+        constexpr float kLn2 = 0.693147180559945f;
+        auto zero = P::zero();
+        auto one = P::set1(1.0f);
+        t = P::min(P::max(t, zero), one);
+        if constexpr (E == Ease::Linear) {
+            return t;
+        } else if constexpr (E == Ease::InQuad) {
+            return P::mul(t, t);
+        } else if constexpr (E == Ease::OutQuad) {
+            auto u = P::sub(one, t);
+            return P::sub(one, P::mul(u, u));
+        } else if constexpr (E == Ease::InOutQuad) {
+            // t < 0.5 ? 2t^2 : 1 - (2 - 2t)^2 / 2
+            auto u = P::fmadd(P::set1(-2.0f), t, P::set1(2.0f));
+            auto lo = P::mul(P::set1(2.0f), P::mul(t, t));
+            auto hi = P::fmadd(P::set1(-0.5f), P::mul(u, u), one);
+            return P::select_gt(P::set1(0.5f), t, lo, hi);
+        } else if constexpr (E == Ease::InCubic) {
+            return P::mul(P::mul(t, t), t);
+        } else if constexpr (E == Ease::OutCubic) {
+            auto u = P::sub(one, t);
+            return P::sub(one, P::mul(P::mul(u, u), u));
+        } else if constexpr (E == Ease::InOutCubic) {
+            auto u = P::fmadd(P::set1(-2.0f), t, P::set1(2.0f));
+            auto lo = P::mul(P::set1(4.0f), P::mul(P::mul(t, t), t));
+            auto hi = P::fmadd(P::set1(-0.5f), P::mul(P::mul(u, u), u), one);
+            return P::select_gt(P::set1(0.5f), t, lo, hi);
+        } else if constexpr (E == Ease::InSine) {
+            return P::sub(one, fast_cos<Accuracy::High, P>(P::mul(t, P::set1(PI * 0.5f))));
+        } else if constexpr (E == Ease::OutSine) {
+            return fast_sin<Accuracy::High, P>(P::mul(t, P::set1(PI * 0.5f)));
+        } else if constexpr (E == Ease::InOutSine) {
+            auto c = fast_cos<Accuracy::High, P>(P::mul(t, P::set1(PI)));
+            return P::mul(P::sub(one, c), P::set1(0.5f));
+        } else if constexpr (E == Ease::InExpo) {
+            // 2^(10t - 10), t = 0 时为 0
+            auto e = fast_exp<Accuracy::High, P>(P::mul(P::fmadd(P::set1(10.0f), t, P::set1(-10.0f)), P::set1(kLn2)));
+            return P::select_gt(t, zero, e, zero);
+        } else if constexpr (E == Ease::OutExpo) {
+            // 1 - 2^(-10t), t = 1 时为 1
+            auto e = fast_exp<Accuracy::High, P>(P::mul(t, P::set1(-10.0f * kLn2)));
+            return P::select_gt(one, t, P::sub(one, e), one);
+        } else if constexpr (E == Ease::InBack) {
+            // t^2 * ((c1 + 1) t - c1)
+            return P::mul(P::mul(t, t), P::fmadd(P::set1(kBack + 1.0f), t, P::set1(-kBack)));
+        } else if constexpr (E == Ease::OutBack) {
+            // 1 + u^2 * ((c1 + 1) u + c1), u = t - 1
+            auto u = P::sub(t, one);
+            return P::fmadd(P::mul(u, u), P::fmadd(P::set1(kBack + 1.0f), u, P::set1(kBack)), one);
+        } else {
+            return P::mul(P::mul(t, t), P::fmadd(P::set1(-2.0f), t, P::set1(3.0f)));
+        }
+    }
+
+    // out = from + (to - from) * ease(t); from 为空时 out = ease(t)
+    template<typename P, Ease E>
+    size_t ease_array(const float* from, const float* to, const float* t, float* out, size_t i, size_t count) {
+        for (; i + P::width <= count; i += P::width) {
+            auto e = ease_eval<P, E>(P::load(t + i));
+            if (from) {
+                auto a = P::load(from + i);
+                e = P::fmadd(P::sub(P::load(to + i), a), e, a);
+            }
+            P::store(out + i, e);
+        }
+        return i;
+    }
+
+    inline void ease_run(Ease ease, const float* from, const float* to, const float* t, float* out, size_t count) {
+        using P = simd::native_t<float>;
+        with_ease(ease, [&](auto tag) {
+            size_t i = ease_array<P, tag.value>(from, to, t, out, 0, count);
+            ease_array<simd::scalar<float>, tag.value>(from, to, t, out, i, count);
+        });
+    }
+}
+
+/**
+ * @brief 单个缓动值
+ */
+inline float ease(Ease curve, float t) {
+    float result = 0.0f;
+    detail::with_ease(curve, [&](auto tag) {
+        result = detail::ease_eval<simd::scalar<float>, tag.value>(t);
+    });
+    return result;
+}
+
+/**
+ * @brief 批量缓动 out[i] = ease(t[i]) (SIMD), out 可以与 t 相同
+ * @throws std::invalid_argument 当数组大小不一致时
+ */
+inline void ease(Ease curve, Span<const float> t, Span<float> out) {
+    detail::check_span_size(t.size(), out.size());
+    detail::ease_run(curve, nullptr, nullptr, t.data(), out.data(), t.size());
+}
+
+/**
+ * @brief 批量补间 out[i] = from[i] + (to[i] - from[i]) * ease(t[i]) (SIMD)
+ * @throws std::invalid_argument 当数组大小不一致时
+ */
+inline void tween(Ease curve, Span<const float> from, Span<const float> to, Span<const float> t, Span<float> out) {
+    detail::check_span_size(from.size(), to.size());
+    detail::check_span_size(from.size(), t.size());
+    detail::check_span_size(from.size(), out.size());
+    detail::ease_run(curve, from.data(), to.data(), t.data(), out.data(), t.size());
+}
+
+/******************************
+ *           三次样条           *
+ ******************************/
+
+namespace detail {
+    // 样条值类型的分量访问: float 与 Vector<float, N>
+    template<typename T>
+    struct spline_traits;
+
+    template<>
+    struct spline_traits<float> {
+        static constexpr size_t N = 1;
+        static float get(const float& v, size_t) { return v; }
+        static void set(float& v, size_t, float x) { v = x; }
+    };
+
+    template<size_t Dim>
+    struct spline_traits<Vector<float, Dim>> {
+        static_assert(Dim >= 2 && Dim <= 4, "Spline supports 2 to 4 components");
+        static constexpr size_t N = Dim;
+        static float get(const Vector<float, Dim>& v, size_t c) { return v.data[c]; }
+        static void set(Vector<float, Dim>& v, size_t c, float x) { v.data[c] = x; }
+    };
+
+    // 均匀关键帧的批量求值: 每个通道独立定位段号, 按段号 gather 系数后用 Horner 法求值.
+    // coef 按 [段][分量][a, b, c, d] 存放, 每段占 1 << Shift 个 float.
+    template<typename P, size_t N, unsigned Shift>
+    size_t spline_eval(const float* coef, float start, float invStep, size_t segments,
+                       const float* t, float* const* out, size_t i, size_t count) {
+        auto vstart = P::set1(start);
+        auto vinv = P::set1(invStep);
+        auto zero = P::zero();
+        auto vsegs = P::set1(float(segments));
+        auto vlast = P::set1(float(segments - 1));
+        for (; i + P::width <= count; i += P::width) {
+            auto x = P::mul(P::sub(P::load(t + i), vstart), vinv);
+            // 用比较选择截断下界: NaN 的比较为假, 在所有打包类型上都取 0, 不会产生越界的段号
+            x = P::min(P::select_gt(x, zero, x, zero), vsegs);
+            auto seg = P::trunc_int(P::min(x, vlast));
+            auto u = P::sub(x, P::to_float(seg));
+            auto base = P::ishl(seg, Shift);
+            for (size_t c = 0; c < N; ++c) {
+                auto idx = P::iadd(base, P::iset1(uint32_t(c * 4)));
+                auto v = P::fmadd(P::gather(coef + 3, idx), u, P::gather(coef + 2, idx));
+                v = P::fmadd(v, u, P::gather(coef + 1, idx));
+                P::store(out[c] + i, P::fmadd(v, u, P::gather(coef, idx)));
+            }
+        }
+        return i;
+    }
+}
+
+/**
+ * @brief 预计算系数的分段三次样条, 值类型为 float 或 Vector2f/Vector3f/Vector4f
+ *
+ * 构造时把 Catmull-Rom / Hermite / Bezier 控制点一次性转换为每段的多项式系数
+ * a + b u + c u^2 + d u^3 (u 为段内参数, [0, 1]), 求值只需定位段并做 Horner 计算.
+ * 关键帧时间均匀时按 (t - start) / step 直接定位 (O(1)), 批量求值使用 SIMD;
+ * 非均匀时二分查找 (O(log n)), 批量求值逐个进行.
+ * t 超出时间范围时截断到端点.
+ */
+template<typename T>
+class Spline {
+    using Traits = detail::spline_traits<T>;
+
+public:
+    static constexpr size_t kComponents = Traits::N;
+
+    Spline() = default;
+
+    /**
+     * @brief 经过所有点的 Catmull-Rom 样条, 第 i 个点的时间为 start + i * step
+     *
+     * 切线取相邻两点的中心差分, 端点取单侧差分.
+     * @throws std::invalid_argument 当点数少于 2 或 step 不为正时
+     */
+    static Spline catmull_rom(Span<const T> points, float start = 0.0f, float step = 1.0f) {
+        Spline s;
+        s.set_uniform(points.size(), start, step);
+        s.build_hermite(points, s.catmull_rom_tangents(points));
+        return s;
+    }
+
+    /**
+     * @brief 非均匀时间的 Catmull-Rom 样条
+     * @throws std::invalid_argument 当点数少于 2、大小不一致或时间不严格递增时
+     */
+    static Spline catmull_rom(Span<const T> points, Span<const float> times) {
+        Spline s;
+        s.set_times(points.size(), times);
+        s.build_hermite(points, s.catmull_rom_tangents(points));
+        return s;
+    }
+
+    /**
+     * @brief Hermite 样条, tangents 为各点对时间的导数
+     * @throws std::invalid_argument 当点数少于 2、点与切线数量不一致或 step 不为正时
+     */
+    static Spline hermite(Span<const T> points, Span<const T> tangents, float start = 0.0f, float step = 1.0f) {
+        Spline s;
+        s.set_uniform(points.size(), start, step);
+        s.build_hermite(points, flatten(points.size(), tangents));
+        return s;
+    }
+
+    static Spline hermite(Span<const T> points, Span<const T> tangents, Span<const float> times) {
+        Spline s;
+        s.set_times(points.size(), times);
+        s.build_hermite(points, flatten(points.size(), tangents));
+        return s;
+    }
+
+    /**
+     * @brief 分段三次 Bezier, 控制点为 P0 P1 P2 P3 P4 P5 P6 ... (相邻段共用端点)
+     *
+     * 第 k 段使用 controls[3k .. 3k+3], 时间为 [start + k * step, start + (k + 1) * step].
+     * @throws std::invalid_argument 当控制点数不是 3k + 1 (k >= 1) 或 step 不为正时
+     */
+    static Spline bezier(Span<const T> controls, float start = 0.0f, float step = 1.0f) {
+        if (controls.size() < 4 || (controls.size() - 1) % 3 != 0) {
+            throw std::invalid_argument("Bezier spline requires 3k + 1 control points");
+        }
+        Spline s;
+        s.set_uniform((controls.size() - 1) / 3 + 1, start, step);
+        for (size_t seg = 0; seg < s.m_segments; ++seg) {
+            for (size_t c = 0; c < kComponents; ++c) {
+                float p0 = Traits::get(controls[3 * seg], c);
+                float p1 = Traits::get(controls[3 * seg + 1], c);
+                float p2 = Traits::get(controls[3 * seg + 2], c);
+                float p3 = Traits::get(controls[3 * seg + 3], c);
+                s.set_coefficients(seg, c, p0, 3.0f * (p1 - p0), 3.0f * (p0 - 2.0f * p1 + p2),
+                                   p3 - p0 + 3.0f * (p1 - p2));
+            }
+        }
+        return s;
+    }
+
+    // 段数与时间范围
+    size_t segment_count() const { return m_segments; }
+    bool empty() const { return m_segments == 0; }
+    bool uniform() const { return m_times.empty(); }
+    float start_time() const { return m_start; }
+    float end_time() const { return uniform() ? m_start + m_step * float(m_segments) : m_times.back(); }
+
+    /**
+     * @brief t 时刻的值
+     * @throws std::runtime_error 当样条为空时
+     */
+    T evaluate(float t) const {
+        float u;
+        const float* k = segment(t, u);
+        T result{};
+        for (size_t c = 0; c < kComponents; ++c, k += 4) {
+            Traits::set(result, c, ((k[3] * u + k[2]) * u + k[1]) * u + k[0]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief t 时刻对时间的导数 (速度)
+     */
+    T derivative(float t) const {
+        float u, dudt;
+        const float* k = segment(t, u, &dudt);
+        T result{};
+        for (size_t c = 0; c < kComponents; ++c, k += 4) {
+            Traits::set(result, c, ((3.0f * k[3] * u + 2.0f * k[2]) * u + k[1]) * dudt);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 批量求值 out[i] = evaluate(t[i]) (均匀关键帧时使用 SIMD)
+     * @throws std::invalid_argument 当数组大小不一致时
+     */
+    void evaluate(Span<const float> t, Span<T> out) const {
+        detail::check_span_size(t.size(), out.size());
+        require_segments();
+        if (!uniform()) {
+            for (size_t i = 0; i < t.size(); ++i) out[i] = evaluate(t[i]);
+            return;
+        }
+        constexpr size_t kChunk = 256;
+        alignas(64) float buffer[kComponents][kChunk];
+        float* po[kComponents];
+        for (size_t c = 0; c < kComponents; ++c) po[c] = buffer[c];
+        for (size_t first = 0; first < t.size(); first += kChunk) {
+            size_t n = std::min(kChunk, t.size() - first);
+            evaluate_uniform(t.data() + first, po, n);
+            for (size_t i = 0; i < n; ++i) {
+                T& v = out[first + i];
+                for (size_t c = 0; c < kComponents; ++c) Traits::set(v, c, buffer[c][i]);
+            }
+        }
+    }
+
+    /**
+     * @brief 批量求值到 SoA 容器, 均匀关键帧时直接按分量写出
+     */
+    void evaluate(Span<const float> t, VectorBatch<float, kComponents>& out) const {
+        require_segments();
+        out.resize(t.size());
+        float* po[kComponents];
+        for (size_t c = 0; c < kComponents; ++c) po[c] = out.component(c);
+        if (uniform()) {
+            evaluate_uniform(t.data(), po, t.size());
+            return;
+        }
+        for (size_t i = 0; i < t.size(); ++i) {
+            T v = evaluate(t[i]);
+            for (size_t c = 0; c < kComponents; ++c) po[c][i] = Traits::get(v, c);
+        }
+    }
+
+private:
+    // 每段系数占 2 的幂个 float, 便于批量求值时以移位计算 gather 下标
+    static constexpr unsigned kStrideShift = kComponents == 1 ? 2 : (kComponents == 2 ? 3 : 4);
+    static constexpr size_t kStride = size_t(1) << kStrideShift;
+
+    std::vector<float> m_coef;   // [段][分量][a, b, c, d]
+    std::vector<float> m_times;  // 非均匀关键帧时间, 均匀时为空
+    size_t m_segments = 0;
+    float m_start = 0.0f;
+    float m_step = 1.0f;
+    float m_invStep = 1.0f;
+
+    void set_uniform(size_t keys, float start, float step) {
+        if (keys < 2) throw std::invalid_argument("Spline requires at least 2 keys");
+        if (!(step > 0.0f)) throw std::invalid_argument("Spline step must be positive");
+        m_segments = keys - 1;
+        m_start = start;
+        m_step = step;
+        m_invStep = 1.0f / step;
+        m_coef.assign(m_segments * kStride, 0.0f);
+    }
+
+    void set_times(size_t keys, Span<const float> times) {
+        if (keys != times.size()) throw std::invalid_argument("Spline key and time counts do not match");
+        if (keys < 2) throw std::invalid_argument("Spline requires at least 2 keys");
+        set_uniform(keys, times[0], 1.0f);
+        for (size_t i = 1; i < times.size(); ++i) {
+            if (!(times[i] > times[i - 1])) throw std::invalid_argument("Spline times must be strictly increasing");
+        }
+        m_times.assign(times.begin(), times.end());
+    }
+
+    float key_time(size_t i) const { return uniform() ? m_start + m_step * float(i) : m_times[i]; }
+
+    static std::vector<float> flatten(size_t keys, Span<const T> values) {
+        if (values.size() != keys) throw std::invalid_argument("Spline point and tangent counts do not match");
+        std::vector<float> flat(keys * kComponents);
+        for (size_t i = 0; i < keys; ++i) {
+            for (size_t c = 0; c < kComponents; ++c) flat[i * kComponents + c] = Traits::get(values[i], c);
+        }
+        return flat;
+    }
+
+    // 各点对时间的导数: 中心差分, 端点单侧差分
+    std::vector<float> catmull_rom_tangents(Span<const T> points) const {
+        size_t keys = points.size();
+        std::vector<float> tangents(keys * kComponents);
+        for (size_t i = 0; i < keys; ++i) {
+            size_t lo = i == 0 ? 0 : i - 1;
+            size_t hi = i + 1 == keys ? i : i + 1;
+            float inv = 1.0f / (key_time(hi) - key_time(lo));
+            for (size_t c = 0; c < kComponents; ++c) {
+                tangents[i * kComponents + c] = (Traits::get(points[hi], c) - Traits::get(points[lo], c)) * inv;
+            }
+        }
+        return tangents;
+    }
+
+    // 由端点值与对时间的导数计算每段系数 (导数按段长换算到 u 上)
+    void build_hermite(Span<const T> points, const std::vector<float>& tangents) {
+        for (size_t seg = 0; seg < m_segments; ++seg) {
+            float h = key_time(seg + 1) - key_time(seg);
+            for (size_t c = 0; c < kComponents; ++c) {
+                float p0 = Traits::get(points[seg], c);
+                float p1 = Traits::get(points[seg + 1], c);
+                float m0 = tangents[seg * kComponents + c] * h;
+                float m1 = tangents[(seg + 1) * kComponents + c] * h;
+                set_coefficients(seg, c, p0, m0, 3.0f * (p1 - p0) - 2.0f * m0 - m1, 2.0f * (p0 - p1) + m0 + m1);
+            }
+        }
+    }
+
+    void set_coefficients(size_t seg, size_t c, float a, float b, float cc, float d) {
+        float* k = &m_coef[seg * kStride + c * 4];
+        k[0] = a;
+        k[1] = b;
+        k[2] = cc;
+        k[3] = d;
+    }
+
+    void require_segments() const {
+        if (m_segments == 0) throw std::runtime_error("Spline is empty");
+    }
+
+    // 定位 t 所在段, 返回该段系数并写出段内参数 u (以及 du/dt)
+    const float* segment(float t, float& u, float* dudt = nullptr) const {
+        require_segments();
+        size_t seg;
+        if (uniform()) {
+            // std::max(0, NaN) 为 0: NaN 的 t 定位到第一段
+            float x = std::min(std::max(0.0f, (t - m_start) * m_invStep), float(m_segments));
+            seg = std::min(static_cast<size_t>(x), m_segments - 1);
+            u = x - float(seg);
+            if (dudt) *dudt = m_invStep;
+        } else {
+            auto it = std::upper_bound(m_times.begin() + 1, m_times.end() - 1, t);
+            seg = static_cast<size_t>(it - (m_times.begin() + 1));
+            float t0 = m_times[seg];
+            float inv = 1.0f / (m_times[seg + 1] - t0);
+            u = std::min(std::max(0.0f, (t - t0) * inv), 1.0f);
+            if (dudt) *dudt = inv;
+        }
+        return &m_coef[seg * kStride];
+    }
+
+    void evaluate_uniform(const float* t, float* const* out, size_t count) const {
+        using P = simd::native_t<float>;
+        size_t i = detail::spline_eval<P, kComponents, kStrideShift>(m_coef.data(), m_start, m_invStep, m_segments,
+                                                                     t, out, 0, count);
+        detail::spline_eval<simd::scalar<float>, kComponents, kStrideShift>(m_coef.data(), m_start, m_invStep,
+                                                                            m_segments, t, out, i, count);
+    }
+};
+
+} // namespace GameMath
@@ -1,8 +1,263 @@
 #pragma once
 #include "Vector.hpp"
+#include <type_traits>
+#include <utility>
 
 namespace GameMath {
 
+#if defined(GM_SIMD_SSE)
+namespace detail {
+    // 4x4矩阵乘法: out = a * b (按行存储, out 不得与 a/b 重叠)
+    inline void mat4_mul(const Vector4f* a, const Vector4f* b, Vector4f* out) {
+#if defined(GM_SIMD_AVX)
+        // 一次处理两行: [a0 | a1] 与 [b_k | b_k] 的广播乘加
+        __m256 b0 = _mm256_broadcast_ps(&b[0].simd);
+        __m256 b1 = _mm256_broadcast_ps(&b[1].simd);
+        __m256 b2 = _mm256_broadcast_ps(&b[2].simd);
+        __m256 b3 = _mm256_broadcast_ps(&b[3].simd);
+        for (size_t i = 0; i < 4; i += 2) {
+            __m256 ai = _mm256_set_m128(a[i + 1].simd, a[i].simd);
+            __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(ai, ai, 0x00), b0);
+#if defined(GM_SIMD_FMA)
+            r = _mm256_fmadd_ps(_mm256_shuffle_ps(ai, ai, 0x55), b1, r);
+            r = _mm256_fmadd_ps(_mm256_shuffle_ps(ai, ai, 0xAA), b2, r);
+            r = _mm256_fmadd_ps(_mm256_shuffle_ps(ai, ai, 0xFF), b3, r);
+#else
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(ai, ai, 0x55), b1));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(ai, ai, 0xAA), b2));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(ai, ai, 0xFF), b3));
+#endif
+            out[i].simd = _mm256_castps256_ps128(r);
+            out[i + 1].simd = _mm256_extractf128_ps(r, 1);
+        }
+#else
+        for (size_t i = 0; i < 4; ++i) {
+            __m128 ai = a[i].simd;
+            __m128 r = _mm_mul_ps(_mm_shuffle_ps(ai, ai, 0x00), b[0].simd);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, 0x55), b[1].simd));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, 0xAA), b[2].simd));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, 0xFF), b[3].simd));
+            out[i].simd = r;
+        }
+#endif
+    }
+
+    // 一行乘以按行存储的 4 列矩阵: a0 * b0 + a1 * b1 + a2 * b2 + a3 * b3
+    inline __m128 mat4_row_mul(__m128 a, const Vector4f* b) {
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, 0x00), b[0].simd);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, 0x55), b[1].simd));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, 0xAA), b[2].simd));
+        return _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, 0xFF), b[3].simd));
+    }
+
+    // 3x4 乘 4x4: out = a * b (out 不得与 a/b 重叠)
+    inline void mat34_mul(const Vector4f* a, const Vector4f* b, Vector4f* out) {
+        out[0].simd = mat4_row_mul(a[0].simd, b);
+        out[1].simd = mat4_row_mul(a[1].simd, b);
+        out[2].simd = mat4_row_mul(a[2].simd, b);
+    }
+
+    /**
+     * @brief 仿射 3x4 相乘: 两者都视为最后一行为 (0, 0, 0, 1) 的 4x4 矩阵
+     *
+     * out_i = a_i0 * b0 + a_i1 * b1 + a_i2 * b2 + (0, 0, 0, a_i3), out 不得与 a/b 重叠
+     */
+    inline void mat34_mul_affine(const Vector4f* a, const Vector4f* b, Vector4f* out) {
+        const __m128 wMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+        for (size_t i = 0; i < 3; ++i) {
+            __m128 ai = a[i].simd;
+            __m128 r = _mm_and_ps(ai, wMask);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, 0x00), b[0].simd));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, 0x55), b[1].simd));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(ai, ai, 0xAA), b[2].simd));
+            out[i].simd = r;
+        }
+    }
+
+    // 读取 3 个连续 float 到低 3 个通道 (不越界读取)
+    inline __m128 load3_ps(const float* p) {
+        return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p))), _mm_load_ss(p + 2));
+    }
+
+    // 3x3 矩阵乘法 (Vector3f 紧密排列为 9 个 float): out = a * b, out 不得与 a/b 重叠
+    inline void mat3_mul(const Vector3f* a, const Vector3f* b, Vector3f* out) {
+        const float* pa = a[0].data;
+        const float* pb = b[0].data;
+        // b 的前两行可整行读取 (第 4 个通道落在下一行内), 第三行按 3 个元素读取
+        __m128 b0 = _mm_loadu_ps(pb);
+        __m128 b1 = _mm_loadu_ps(pb + 3);
+        __m128 b2 = load3_ps(pb + 6);
+        __m128 r[3];
+        for (size_t i = 0; i < 3; ++i) {
+            r[i] = _mm_mul_ps(_mm_set1_ps(pa[i * 3]), b0);
+            r[i] = _mm_add_ps(r[i], _mm_mul_ps(_mm_set1_ps(pa[i * 3 + 1]), b1));
+            r[i] = _mm_add_ps(r[i], _mm_mul_ps(_mm_set1_ps(pa[i * 3 + 2]), b2));
+        }
+        // 拼成 16 + 16 + 4 字节三次写入, 之后按整块读取时可以直接转发
+        float* po = out[0].data;
+        __m128 z0x1 = _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(0, 0, 2, 2));
+        _mm_storeu_ps(po, _mm_shuffle_ps(r[0], z0x1, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(po + 4, _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 0, 2, 1)));
+        _mm_store_ss(po + 8, _mm_movehl_ps(r[2], r[2]));
+    }
+
+    // 4x4矩阵乘向量: 四行分别相乘后转置求和, 得到四个点积
+    inline __m128 mat4_mul_vec(const Vector4f* m, __m128 v) {
+        __m128 p0 = _mm_mul_ps(m[0].simd, v);
+        __m128 p1 = _mm_mul_ps(m[1].simd, v);
+        __m128 p2 = _mm_mul_ps(m[2].simd, v);
+        __m128 p3 = _mm_mul_ps(m[3].simd, v);
+        _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+        return _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3));
+    }
+
+    // 4x4矩阵转置 (基于shuffle)
+    inline void mat4_transpose(const Vector4f* m, Vector4f* out) {
+        __m128 r0 = m[0].simd, r1 = m[1].simd, r2 = m[2].simd, r3 = m[3].simd;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        out[0].simd = r0;
+        out[1].simd = r1;
+        out[2].simd = r2;
+        out[3].simd = r3;
+    }
+
+    // 2x2 矩阵按行打包于一个 __m128: (m00, m01, m10, m11)
+    // a * b
+    inline __m128 mat2_mul(__m128 a, __m128 b) {
+        return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)),
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    // adj(a) * b
+    inline __m128 mat2_adj_mul(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)),
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    // a * adj(b)
+    inline __m128 mat2_mul_adj(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)),
+                                     _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    /**
+     * @brief 4x4矩阵求逆 (分块 Cramer 法则)
+     *
+     * 将 M 分为四个 2x2 子块 A B / C D, 以子块的伴随矩阵与行列式求出逆矩阵,
+     * 全程只用 shuffle 与乘加, 没有分支.
+     * @return M 的行列式; 为 0 时 out 的内容无意义
+     */
+    inline float mat4_inverse(const Vector4f* m, Vector4f* out) {
+        __m128 r0 = m[0].simd, r1 = m[1].simd, r2 = m[2].simd, r3 = m[3].simd;
+        __m128 a = _mm_movelh_ps(r0, r1);
+        __m128 b = _mm_movehl_ps(r1, r0);
+        __m128 c = _mm_movelh_ps(r2, r3);
+        __m128 d = _mm_movehl_ps(r3, r2);
+
+        // (|A|, |B|, |C|, |D|)
+        __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+        __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m128 dc = mat2_adj_mul(d, c);
+        __m128 ab = mat2_adj_mul(a, b);
+        // 逆矩阵各子块的伴随: X = |D|A - B(D#C), W = |A|D - C(A#B)
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2_mul(b, dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2_mul(c, ab));
+        // Y = |B|C - D(A#B)#, Z = |C|B - A(D#C)#
+        __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2_mul_adj(d, ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2_mul_adj(a, dc));
+
+        // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        float tr = hsum_ps(_mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0))));
+        float det = _mm_cvtss_f32(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC))) - tr;
+
+        __m128 rcp = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), _mm_set1_ps(det));
+        x = _mm_mul_ps(x, rcp);
+        y = _mm_mul_ps(y, rcp);
+        z = _mm_mul_ps(z, rcp);
+        w = _mm_mul_ps(w, rcp);
+
+        // 伴随变换与按行存储合并为一次 shuffle
+        out[0].simd = _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3));
+        out[1].simd = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2));
+        out[2].simd = _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3));
+        out[3].simd = _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2));
+        return det;
+    }
+
+    // 三维叉积 (w 分量为 0)
+    inline __m128 cross3_ps(__m128 a, __m128 b) {
+        __m128 ayzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 bzxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+        __m128 azxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+        __m128 byzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        return _mm_sub_ps(_mm_mul_ps(ayzx, bzxy), _mm_mul_ps(azxy, byzx));
+    }
+
+    /**
+     * @brief 仿射变换求逆: [L t; 0 1]^-1 = [L^-1 -L^-1 t; 0 1]
+     *
+     * L^-1 的各列为 L 两行的叉积除以行列式, 再与平移一起转置写回.
+     * @return L 的行列式; 为 0 时 out 的内容无意义
+     */
+    inline float mat4_inverse_affine(const Vector4f* m, Vector4f* out) {
+        __m128 r0 = m[0].simd, r1 = m[1].simd, r2 = m[2].simd;
+        __m128 c0 = cross3_ps(r1, r2);
+        __m128 c1 = cross3_ps(r2, r0);
+        __m128 c2 = cross3_ps(r0, r1);
+        float det = hsum_ps(_mm_mul_ps(r0, c0));
+        __m128 rcp = _mm_div_ps(_mm_set1_ps(1.0f), _mm_set1_ps(det));
+        c0 = _mm_mul_ps(c0, rcp);
+        c1 = _mm_mul_ps(c1, rcp);
+        c2 = _mm_mul_ps(c2, rcp);
+        // -L^-1 t = -(t.x * c0 + t.y * c1 + t.z * c2)
+        __m128 t = _mm_mul_ps(c0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3)));
+        t = _mm_add_ps(t, _mm_mul_ps(c1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3))));
+        t = _mm_add_ps(t, _mm_mul_ps(c2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3))));
+        __m128 c3 = _mm_sub_ps(_mm_setzero_ps(), t);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        out[0].simd = c0;
+        out[1].simd = c1;
+        out[2].simd = c2;
+        out[3].simd = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+        return det;
+    }
+
+    // 刚体变换求逆: [R t; 0 1]^-1 = [R^T -R^T t; 0 1]
+    inline void mat4_inverse_orthonormal(const Vector4f* m, Vector4f* out) {
+        __m128 r0 = m[0].simd, r1 = m[1].simd, r2 = m[2].simd;
+        // -R^T t = -(t.x * row0 + t.y * row1 + t.z * row2)
+        __m128 t = _mm_mul_ps(r0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3)));
+        t = _mm_add_ps(t, _mm_mul_ps(r1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3))));
+        t = _mm_add_ps(t, _mm_mul_ps(r2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3))));
+        __m128 r3 = _mm_sub_ps(_mm_setzero_ps(), t);
+        // 转置后前三行即为 (R^T 的行, 平移分量)
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        out[0].simd = r0;
+        out[1].simd = r1;
+        out[2].simd = r2;
+        out[3].simd = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+#endif
+
+namespace detail {
+    // a 与 b[0..Cols) 第 j 列的点积, 编译期展开为 a_0 * b_0j + a_1 * b_1j + ...
+    template<typename T, size_t Cols, size_t OtherCols, size_t... K>
+    constexpr T row_col_dot(const Vector<T, Cols>& a, const Vector<T, OtherCols>* b, size_t j,
+                            std::index_sequence<K...>) noexcept {
+        return (... + (a.unchecked(K) * b[K].unchecked(j)));
+    }
+}
+
 template<typename T, size_t Rows, size_t Cols>
 struct Matrix {
     Vector<T, Cols> rows[Rows];
@@ -10,34 +265,55 @@ struct Matrix {
     // 构造函数
     Matrix() = default;
     
-    explicit Matrix(T scalar) {
+    constexpr explicit Matrix(T scalar) : rows{} {
         for (auto& row : rows) {
             row = Vector<T, Cols>(scalar);
         }
     }
     
-    Matrix(std::initializer_list<Vector<T, Cols>> list) {
-        std::copy(list.begin(), list.end(), rows);
+    constexpr Matrix(std::initializer_list<Vector<T, Cols>> list) : rows{} {
+        for (size_t i = 0; i < list.size(); ++i) {
+            rows[i] = list.begin()[i];
+        }
     }
     
     // 访问操作符
-    Vector<T, Cols>& operator[](size_t row) { return rows[row]; }
-    const Vector<T, Cols>& operator[](size_t row) const { return rows[row]; }
+    constexpr Vector<T, Cols>& operator[](size_t row) noexcept { return rows[row]; }
+    constexpr const Vector<T, Cols>& operator[](size_t row) const noexcept { return rows[row]; }
    
-    // 行列访问操作符 (非常量版本)
-    T& operator()(size_t row, size_t col) {
-        if (row >= Rows || col >= Cols) {
-            throw std::out_of_range("Matrix indices out of range");
+    // 行列访问操作符 (非常量版本, GM_CHECKED 为 0 时不检查下标)
+    constexpr T& operator()(size_t row, size_t col) noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (row >= Rows || col >= Cols) {
+                throw std::out_of_range("Matrix indices out of range");
+            }
         }
-        return rows[row][col];
+        return rows[row].unchecked(col);
     }
     
     // 行列访问操作符 (常量版本)
-    const T& operator()(size_t row, size_t col) const {
+    constexpr const T& operator()(size_t row, size_t col) const noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (row >= Rows || col >= Cols) {
+                throw std::out_of_range("Matrix indices out of range");
+            }
+        }
+        return rows[row].unchecked(col);
+    }
+
+    // 始终检查下标的访问
+    constexpr T& at(size_t row, size_t col) {
+        if (row >= Rows || col >= Cols) {
+            throw std::out_of_range("Matrix indices out of range");
+        }
+        return rows[row].unchecked(col);
+    }
+
+    constexpr const T& at(size_t row, size_t col) const {
         if (row >= Rows || col >= Cols) {
             throw std::out_of_range("Matrix indices out of range");
         }
-        return rows[row][col];
+        return rows[row].unchecked(col);
     }
 
     // 获取行列数
@@ -45,25 +321,25 @@ struct Matrix {
     constexpr size_t numCols() const { return Cols; }
     
     // 获取列向量
-    Vector<T, Rows> col(size_t colIndex) const {
-        Vector<T, Rows> result;
+    constexpr Vector<T, Rows> col(size_t colIndex) const {
+        Vector<T, Rows> result{};
         for (size_t i = 0; i < Rows; ++i) {
-            result[i] = rows[i][colIndex];
+            result.unchecked(i) = rows[i].unchecked(colIndex);
         }
         return result;
     }
     
     // 矩阵运算
-    Matrix operator+(const Matrix& rhs) const {
-        Matrix result;
+    constexpr Matrix operator+(const Matrix& rhs) const {
+        Matrix result{};
         for (size_t i = 0; i < Rows; ++i) {
             result[i] = rows[i] + rhs[i];
         }
         return result;
     }
     
-    Matrix operator-(const Matrix& rhs) const {
-        Matrix result;
+    constexpr Matrix operator-(const Matrix& rhs) const {
+        Matrix result{};
         for (size_t i = 0; i < Rows; ++i) {
             result[i] = rows[i] - rhs[i];
         }
@@ -71,19 +347,65 @@ struct Matrix {
     }
     
     template<size_t OtherCols>
-    Matrix<T, Rows, OtherCols> operator*(const Matrix<T, Cols, OtherCols>& rhs) const {
-        Matrix<T, Rows, OtherCols> result;
+    constexpr Matrix<T, Rows, OtherCols> operator*(const Matrix<T, Cols, OtherCols>& rhs) const {
+        Matrix<T, Rows, OtherCols> result{};
+#if defined(GM_SIMD_SSE)
+        if constexpr (std::is_same_v<T, float> && Rows == 4 && Cols == 4 && OtherCols == 4) {
+            if (!detail::is_constant_evaluated()) {
+                detail::mat4_mul(rows, rhs.rows, result.rows);
+                return result;
+            }
+        }
+        if constexpr (std::is_same_v<T, float> && Rows == 3 && Cols == 4 && OtherCols == 4) {
+            if (!detail::is_constant_evaluated()) {
+                detail::mat34_mul(rows, rhs.rows, result.rows);
+                return result;
+            }
+        }
+        if constexpr (std::is_same_v<T, float> && Rows == 3 && Cols == 3 && OtherCols == 3) {
+            if (!detail::is_constant_evaluated()) {
+                static_assert(sizeof(Matrix) == 9 * sizeof(float), "3x3 matrix must be 9 packed floats");
+                detail::mat3_mul(rows, rhs.rows, result.rows);
+                return result;
+            }
+        }
+        if constexpr (std::is_same_v<T, float> && Rows == 2 && Cols == 2 && OtherCols == 2) {
+            if (!detail::is_constant_evaluated()) {
+                static_assert(sizeof(Matrix) == 4 * sizeof(float), "2x2 matrix must be 4 packed floats");
+                _mm_storeu_ps(result.rows[0].data,
+                              detail::mat2_mul(_mm_loadu_ps(rows[0].data), _mm_loadu_ps(rhs.rows[0].data)));
+                return result;
+            }
+        }
+#endif
+        // 通用路径: 直接按下标展开点积, 不构造列向量
         for (size_t i = 0; i < Rows; ++i) {
             for (size_t j = 0; j < OtherCols; ++j) {
-                result[i][j] = rows[i].dot(rhs.col(j));
+                result.rows[i].unchecked(j) = detail::row_col_dot(rows[i], rhs.rows, j, std::make_index_sequence<Cols>{});
             }
         }
         return result;
     }
     
+    // 矩阵乘向量
+    constexpr Vector<T, Rows> operator*(const Vector<T, Cols>& v) const {
+#if defined(GM_SIMD_SSE)
+        if constexpr (std::is_same_v<T, float> && Rows == 4 && Cols == 4) {
+            if (!detail::is_constant_evaluated()) {
+                return Vector<T, Rows>(detail::mat4_mul_vec(rows, v.simd));
+            }
+        }
+#endif
+        Vector<T, Rows> result{};
+        for (size_t i = 0; i < Rows; ++i) {
+            result.unchecked(i) = rows[i].dot(v);
+        }
+        return result;
+    }
+    
     // 标量乘法
-    Matrix operator*(T scalar) const {
-        Matrix result;
+    constexpr Matrix operator*(T scalar) const {
+        Matrix result{};
         for (size_t i = 0; i < Rows; ++i) {
             result[i] = rows[i] * scalar;
         }
@@ -91,8 +413,8 @@ struct Matrix {
     }
     
     // 标量除法
-    Matrix operator/(T scalar) const {
-        Matrix result;
+    constexpr Matrix operator/(T scalar) const {
+        Matrix result{};
         for (size_t i = 0; i < Rows; ++i) {
             result[i] = rows[i] / scalar;
         }
@@ -100,73 +422,181 @@ struct Matrix {
     }
     
     // 转置矩阵
-    Matrix<T, Cols, Rows> transposed() const {
-        Matrix<T, Cols, Rows> result;
+    constexpr Matrix<T, Cols, Rows> transposed() const {
+        Matrix<T, Cols, Rows> result{};
+#if defined(GM_SIMD_SSE)
+        if constexpr (std::is_same_v<T, float> && Rows == 4 && Cols == 4) {
+            if (!detail::is_constant_evaluated()) {
+                detail::mat4_transpose(rows, result.rows);
+                return result;
+            }
+        }
+#endif
         for (size_t i = 0; i < Cols; ++i) {
             for (size_t j = 0; j < Rows; ++j) {
-                result[i][j] = rows[j][i];
+                result.rows[i].unchecked(j) = rows[j].unchecked(i);
             }
         }
         return result;
     }
     
     // 行列式 (仅适用于方阵)
-    T determinant() const {
+    constexpr T determinant() const {
         static_assert(Rows == Cols, "Determinant is only defined for square matrices");
-        // 实现行列式计算 (递归或LU分解等方法)
-        // 这里只是一个占位符实现
+        auto a = [this](size_t r, size_t c) { return rows[r].unchecked(c); };
         if constexpr (Rows == 1) {
-            return rows[0][0];
+            return a(0, 0);
         } else if constexpr (Rows == 2) {
-            return rows[0][0] * rows[1][1] - rows[0][1] * rows[1][0];
+            return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+        } else if constexpr (Rows == 3) {
+            return a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1))
+                 - a(0, 1) * (a(1, 0) * a(2, 2) - a(1, 2) * a(2, 0))
+                 + a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+        } else if constexpr (Rows == 4) {
+            // 按前两行与后两行的 2x2 子式做 Laplace 展开
+            T s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
+            T s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+            T s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3);
+            T s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+            T s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3);
+            T s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+            T c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+            T c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2);
+            T c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+            T c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2);
+            T c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+            T c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3);
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
         } else {
-            // 更高维度的实现
-            T det = 0;
-            for (size_t i = 0; i < Cols; ++i) {
-                // 递归计算余子式
-                // ...
+            // 更高维度: 列主元高斯消元
+            static_assert(std::is_floating_point_v<T>, "Determinant of matrices larger than 4x4 requires a floating point type");
+            Matrix lu = *this;
+            T det = 1;
+            for (size_t k = 0; k < Rows; ++k) {
+                size_t pivot = k;
+                for (size_t i = k + 1; i < Rows; ++i) {
+                    if (std::abs(lu.rows[i].unchecked(k)) > std::abs(lu.rows[pivot].unchecked(k))) pivot = i;
+                }
+                if (lu.rows[pivot].unchecked(k) == 0) return T(0);
+                if (pivot != k) {
+                    std::swap(lu.rows[pivot], lu.rows[k]);
+                    det = -det;
+                }
+                T p = lu.rows[k].unchecked(k);
+                det *= p;
+                for (size_t i = k + 1; i < Rows; ++i) {
+                    T f = lu.rows[i].unchecked(k) / p;
+                    for (size_t j = k; j < Cols; ++j) {
+                        lu.rows[i].unchecked(j) -= f * lu.rows[k].unchecked(j);
+                    }
+                }
             }
             return det;
         }
     }
     
-    // 逆矩阵 (仅适用于方阵)
-    Matrix inverse() const {
-        static_assert(Rows == Cols, "Inverse is only defined for square matrices");
-        // 实现逆矩阵计算 (伴随矩阵法或高斯消元法等)
-        // 这里只是一个占位符实现
-        Matrix result;
-        T det = determinant();
-        if (det == 0) {
+    /**
+     * @brief 逆矩阵 (仅适用于方阵)
+     *
+     * 3x3 使用伴随矩阵闭式解, 4x4 float 使用 SSE 分块 Cramer 法则,
+     * 更高维度使用高斯-约当消元.
+     * @throws std::runtime_error 当矩阵不可逆 (行列式为 0) 时
+     */
+    constexpr Matrix inverse() const {
+        Matrix result{};
+        if (!invert_to(result)) {
             throw std::runtime_error("Matrix is not invertible");
         }
-        
-        if constexpr (Rows == 2) {
-            result[0][0] = rows[1][1] / det;
-            result[0][1] = -rows[0][1] / det;
-            result[1][0] = -rows[1][0] / det;
-            result[1][1] = rows[0][0] / det;
-        } else {
-            // 更高维度的实现
-            // ...
+        return result;
+    }
+
+    // 不抛异常的求逆, 不可逆时返回 std::nullopt
+    std::optional<Matrix> try_inverse() const noexcept {
+        Matrix result;
+        if (!invert_to(result)) return std::nullopt;
+        return result;
+    }
+
+    /**
+     * @brief 仿射变换求逆: [L t; 0 1]^-1 = [L^-1 -L^-1 t; 0 1]
+     *
+     * 只对左上 (N-1)x(N-1) 线性部分求逆, 要求最后一行为 (0, ..., 0, 1).
+     * @throws std::runtime_error 当线性部分不可逆时
+     */
+    constexpr Matrix inverse_affine() const {
+        static_assert(Rows == Cols && Rows >= 2, "Affine inverse requires a square homogeneous matrix");
+#if defined(GM_SIMD_SSE)
+        if constexpr (std::is_same_v<T, float> && Rows == 4) {
+            if (!detail::is_constant_evaluated()) {
+                Matrix result;
+                if (detail::mat4_inverse_affine(rows, result.rows) == 0) {
+                    throw std::runtime_error("Matrix is not invertible");
+                }
+                return result;
+            }
+        }
+#endif
+        constexpr size_t L = Rows - 1;
+        Matrix<T, L, L> linear{};
+        for (size_t i = 0; i < L; ++i) {
+            for (size_t j = 0; j < L; ++j) {
+                linear.rows[i].unchecked(j) = rows[i].unchecked(j);
+            }
+        }
+        Matrix<T, L, L> inv = linear.inverse();
+        Matrix result = identity();
+        for (size_t i = 0; i < L; ++i) {
+            T t = 0;
+            for (size_t j = 0; j < L; ++j) {
+                result.rows[i].unchecked(j) = inv.rows[i].unchecked(j);
+                t += inv.rows[i].unchecked(j) * rows[j].unchecked(L);
+            }
+            result.rows[i].unchecked(L) = -t;
+        }
+        return result;
+    }
+
+    /**
+     * @brief 刚体变换求逆: [R t; 0 1]^-1 = [R^T -R^T t; 0 1]
+     *
+     * 要求线性部分为正交矩阵 (只含旋转), 不做任何检查.
+     */
+    constexpr Matrix inverse_orthonormal() const noexcept {
+        static_assert(Rows == Cols && Rows >= 2, "Orthonormal inverse requires a square homogeneous matrix");
+#if defined(GM_SIMD_SSE)
+        if constexpr (std::is_same_v<T, float> && Rows == 4) {
+            if (!detail::is_constant_evaluated()) {
+                Matrix result;
+                detail::mat4_inverse_orthonormal(rows, result.rows);
+                return result;
+            }
+        }
+#endif
+        constexpr size_t L = Rows - 1;
+        Matrix result = identity();
+        for (size_t i = 0; i < L; ++i) {
+            T t = 0;
+            for (size_t j = 0; j < L; ++j) {
+                result.rows[i].unchecked(j) = rows[j].unchecked(i);
+                t += rows[j].unchecked(i) * rows[j].unchecked(L);
+            }
+            result.rows[i].unchecked(L) = -t;
         }
         return result;
     }
     
     // 静态方法
-    static Matrix identity() {
+    static constexpr Matrix identity() {
         static_assert(Rows == Cols, "Identity matrix must be square");
-        Matrix result;
+        Matrix result{};
         for (size_t i = 0; i < Rows; ++i) {
-            for (size_t j = 0; j < Cols; ++j) {
-                result[i][j] = (i == j) ? T(1) : T(0);
-            }
+            result.rows[i].unchecked(i) = T(1);
         }
         return result;
     }
     
-    static Matrix zero() {
-        Matrix result;
+    static constexpr Matrix zero() {
+        Matrix result{};
         for (auto& row : result.rows) {
             row = Vector<T, Cols>(T(0));
         }
@@ -174,7 +604,7 @@ struct Matrix {
     }
     
     // 比较操作符
-    bool operator==(const Matrix& rhs) const {
+    constexpr bool operator==(const Matrix& rhs) const {
         for (size_t i = 0; i < Rows; ++i) {
             if (rows[i] != rhs[i]) {
                 return false;
@@ -183,25 +613,192 @@ struct Matrix {
         return true;
     }
     
-    bool operator!=(const Matrix& rhs) const {
+    constexpr bool operator!=(const Matrix& rhs) const {
         return !(*this == rhs);
     }
+
+private:
+    // 求逆写入 out, 不可逆时返回 false
+    constexpr bool invert_to(Matrix& out) const noexcept {
+        static_assert(Rows == Cols, "Inverse is only defined for square matrices");
+        auto a = [this](size_t r, size_t c) { return rows[r].unchecked(c); };
+        if constexpr (Rows == 1) {
+            if (a(0, 0) == 0) return false;
+            out.rows[0].unchecked(0) = T(1) / a(0, 0);
+        } else if constexpr (Rows == 2) {
+            T det = determinant();
+            if (det == 0) return false;
+            out.rows[0].unchecked(0) = a(1, 1) / det;
+            out.rows[0].unchecked(1) = -a(0, 1) / det;
+            out.rows[1].unchecked(0) = -a(1, 0) / det;
+            out.rows[1].unchecked(1) = a(0, 0) / det;
+        } else if constexpr (Rows == 3) {
+            // 余子式
+            T c00 = a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1);
+            T c01 = a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2);
+            T c02 = a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0);
+            T det = a(0, 0) * c00 + a(0, 1) * c01 + a(0, 2) * c02;
+            if (det == 0) return false;
+            T inv = T(1) / det;
+            out.rows[0].unchecked(0) = c00 * inv;
+            out.rows[0].unchecked(1) = (a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2)) * inv;
+            out.rows[0].unchecked(2) = (a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1)) * inv;
+            out.rows[1].unchecked(0) = c01 * inv;
+            out.rows[1].unchecked(1) = (a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0)) * inv;
+            out.rows[1].unchecked(2) = (a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2)) * inv;
+            out.rows[2].unchecked(0) = c02 * inv;
+            out.rows[2].unchecked(1) = (a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1)) * inv;
+            out.rows[2].unchecked(2) = (a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)) * inv;
+        } else if constexpr (Rows == 4) {
+#if defined(GM_SIMD_SSE)
+            if constexpr (std::is_same_v<T, float>) {
+                if (!detail::is_constant_evaluated()) {
+                    return detail::mat4_inverse(rows, out.rows) != 0;
+                }
+            }
+#endif
+            T s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
+            T s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+            T s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3);
+            T s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+            T s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3);
+            T s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+            T c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+            T c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2);
+            T c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+            T c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2);
+            T c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+            T c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3);
+            T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            if (det == 0) return false;
+            T inv = T(1) / det;
+            out.rows[0].unchecked(0) = ( a(1, 1) * c5 - a(1, 2) * c4 + a(1, 3) * c3) * inv;
+            out.rows[0].unchecked(1) = (-a(0, 1) * c5 + a(0, 2) * c4 - a(0, 3) * c3) * inv;
+            out.rows[0].unchecked(2) = ( a(3, 1) * s5 - a(3, 2) * s4 + a(3, 3) * s3) * inv;
+            out.rows[0].unchecked(3) = (-a(2, 1) * s5 + a(2, 2) * s4 - a(2, 3) * s3) * inv;
+            out.rows[1].unchecked(0) = (-a(1, 0) * c5 + a(1, 2) * c2 - a(1, 3) * c1) * inv;
+            out.rows[1].unchecked(1) = ( a(0, 0) * c5 - a(0, 2) * c2 + a(0, 3) * c1) * inv;
+            out.rows[1].unchecked(2) = (-a(3, 0) * s5 + a(3, 2) * s2 - a(3, 3) * s1) * inv;
+            out.rows[1].unchecked(3) = ( a(2, 0) * s5 - a(2, 2) * s2 + a(2, 3) * s1) * inv;
+            out.rows[2].unchecked(0) = ( a(1, 0) * c4 - a(1, 1) * c2 + a(1, 3) * c0) * inv;
+            out.rows[2].unchecked(1) = (-a(0, 0) * c4 + a(0, 1) * c2 - a(0, 3) * c0) * inv;
+            out.rows[2].unchecked(2) = ( a(3, 0) * s4 - a(3, 1) * s2 + a(3, 3) * s0) * inv;
+            out.rows[2].unchecked(3) = (-a(2, 0) * s4 + a(2, 1) * s2 - a(2, 3) * s0) * inv;
+            out.rows[3].unchecked(0) = (-a(1, 0) * c3 + a(1, 1) * c1 - a(1, 2) * c0) * inv;
+            out.rows[3].unchecked(1) = ( a(0, 0) * c3 - a(0, 1) * c1 + a(0, 2) * c0) * inv;
+            out.rows[3].unchecked(2) = (-a(3, 0) * s3 + a(3, 1) * s1 - a(3, 2) * s0) * inv;
+            out.rows[3].unchecked(3) = ( a(2, 0) * s3 - a(2, 1) * s1 + a(2, 2) * s0) * inv;
+        } else {
+            // 高斯-约当消元 (列主元)
+            static_assert(std::is_floating_point_v<T>, "Inverse of matrices larger than 4x4 requires a floating point type");
+            Matrix work = *this;
+            out = identity();
+            for (size_t k = 0; k < Rows; ++k) {
+                size_t pivot = k;
+                for (size_t i = k + 1; i < Rows; ++i) {
+                    if (std::abs(work.rows[i].unchecked(k)) > std::abs(work.rows[pivot].unchecked(k))) pivot = i;
+                }
+                if (work.rows[pivot].unchecked(k) == 0) return false;
+                std::swap(work.rows[pivot], work.rows[k]);
+                std::swap(out.rows[pivot], out.rows[k]);
+                T inv = T(1) / work.rows[k].unchecked(k);
+                work.rows[k] = work.rows[k] * inv;
+                out.rows[k] = out.rows[k] * inv;
+                for (size_t i = 0; i < Rows; ++i) {
+                    if (i == k) continue;
+                    T f = work.rows[i].unchecked(k);
+                    if (f == 0) continue;
+                    work.rows[i] = work.rows[i] - work.rows[k] * f;
+                    out.rows[i] = out.rows[i] - out.rows[k] * f;
+                }
+            }
+        }
+        return true;
+    }
 };
 
 // 标量乘法的友元函数 (允许 scalar * matrix)
 template<typename T, size_t Rows, size_t Cols>
-Matrix<T, Rows, Cols> operator*(T scalar, const Matrix<T, Rows, Cols>& matrix) {
+constexpr Matrix<T, Rows, Cols> operator*(T scalar, const Matrix<T, Rows, Cols>& matrix) {
     return matrix * scalar;
 }
 
 // 常用特化
+using Matrix2x2 = Matrix<float, 2, 2>;
 using Matrix3x3 = Matrix<float, 3, 3>;
+using Matrix3x4 = Matrix<float, 3, 4>;  // 仿射变换 (省略最后一行 0 0 0 1)
 using Matrix4x4 = Matrix<float, 4, 4>;
 
-// 特殊矩阵操作
-Matrix4x4 perspective(float fov, float aspect, float near, float far);
-Matrix4x4 orthographic(float left, float right, float bottom, float top, float near, float far);
-Matrix4x4 lookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up);
+// 特殊矩阵操作 (右手坐标系, 列向量约定, 裁剪空间 z 范围为 [-1, 1])
+
+/**
+ * @brief 透视投影矩阵
+ * @param fov 垂直视角 (弧度)
+ * @param aspect 宽高比
+ */
+inline Matrix4x4 perspective(float fov, float aspect, float zNear, float zFar) {
+    float f = 1.0f / std::tan(fov * 0.5f);
+    float invRange = 1.0f / (zNear - zFar);
+    return Matrix4x4{
+        Vector4f{f / aspect, 0, 0, 0},
+        Vector4f{0, f, 0, 0},
+        Vector4f{0, 0, (zFar + zNear) * invRange, 2 * zFar * zNear * invRange},
+        Vector4f{0, 0, -1, 0}
+    };
+}
+
+/**
+ * @brief 正交投影矩阵 (可在编译期求值)
+ */
+constexpr Matrix4x4 orthographic(float left, float right, float bottom, float top, float zNear, float zFar) {
+    return Matrix4x4{
+        Vector4f{2 / (right - left), 0, 0, -(right + left) / (right - left)},
+        Vector4f{0, 2 / (top - bottom), 0, -(top + bottom) / (top - bottom)},
+        Vector4f{0, 0, -2 / (zFar - zNear), -(zFar + zNear) / (zFar - zNear)},
+        Vector4f{0, 0, 0, 1}
+    };
+}
+
+/**
+ * @brief 观察矩阵: 相机位于 eye, 朝向 target
+ */
+inline Matrix4x4 lookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up) {
+    Vector3f f = (target - eye).normalized();
+    Vector3f s = f.cross(up).normalized();
+    Vector3f u = s.cross(f);
+    return Matrix4x4{
+        Vector4f{s.x, s.y, s.z, -s.dot(eye)},
+        Vector4f{u.x, u.y, u.z, -u.dot(eye)},
+        Vector4f{-f.x, -f.y, -f.z, f.dot(eye)},
+        Vector4f{0, 0, 0, 1}
+    };
+}
+
+/**
+ * @brief 仿射 3x4 矩阵相乘, 两者都视为最后一行为 (0, 0, 0, 1) 的 4x4 矩阵
+ *
+ * 与 4x4 乘法相比省去最后一行及其乘加, 适用于骨骼、场景节点等只含仿射变换的层级.
+ */
+template<typename T>
+constexpr Matrix<T, 3, 4> mul_affine(const Matrix<T, 3, 4>& a, const Matrix<T, 3, 4>& b) {
+    Matrix<T, 3, 4> result{};
+#if defined(GM_SIMD_SSE)
+    if constexpr (std::is_same_v<T, float>) {
+        if (!detail::is_constant_evaluated()) {
+            detail::mat34_mul_affine(a.rows, b.rows, result.rows);
+            return result;
+        }
+    }
+#endif
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            T v = a.rows[i].unchecked(0) * b.rows[0].unchecked(j) + a.rows[i].unchecked(1) * b.rows[1].unchecked(j) +
+                  a.rows[i].unchecked(2) * b.rows[2].unchecked(j);
+            result.rows[i].unchecked(j) = j == 3 ? v + a.rows[i].unchecked(3) : v;
+        }
+    }
+    return result;
+}
 
 /******************************
  *      矩阵操作函数           *
@@ -213,11 +810,11 @@ Matrix4x4 lookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up
  * @return 旋转后的新矩阵
  */
  template<typename T, size_t Rows, size_t Cols>
- Matrix<T, Cols, Rows> rotate_90_clockwise(const Matrix<T, Rows, Cols>& mat) {
-     Matrix<T, Cols, Rows> result;
+ constexpr Matrix<T, Cols, Rows> rotate_90_clockwise(const Matrix<T, Rows, Cols>& mat) {
+     Matrix<T, Cols, Rows> result{};
      for (size_t i = 0; i < Rows; ++i) {
          for (size_t j = 0; j < Cols; ++j) {
-             result[j][Rows - 1 - i] = mat[i][j];
+             result.rows[j].unchecked(Rows - 1 - i) = mat.rows[i].unchecked(j);
          }
      }
      return result;
@@ -229,11 +826,11 @@ Matrix4x4 lookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up
   * @return 旋转后的新矩阵
   */
  template<typename T, size_t Rows, size_t Cols>
- Matrix<T, Cols, Rows> rotate_90_counterclockwise(const Matrix<T, Rows, Cols>& mat) {
-     Matrix<T, Cols, Rows> result;
+ constexpr Matrix<T, Cols, Rows> rotate_90_counterclockwise(const Matrix<T, Rows, Cols>& mat) {
+     Matrix<T, Cols, Rows> result{};
      for (size_t i = 0; i < Rows; ++i) {
          for (size_t j = 0; j < Cols; ++j) {
-             result[Cols - 1 - j][i] = mat[i][j];
+             result.rows[Cols - 1 - j].unchecked(i) = mat.rows[i].unchecked(j);
          }
      }
      return result;
@@ -245,11 +842,11 @@ Matrix4x4 lookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up
   * @return 旋转后的新矩阵
   */
  template<typename T, size_t Rows, size_t Cols>
- Matrix<T, Rows, Cols> rotate_180(const Matrix<T, Rows, Cols>& mat) {
-     Matrix<T, Rows, Cols> result;
+ constexpr Matrix<T, Rows, Cols> rotate_180(const Matrix<T, Rows, Cols>& mat) {
+     Matrix<T, Rows, Cols> result{};
      for (size_t i = 0; i < Rows; ++i) {
          for (size_t j = 0; j < Cols; ++j) {
-             result[Rows - 1 - i][Cols - 1 - j] = mat[i][j];
+             result.rows[Rows - 1 - i].unchecked(Cols - 1 - j) = mat.rows[i].unchecked(j);
          }
      }
      return result;
@@ -261,11 +858,11 @@ Matrix4x4 lookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up
   * @return 翻转后的新矩阵
   */
  template<typename T, size_t Rows, size_t Cols>
- Matrix<T, Rows, Cols> flip_horizontal(const Matrix<T, Rows, Cols>& mat) {
-     Matrix<T, Rows, Cols> result;
+ constexpr Matrix<T, Rows, Cols> flip_horizontal(const Matrix<T, Rows, Cols>& mat) {
+     Matrix<T, Rows, Cols> result{};
      for (size_t i = 0; i < Rows; ++i) {
          for (size_t j = 0; j < Cols; ++j) {
-             result[i][Cols - 1 - j] = mat[i][j];
+             result.rows[i].unchecked(Cols - 1 - j) = mat.rows[i].unchecked(j);
          }
      }
      return result;
@@ -277,11 +874,11 @@ Matrix4x4 lookAt(const Vector3f& eye, const Vector3f& target, const Vector3f& up
   * @return 翻转后的新矩阵
   */
  template<typename T, size_t Rows, size_t Cols>
- Matrix<T, Rows, Cols> flip_vertical(const Matrix<T, Rows, Cols>& mat) {
-     Matrix<T, Rows, Cols> result;
+ constexpr Matrix<T, Rows, Cols> flip_vertical(const Matrix<T, Rows, Cols>& mat) {
+     Matrix<T, Rows, Cols> result{};
      for (size_t i = 0; i < Rows; ++i) {
          for (size_t j = 0; j < Cols; ++j) {
-             result[Rows - 1 - i][j] = mat[i][j];
+             result.rows[Rows - 1 - i].unchecked(j) = mat.rows[i].unchecked(j);
          }
      }
      return result;
@@ -0,0 +1,379 @@
+/******************************
+ *         矩阵跨步视图           *
+ ******************************/
+#pragma once
+#include "Matrix.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace GameMath {
+
+namespace detail {
+    // 把 rows x cols 的跨步视图复制到稠密行 dst (行步长 dstStride, 列步长 1)
+    template<typename T>
+    void view_copy(const T* src, ptrdiff_t rs, ptrdiff_t cs, size_t rows, size_t cols, T* dst, ptrdiff_t dstStride) {
+        if (cs == 1) {
+            for (size_t r = 0; r < rows; ++r) {
+                const T* s = src + ptrdiff_t(r) * rs;
+                std::copy(s, s + cols, dst + ptrdiff_t(r) * dstStride);
+            }
+            return;
+        }
+#if defined(GM_SIMD_SSE)
+        if constexpr (sizeof(T) == 4 && std::is_trivially_copyable_v<T>) {
+            if (cs == -1) {
+                // 行内反向: 每次读 4 个元素后倒序写出
+                for (size_t r = 0; r < rows; ++r) {
+                    const T* s = src + ptrdiff_t(r) * rs;
+                    T* d = dst + ptrdiff_t(r) * dstStride;
+                    size_t c = 0;
+                    for (; c + 4 <= cols; c += 4) {
+                        __m128 v = _mm_loadu_ps(reinterpret_cast<const float*>(s - ptrdiff_t(c) - 3));
+                        _mm_storeu_ps(reinterpret_cast<float*>(d + c), _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)));
+                    }
+                    for (; c < cols; ++c) d[c] = s[-ptrdiff_t(c)];
+                }
+                return;
+            }
+            if (rs == 1 || rs == -1) {
+                // 转置类视图 (源数据沿视图的列方向连续): 32x32 分块内做 4x4 SSE 转置
+                constexpr size_t kBlock = 32;
+                for (size_t r0 = 0; r0 < rows; r0 += kBlock) {
+                    size_t r1 = std::min(rows, r0 + kBlock);
+                    for (size_t c0 = 0; c0 < cols; c0 += kBlock) {
+                        size_t c1 = std::min(cols, c0 + kBlock);
+                        size_t r = r0;
+                        for (; r + 4 <= r1; r += 4) {
+                            size_t c = c0;
+                            for (; c + 4 <= c1; c += 4) {
+                                __m128 col[4];
+                                for (size_t k = 0; k < 4; ++k) {
+                                    const T* s = src + ptrdiff_t(c + k) * cs;
+                                    if (rs == 1) {
+                                        col[k] = _mm_loadu_ps(reinterpret_cast<const float*>(s + r));
+                                    } else {
+                                        __m128 v = _mm_loadu_ps(reinterpret_cast<const float*>(s - ptrdiff_t(r) - 3));
+                                        col[k] = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+                                    }
+                                }
+                                _MM_TRANSPOSE4_PS(col[0], col[1], col[2], col[3]);
+                                for (size_t k = 0; k < 4; ++k) {
+                                    _mm_storeu_ps(reinterpret_cast<float*>(dst + ptrdiff_t(r + k) * dstStride + ptrdiff_t(c)), col[k]);
+                                }
+                            }
+                            for (; c < c1; ++c) {
+                                for (size_t k = 0; k < 4; ++k) {
+                                    dst[ptrdiff_t(r + k) * dstStride + ptrdiff_t(c)] = src[ptrdiff_t(r + k) * rs + ptrdiff_t(c) * cs];
+                                }
+                            }
+                        }
+                        for (; r < r1; ++r) {
+                            for (size_t c = c0; c < c1; ++c) {
+                                dst[ptrdiff_t(r) * dstStride + ptrdiff_t(c)] = src[ptrdiff_t(r) * rs + ptrdiff_t(c) * cs];
+                            }
+                        }
+                    }
+                }
+                return;
+            }
+        }
+#endif
+        // 通用路径: 分块使跨步读取集中在少数缓存行内
+        constexpr size_t kBlock = 16;
+        for (size_t r0 = 0; r0 < rows; r0 += kBlock) {
+            size_t r1 = std::min(rows, r0 + kBlock);
+            for (size_t c0 = 0; c0 < cols; c0 += kBlock) {
+                size_t c1 = std::min(cols, c0 + kBlock);
+                for (size_t r = r0; r < r1; ++r) {
+                    for (size_t c = c0; c < c1; ++c) {
+                        dst[ptrdiff_t(r) * dstStride + ptrdiff_t(c)] = src[ptrdiff_t(r) * rs + ptrdiff_t(c) * cs];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 二维跨步视图: 元素 (r, c) 位于 data()[r * row_stride() + c * col_stride()]
+ *
+ * 不拥有数据, 复制代价为常数. 旋转、翻转、转置只改变起点与步长, 不复制元素;
+ * 需要稠密结果时用 copy_to / to_matrix (分块复制, 4 字节元素使用 SSE).
+ * T 为 const 类型时为只读视图; MatrixView<T> 可隐式转换为 MatrixView<const T>.
+ * @code
+ * auto rotated = view(board).rotated_cw();      // 无复制
+ * bool symmetric = rotated.equals(view(board));  // 直接比较
+ * @endcode
+ */
+template<typename T>
+class MatrixView {
+    T* m_data = nullptr;
+    size_t m_rows = 0;
+    size_t m_cols = 0;
+    ptrdiff_t m_rowStride = 0;
+    ptrdiff_t m_colStride = 1;
+
+public:
+    constexpr MatrixView() = default;
+
+    // 稠密行主序数据, 行步长默认为 cols
+    constexpr MatrixView(T* data, size_t rows, size_t cols)
+        : m_data(data), m_rows(rows), m_cols(cols), m_rowStride(ptrdiff_t(cols)), m_colStride(1) {}
+
+    constexpr MatrixView(T* data, size_t rows, size_t cols, ptrdiff_t rowStride, ptrdiff_t colStride = 1)
+        : m_data(data), m_rows(rows), m_cols(cols), m_rowStride(rowStride), m_colStride(colStride) {}
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    constexpr MatrixView(const MatrixView<U>& other)
+        : m_data(other.data()), m_rows(other.rows()), m_cols(other.cols()),
+          m_rowStride(other.row_stride()), m_colStride(other.col_stride()) {}
+
+    // (0, 0) 元素的地址与步长 (以元素为单位, 可为负)
+    constexpr T* data() const { return m_data; }
+    constexpr size_t rows() const { return m_rows; }
+    constexpr size_t cols() const { return m_cols; }
+    constexpr size_t size() const { return m_rows * m_cols; }
+    constexpr bool empty() const { return m_rows == 0 || m_cols == 0; }
+    constexpr ptrdiff_t row_stride() const { return m_rowStride; }
+    constexpr ptrdiff_t col_stride() const { return m_colStride; }
+
+    constexpr T& operator()(size_t row, size_t col) const {
+        return m_data[ptrdiff_t(row) * m_rowStride + ptrdiff_t(col) * m_colStride];
+    }
+
+    constexpr T& at(size_t row, size_t col) const {
+        if (row >= m_rows || col >= m_cols) {
+            throw std::out_of_range("MatrixView indices out of range");
+        }
+        return (*this)(row, col);
+    }
+
+    /******************************
+     *     重映射 (不复制元素)       *
+     ******************************/
+
+    constexpr MatrixView transposed() const {
+        return MatrixView(m_data, m_cols, m_rows, m_colStride, m_rowStride);
+    }
+
+    // 结果 (i, j) = 原 (rows - 1 - j, i), 与 rotate_90_clockwise 相同
+    constexpr MatrixView rotated_cw() const {
+        if (empty()) return transposed();
+        return MatrixView(&(*this)(m_rows - 1, 0), m_cols, m_rows, m_colStride, -m_rowStride);
+    }
+
+    // 结果 (i, j) = 原 (j, cols - 1 - i), 与 rotate_90_counterclockwise 相同
+    constexpr MatrixView rotated_ccw() const {
+        if (empty()) return transposed();
+        return MatrixView(&(*this)(0, m_cols - 1), m_cols, m_rows, -m_colStride, m_rowStride);
+    }
+
+    constexpr MatrixView rotated_180() const {
+        if (empty()) return *this;
+        return MatrixView(&(*this)(m_rows - 1, m_cols - 1), m_rows, m_cols, -m_rowStride, -m_colStride);
+    }
+
+    // 左右翻转, 与 flip_horizontal 相同
+    constexpr MatrixView flipped_horizontal() const {
+        if (empty()) return *this;
+        return MatrixView(&(*this)(0, m_cols - 1), m_rows, m_cols, m_rowStride, -m_colStride);
+    }
+
+    // 上下翻转, 与 flip_vertical 相同
+    constexpr MatrixView flipped_vertical() const {
+        if (empty()) return *this;
+        return MatrixView(&(*this)(m_rows - 1, 0), m_rows, m_cols, -m_rowStride, m_colStride);
+    }
+
+    // 子区域 [row, row + rows) x [col, col + cols)
+    MatrixView block(size_t row, size_t col, size_t rows, size_t cols) const {
+        if (row + rows > m_rows || col + cols > m_cols) {
+            throw std::out_of_range("MatrixView block out of range");
+        }
+        T* origin = (rows == 0 || cols == 0) ? m_data : &(*this)(row, col);
+        return MatrixView(origin, rows, cols, m_rowStride, m_colStride);
+    }
+
+    /******************************
+     *           比较与复制          *
+     ******************************/
+
+    // 形状与所有元素都相同
+    template<typename U>
+    bool equals(const MatrixView<U>& other) const {
+        if (m_rows != other.rows() || m_cols != other.cols()) return false;
+        for (size_t r = 0; r < m_rows; ++r) {
+            for (size_t c = 0; c < m_cols; ++c) {
+                if (!((*this)(r, c) == other(r, c))) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 按行主序复制到 out (行步长 outRowStride, 默认为 cols), out 不得与视图重叠
+     */
+    void copy_to(std::remove_const_t<T>* out, ptrdiff_t outRowStride = 0) const {
+        if (empty()) return;
+        detail::view_copy<std::remove_const_t<T>>(m_data, m_rowStride, m_colStride, m_rows, m_cols, out,
+                                                  outRowStride ? outRowStride : ptrdiff_t(m_cols));
+    }
+
+    /**
+     * @brief 复制为固定尺寸矩阵
+     * @throws std::invalid_argument 当尺寸不一致时
+     */
+    template<size_t Rows, size_t Cols>
+    Matrix<std::remove_const_t<T>, Rows, Cols> to_matrix() const {
+        using U = std::remove_const_t<T>;
+        if (m_rows != Rows || m_cols != Cols) {
+            throw std::invalid_argument("MatrixView size does not match the matrix");
+        }
+        Matrix<U, Rows, Cols> result{};
+        static_assert(sizeof(Vector<U, Cols>) % sizeof(U) == 0, "Matrix rows must be a whole number of elements");
+        copy_to(result.rows[0].data, ptrdiff_t(sizeof(Vector<U, Cols>) / sizeof(U)));
+        return result;
+    }
+};
+
+/**
+ * @brief 固定尺寸矩阵的视图 (行步长按 Vector<T, Cols> 的实际大小计算)
+ */
+template<typename T, size_t Rows, size_t Cols>
+MatrixView<T> view(Matrix<T, Rows, Cols>& m) {
+    static_assert(sizeof(Vector<T, Cols>) % sizeof(T) == 0, "Matrix rows must be a whole number of elements");
+    return MatrixView<T>(m.rows[0].data, Rows, Cols, ptrdiff_t(sizeof(Vector<T, Cols>) / sizeof(T)), 1);
+}
+
+template<typename T, size_t Rows, size_t Cols>
+MatrixView<const T> view(const Matrix<T, Rows, Cols>& m) {
+    static_assert(sizeof(Vector<T, Cols>) % sizeof(T) == 0, "Matrix rows must be a whole number of elements");
+    return MatrixView<const T>(m.rows[0].data, Rows, Cols, ptrdiff_t(sizeof(Vector<T, Cols>) / sizeof(T)), 1);
+}
+
+/******************************
+ *          原地变换            *
+ ******************************/
+
+/**
+ * @brief 原地转置方阵视图 (32x32 分块交换)
+ * @throws std::invalid_argument 当视图不是方阵时
+ */
+template<typename T>
+void transpose_in_place(MatrixView<T> v) {
+    if (v.rows() != v.cols()) throw std::invalid_argument("In-place transpose requires a square view");
+    constexpr size_t kBlock = 32;
+    size_t n = v.rows();
+    for (size_t i0 = 0; i0 < n; i0 += kBlock) {
+        for (size_t j0 = i0; j0 < n; j0 += kBlock) {
+            size_t i1 = std::min(n, i0 + kBlock);
+            size_t j1 = std::min(n, j0 + kBlock);
+            for (size_t i = i0; i < i1; ++i) {
+                for (size_t j = std::max(j0, i + 1); j < j1; ++j) {
+                    std::swap(v(i, j), v(j, i));
+                }
+            }
+        }
+    }
+}
+
+// 原地左右翻转 (任意形状)
+template<typename T>
+void flip_horizontal_in_place(MatrixView<T> v) {
+    for (size_t r = 0; r < v.rows(); ++r) {
+        if (v.col_stride() == 1) {
+            T* row = &v(r, 0);
+            std::reverse(row, row + v.cols());
+        } else {
+            for (size_t c = 0, e = v.cols(); c + 1 < e; ++c, --e) std::swap(v(r, c), v(r, e - 1));
+        }
+    }
+}
+
+// 原地上下翻转 (任意形状)
+template<typename T>
+void flip_vertical_in_place(MatrixView<T> v) {
+    for (size_t r = 0, e = v.rows(); r + 1 < e; ++r, --e) {
+        if (v.col_stride() == 1 && v.cols() > 0) {
+            std::swap_ranges(&v(r, 0), &v(r, 0) + v.cols(), &v(e - 1, 0));
+        } else {
+            for (size_t c = 0; c < v.cols(); ++c) std::swap(v(r, c), v(e - 1, c));
+        }
+    }
+}
+
+// 原地旋转 180 度 (任意形状)
+template<typename T>
+void rotate_180_in_place(MatrixView<T> v) {
+    flip_vertical_in_place(v);
+    flip_horizontal_in_place(v);
+}
+
+namespace detail {
+    // 方阵按同心环做四元轮换, 每个元素只读写一次
+    template<typename T, bool Clockwise>
+    void rotate_square_in_place(MatrixView<T> v) {
+        if (v.rows() != v.cols()) throw std::invalid_argument("In-place rotation requires a square view");
+        size_t n = v.rows();
+        for (size_t i = 0; i < n / 2; ++i) {
+            size_t last = n - 1 - i;
+            for (size_t j = i; j < last; ++j) {
+                size_t k = n - 1 - j;
+                T tmp = std::move(v(i, j));
+                if constexpr (Clockwise) {
+                    v(i, j) = std::move(v(k, i));
+                    v(k, i) = std::move(v(last, k));
+                    v(last, k) = std::move(v(j, last));
+                    v(j, last) = std::move(tmp);
+                } else {
+                    v(i, j) = std::move(v(j, last));
+                    v(j, last) = std::move(v(last, k));
+                    v(last, k) = std::move(v(k, i));
+                    v(k, i) = std::move(tmp);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 原地顺时针旋转方阵视图 90 度
+ * @throws std::invalid_argument 当视图不是方阵时
+ */
+template<typename T>
+void rotate_90_clockwise_in_place(MatrixView<T> v) {
+    detail::rotate_square_in_place<T, true>(v);
+}
+
+/**
+ * @brief 原地逆时针旋转方阵视图 90 度
+ * @throws std::invalid_argument 当视图不是方阵时
+ */
+template<typename T>
+void rotate_90_counterclockwise_in_place(MatrixView<T> v) {
+    detail::rotate_square_in_place<T, false>(v);
+}
+
+// 固定尺寸矩阵的原地版本
+template<typename T, size_t N>
+void transpose_in_place(Matrix<T, N, N>& m) { transpose_in_place(view(m)); }
+
+template<typename T, size_t N>
+void rotate_90_clockwise_in_place(Matrix<T, N, N>& m) { rotate_90_clockwise_in_place(view(m)); }
+
+template<typename T, size_t N>
+void rotate_90_counterclockwise_in_place(Matrix<T, N, N>& m) { rotate_90_counterclockwise_in_place(view(m)); }
+
+template<typename T, size_t Rows, size_t Cols>
+void rotate_180_in_place(Matrix<T, Rows, Cols>& m) { rotate_180_in_place(view(m)); }
+
+template<typename T, size_t Rows, size_t Cols>
+void flip_horizontal_in_place(Matrix<T, Rows, Cols>& m) { flip_horizontal_in_place(view(m)); }
+
+template<typename T, size_t Rows, size_t Cols>
+void flip_vertical_in_place(Matrix<T, Rows, Cols>& m) { flip_vertical_in_place(view(m)); }
+
+} // namespace GameMath
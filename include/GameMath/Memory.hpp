@@ -0,0 +1,232 @@
+/******************************
+ *       对齐存储与帧内存池        *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Span.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace GameMath {
+
+// 缓存行大小, 也是批量内核缓冲区的默认对齐
+constexpr size_t kCacheLine = 64;
+
+namespace detail {
+    constexpr bool is_power_of_two(size_t x) { return x != 0 && (x & (x - 1)) == 0; }
+
+    // 64 字节对齐的堆数组 (算术类型, 不调用构造函数)
+    struct AlignedFree {
+        void operator()(void* p) const { ::operator delete(p, std::align_val_t(kCacheLine)); }
+    };
+
+    template<typename T>
+    using AlignedArray = std::unique_ptr<T[], AlignedFree>;
+
+    template<typename T>
+    AlignedArray<T> make_aligned_array(size_t count) {
+        if (count == 0) return AlignedArray<T>();
+        return AlignedArray<T>(static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(kCacheLine))));
+    }
+}
+
+/**
+ * @brief 按 Align 字节对齐分配的标准库分配器
+ *
+ * AlignedVector<float> 的起始地址位于缓存行边界, SIMD 内核按通道宽度步进时不会跨行读取.
+ */
+template<typename T, size_t Align = kCacheLine>
+class AlignedAllocator {
+    static_assert(detail::is_power_of_two(Align), "Alignment must be a power of two");
+    static_assert(Align >= alignof(T), "Alignment must not be weaker than alignof(T)");
+
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Align)));
+    }
+
+    void deallocate(T* p, size_t) noexcept { ::operator delete(p, std::align_val_t(Align)); }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const noexcept { return false; }
+};
+
+template<typename T, size_t Align = kCacheLine>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Align>>;
+
+/**
+ * @brief 按 Align 对齐的 T (继承 T 的构造函数与运算)
+ *
+ * 对齐同时把 sizeof 补齐到 Align 的倍数: Vector3fAligned 为 16 字节, 可以整块读取;
+ * Matrix4x4Aligned 恰好占一条缓存行. 运算结果为 T, 可直接赋值回来.
+ */
+template<typename T, size_t Align>
+struct alignas(Align) Aligned : T {
+    static_assert(detail::is_power_of_two(Align), "Alignment must be a power of two");
+    using T::T;
+
+    Aligned() = default;
+    constexpr Aligned(const T& value) : T(value) {}
+
+    constexpr T& value() noexcept { return *this; }
+    constexpr const T& value() const noexcept { return *this; }
+};
+
+using Vector3fAligned = Aligned<Vector3f, 16>;
+using Vector4fAligned = Aligned<Vector4f, 16>;
+using Matrix3x4Aligned = Aligned<Matrix3x4, kCacheLine>;
+using Matrix4x4Aligned = Aligned<Matrix4x4, kCacheLine>;
+
+/**
+ * @brief 帧内存池: 顺序分配缓存行对齐的块, 每帧 reset() 一次性全部回收
+ *
+ * 分配只移动偏移量, 不逐个释放. 当前块用完时追加新块 (至少为上一块的两倍);
+ * reset() 时若本帧用到了多个块, 合并为一个能容纳全部用量的块, 之后的帧不再申请堆内存.
+ * 只能存放平凡析构的类型, 不是线程安全的 (每个线程各用一个).
+ * @code
+ * FrameArena arena;
+ * Span<Vector4f> tmp = arena.allocate_span<Vector4f>(count);
+ * transform(m, in, tmp);
+ * arena.reset();  // 帧末
+ * @endcode
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t blockSize = 64 * 1024) : m_blockSize(std::max(blockSize, kCacheLine)) {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // 移动后源对象不再持有任何块, 状态与 release() 之后相同
+    FrameArena(FrameArena&& other) noexcept
+        : m_blocks(std::move(other.m_blocks)), m_blockSize(other.m_blockSize), m_capacity(other.m_capacity),
+          m_current(other.m_current), m_offset(other.m_offset), m_used(other.m_used) {
+        other.drop_blocks();
+    }
+
+    FrameArena& operator=(FrameArena&& other) noexcept {
+        if (this != &other) {
+            m_blocks = std::move(other.m_blocks);
+            m_blockSize = other.m_blockSize;
+            m_capacity = other.m_capacity;
+            m_current = other.m_current;
+            m_offset = other.m_offset;
+            m_used = other.m_used;
+            other.drop_blocks();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 分配 bytes 字节的未初始化内存, 起始地址按 alignment 对齐 (默认 64)
+     * @throws std::invalid_argument 当 alignment 不是 2 的幂或大于 64 时
+     */
+    void* allocate(size_t bytes, size_t alignment = kCacheLine) {
+        if (!detail::is_power_of_two(alignment) || alignment > kCacheLine) {
+            throw std::invalid_argument("FrameArena alignment must be a power of two no greater than 64");
+        }
+        bytes = std::max<size_t>(bytes, 1);
+        while (m_current < m_blocks.size()) {
+            Block& block = m_blocks[m_current];
+            size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+            if (offset <= block.size && bytes <= block.size - offset) {
+                m_offset = offset + bytes;
+                m_used += bytes;
+                return block.data.get() + offset;
+            }
+            // 当前块放不下, 换到下一块
+            ++m_current;
+            m_offset = 0;
+        }
+        size_t size = std::max(bytes, m_blocks.empty() ? m_blockSize : m_blocks.back().size * 2);
+        size = (size + kCacheLine - 1) & ~(kCacheLine - 1);
+        m_blocks.push_back(Block{detail::make_aligned_array<unsigned char>(size), size});
+        m_capacity += size;
+        m_current = m_blocks.size() - 1;
+        m_offset = bytes;
+        m_used += bytes;
+        return m_blocks.back().data.get();
+    }
+
+    // count 个 T 的未初始化存储, 按 64 字节对齐
+    template<typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena only holds trivially destructible types");
+        static_assert(alignof(T) <= kCacheLine, "FrameArena alignment is limited to 64 bytes");
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(allocate(count * sizeof(T), kCacheLine));
+    }
+
+    template<typename T>
+    Span<T> allocate_span(size_t count) { return Span<T>(allocate<T>(count), count); }
+
+    /**
+     * @brief 回收本帧的全部分配, 之前返回的指针全部失效
+     */
+    void reset() {
+        if (m_blocks.size() > 1) {
+            size_t total = m_capacity;
+            m_blocks.clear();
+            m_blocks.push_back(Block{detail::make_aligned_array<unsigned char>(total), total});
+        }
+        m_current = 0;
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    // 释放所有块
+    void release() {
+        drop_blocks();
+    }
+
+    // 本帧已分配的字节数 (不含对齐填充)
+    size_t used() const { return m_used; }
+    // 所有块的总字节数
+    size_t capacity() const { return m_capacity; }
+    size_t block_count() const { return m_blocks.size(); }
+
+private:
+    struct Block {
+        detail::AlignedArray<unsigned char> data;
+        size_t size;
+    };
+
+    void drop_blocks() noexcept {
+        m_blocks.clear();
+        m_capacity = 0;
+        m_current = 0;
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    std::vector<Block> m_blocks;
+    size_t m_blockSize;
+    size_t m_capacity = 0;
+    size_t m_current = 0;  // 正在使用的块
+    size_t m_offset = 0;   // 当前块内的下一个空闲字节
+    size_t m_used = 0;
+};
+
+} // namespace GameMath
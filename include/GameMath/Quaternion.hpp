@@ -0,0 +1,510 @@
+/******************************
+ *          四元数              *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Batch.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+
+namespace GameMath {
+
+/**
+ * @brief 单位四元数表示的旋转, (x, y, z) 为虚部, w 为实部
+ *
+ * 与 Vector4f 相同, 有 SSE 时以一个 __m128 存储, 乘法与旋转向量均为 SIMD 实现.
+ * 与矩阵的转换遵循本库的列向量约定 (M * v).
+ */
+struct Quaternion {
+    union {
+#if defined(GM_SIMD_SSE)
+        __m128 simd;
+#endif
+        struct { float x, y, z, w; };
+        float data[4];
+    };
+
+    // 构造函数 (默认为单位四元数)
+    constexpr Quaternion() : x(0), y(0), z(0), w(1) {}
+
+    constexpr Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+#if defined(GM_SIMD_SSE)
+    explicit Quaternion(__m128 v) : simd(v) {}
+#endif
+
+    static constexpr Quaternion identity() noexcept {
+        return Quaternion();
+    }
+
+    /**
+     * @brief 绕轴旋转
+     * @param axis 旋转轴 (须为单位向量)
+     * @param angle 旋转角 (弧度)
+     */
+    static Quaternion from_axis_angle(const Vector3f& axis, float angle) noexcept {
+        float s = std::sin(angle * 0.5f);
+        return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+    }
+
+    /**
+     * @brief 由旋转矩阵构造 (只读取左上 3x3, 须为正交矩阵)
+     */
+    static Quaternion from_matrix(const Matrix3x3& m) noexcept {
+        return from_rotation(m(0, 0), m(0, 1), m(0, 2),
+                             m(1, 0), m(1, 1), m(1, 2),
+                             m(2, 0), m(2, 1), m(2, 2));
+    }
+
+    static Quaternion from_matrix(const Matrix4x4& m) noexcept {
+        return from_rotation(m(0, 0), m(0, 1), m(0, 2),
+                             m(1, 0), m(1, 1), m(1, 2),
+                             m(2, 0), m(2, 1), m(2, 2));
+    }
+
+    // 转换为旋转矩阵
+    Matrix3x3 to_matrix3() const noexcept {
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+        return Matrix3x3{
+            Vector3f(1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy)),
+            Vector3f(2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx)),
+            Vector3f(2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy))
+        };
+    }
+
+    Matrix4x4 to_matrix4() const noexcept {
+        Matrix3x3 r = to_matrix3();
+        return Matrix4x4{
+            Vector4f{r(0, 0), r(0, 1), r(0, 2), 0.0f},
+            Vector4f{r(1, 0), r(1, 1), r(1, 2), 0.0f},
+            Vector4f{r(2, 0), r(2, 1), r(2, 2), 0.0f},
+            Vector4f{0.0f, 0.0f, 0.0f, 1.0f}
+        };
+    }
+
+    // 分量运算
+    Quaternion operator+(const Quaternion& rhs) const noexcept {
+#if defined(GM_SIMD_SSE)
+        return Quaternion(_mm_add_ps(simd, rhs.simd));
+#else
+        return Quaternion(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
+#endif
+    }
+
+    Quaternion operator-(const Quaternion& rhs) const noexcept {
+#if defined(GM_SIMD_SSE)
+        return Quaternion(_mm_sub_ps(simd, rhs.simd));
+#else
+        return Quaternion(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
+#endif
+    }
+
+    Quaternion operator-() const noexcept {
+#if defined(GM_SIMD_SSE)
+        return Quaternion(_mm_xor_ps(simd, _mm_set1_ps(-0.0f)));
+#else
+        return Quaternion(-x, -y, -z, -w);
+#endif
+    }
+
+    Quaternion operator*(float s) const noexcept {
+#if defined(GM_SIMD_SSE)
+        return Quaternion(_mm_mul_ps(simd, _mm_set1_ps(s)));
+#else
+        return Quaternion(x * s, y * s, z * s, w * s);
+#endif
+    }
+
+    /**
+     * @brief 四元数乘法 (Hamilton 积): 先应用 rhs 的旋转, 再应用 *this
+     */
+    Quaternion operator*(const Quaternion& rhs) const noexcept {
+#if defined(GM_SIMD_SSE)
+        // 第四通道 (w) 的符号与 x/y/z 通道相反
+        const __m128 flipW = _mm_setr_ps(0.0f, 0.0f, 0.0f, -0.0f);
+        __m128 a = simd, b = rhs.simd;
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+        __m128 t1 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 2, 1, 0)),
+                               _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 3, 3)));
+        __m128 t2 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)),
+                               _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 0, 2)));
+        __m128 t3 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)),
+                               _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 0, 2, 1)));
+        r = _mm_add_ps(r, _mm_xor_ps(_mm_add_ps(t1, t2), flipW));
+        return Quaternion(_mm_sub_ps(r, t3));
+#else
+        return Quaternion(
+            w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+            w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+            w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+            w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z
+        );
+#endif
+    }
+
+    // 旋转向量: v' = q v q*
+    Vector3f rotate(const Vector3f& v) const noexcept {
+#if defined(GM_SIMD_SSE)
+        // v' = v + w * t + u x t, 其中 t = 2 (u x v)
+        __m128 p = _mm_setr_ps(v.x, v.y, v.z, 0.0f);
+        __m128 t = detail::cross3_ps(simd, p);
+        t = _mm_add_ps(t, t);
+        __m128 r = _mm_add_ps(p, _mm_mul_ps(_mm_shuffle_ps(simd, simd, _MM_SHUFFLE(3, 3, 3, 3)), t));
+        r = _mm_add_ps(r, detail::cross3_ps(simd, t));
+        Vector3f result;
+        _mm_storel_pi(reinterpret_cast<__m64*>(&result.x), r);
+        _mm_store_ss(&result.z, _mm_movehl_ps(r, r));
+        return result;
+#else
+        Vector3f u(x, y, z);
+        Vector3f t = u.cross(v) * 2.0f;
+        return v + t * w + u.cross(t);
+#endif
+    }
+
+    Vector3f operator*(const Vector3f& v) const noexcept {
+        return rotate(v);
+    }
+
+    // 共轭 (单位四元数的逆)
+    Quaternion conjugate() const noexcept {
+#if defined(GM_SIMD_SSE)
+        return Quaternion(_mm_xor_ps(simd, _mm_setr_ps(-0.0f, -0.0f, -0.0f, 0.0f)));
+#else
+        return Quaternion(-x, -y, -z, w);
+#endif
+    }
+
+    // 逆四元数 (GM_CHECKED 为 0 时零四元数得到 NaN)
+    Quaternion inverse() const noexcept(!kChecked) {
+        float n = length_squared();
+        if constexpr (kChecked) {
+            if (n == 0) throw std::runtime_error("Cannot invert zero quaternion");
+        }
+        return conjugate() * (1.0f / n);
+    }
+
+    float dot(const Quaternion& rhs) const noexcept {
+#if defined(GM_SIMD_SSE)
+        return detail::hsum_ps(_mm_mul_ps(simd, rhs.simd));
+#else
+        return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w;
+#endif
+    }
+
+    float length_squared() const noexcept {
+        return dot(*this);
+    }
+
+    float length() const noexcept {
+        return std::sqrt(length_squared());
+    }
+
+    // 归一化 (GM_CHECKED 为 0 时零四元数得到 NaN)
+    Quaternion normalized() const noexcept(!kChecked) {
+        float len = length();
+        if constexpr (kChecked) {
+            if (len == 0) throw std::runtime_error("Cannot normalize zero quaternion");
+        }
+        return *this * (1.0f / len);
+    }
+
+    // 不抛异常的归一化, 零四元数返回 fallback
+    Quaternion safe_normalized(const Quaternion& fallback = Quaternion::identity()) const noexcept {
+        float len = length();
+        if (len == 0) return fallback;
+        return *this * (1.0f / len);
+    }
+
+    // 比较操作符
+    bool operator==(const Quaternion& rhs) const noexcept {
+        return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w;
+    }
+
+    bool operator!=(const Quaternion& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    // Shepperd 方法: 按迹与对角元中最大者选择分支, 保证数值稳定
+    static Quaternion from_rotation(float m00, float m01, float m02,
+                                    float m10, float m11, float m12,
+                                    float m20, float m21, float m22) noexcept {
+        float trace = m00 + m11 + m22;
+        if (trace > 0) {
+            float s = 0.5f / std::sqrt(trace + 1.0f);
+            return Quaternion((m21 - m12) * s, (m02 - m20) * s, (m10 - m01) * s, 0.25f / s);
+        }
+        if (m00 > m11 && m00 > m22) {
+            float s = 2.0f * std::sqrt(1.0f + m00 - m11 - m22);
+            return Quaternion(0.25f * s, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s);
+        }
+        if (m11 > m22) {
+            float s = 2.0f * std::sqrt(1.0f + m11 - m00 - m22);
+            return Quaternion((m01 + m10) / s, 0.25f * s, (m12 + m21) / s, (m02 - m20) / s);
+        }
+        float s = 2.0f * std::sqrt(1.0f + m22 - m00 - m11);
+        return Quaternion((m02 + m20) / s, (m12 + m21) / s, 0.25f * s, (m10 - m01) / s);
+    }
+};
+
+inline Quaternion operator*(float s, const Quaternion& q) noexcept {
+    return q * s;
+}
+
+/******************************
+ *          插值函数            *
+ ******************************/
+
+namespace detail {
+    // 两四元数夹角的余弦小于该值时 slerp 退化为 nlerp, 避免除以接近 0 的 sin
+    constexpr float kSlerpLinearThreshold = 0.9995f;
+
+    // slerp 的两个权重; cosTheta 须已取非负
+    inline void slerp_weights(float cosTheta, float t, float& wa, float& wb) noexcept {
+        if (cosTheta > kSlerpLinearThreshold) {
+            wa = 1.0f - t;
+            wb = t;
+            return;
+        }
+        float theta = std::acos(cosTheta);
+        float invSin = 1.0f / std::sin(theta);
+        wa = std::sin((1.0f - t) * theta) * invSin;
+        wb = std::sin(t * theta) * invSin;
+    }
+}
+
+/**
+ * @brief 归一化线性插值, 沿最短路径; 比 slerp 快但角速度不均匀
+ */
+inline Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t) noexcept {
+    float wb = a.dot(b) < 0 ? -t : t;
+    return (a * (1.0f - t) + b * wb).safe_normalized(a);
+}
+
+/**
+ * @brief 球面线性插值, 沿最短路径匀角速度旋转
+ */
+inline Quaternion slerp(const Quaternion& a, const Quaternion& b, float t) noexcept {
+    float cosTheta = a.dot(b);
+    float sign = 1.0f;
+    if (cosTheta < 0) {
+        cosTheta = -cosTheta;
+        sign = -1.0f;
+    }
+    float wa, wb;
+    detail::slerp_weights(cosTheta, t, wa, wb);
+    Quaternion r = a * wa + b * (wb * sign);
+    // 退化为线性插值时需要重新归一化
+    return cosTheta > detail::kSlerpLinearThreshold ? r.safe_normalized(a) : r;
+}
+
+/******************************
+ *        批量插值函数          *
+ ******************************/
+
+namespace detail {
+    inline void check_quat_spans(size_t a, size_t b, size_t out) {
+        if (a != b || a != out) {
+            throw std::invalid_argument("Input and output sizes do not match");
+        }
+    }
+
+    // SoA 四元数 nlerp 内核 (与 BatchKernels.inl 相同的打包类型约定)
+    template<typename P>
+    size_t batch_quat_nlerp(const float* const* a, const float* const* b, const float* t,
+                            float* const* out, size_t i, size_t count) {
+        auto zero = P::zero();
+        auto one = P::set1(1.0f);
+        for (; i + P::width <= count; i += P::width) {
+            typename P::reg qa[4], qb[4];
+            for (size_t c = 0; c < 4; ++c) {
+                qa[c] = P::load(a[c] + i);
+                qb[c] = P::load(b[c] + i);
+            }
+            auto d = P::mul(qa[0], qb[0]);
+            for (size_t c = 1; c < 4; ++c) d = P::fmadd(qa[c], qb[c], d);
+            auto vt = P::load(t + i);
+            // 点积为负时取 -b, 走最短路径
+            auto wb = P::select_gt(zero, d, P::sub(zero, vt), vt);
+            auto wa = P::sub(one, vt);
+            typename P::reg r[4];
+            auto len2 = zero;
+            for (size_t c = 0; c < 4; ++c) {
+                r[c] = P::fmadd(qb[c], wb, P::mul(qa[c], wa));
+                len2 = P::fmadd(r[c], r[c], len2);
+            }
+            // 长度为 0 时结果保持为 0
+            auto inv = P::select_gt(len2, zero, P::div(one, P::sqrt(len2)), zero);
+            for (size_t c = 0; c < 4; ++c) P::store(out[c] + i, P::mul(r[c], inv));
+        }
+        return i;
+    }
+
+    // SoA 四元数 slerp 内核: theta = atan2(sqrt(1 - c^2), c), 权重由近似 sin 求得 (档位见 FastMath.hpp);
+    // c 超过 kSlerpLinearThreshold 的通道与标量 slerp 一样改用线性权重
+    template<typename P, Accuracy A>
+    size_t batch_quat_slerp(const float* const* a, const float* const* b, const float* t,
+                            float* const* out, size_t i, size_t count) {
+        auto zero = P::zero();
+        auto one = P::set1(1.0f);
+        auto linear = P::set1(kSlerpLinearThreshold);
+        for (; i + P::width <= count; i += P::width) {
+            typename P::reg qa[4], qb[4];
+            for (size_t c = 0; c < 4; ++c) {
+                qa[c] = P::load(a[c] + i);
+                qb[c] = P::load(b[c] + i);
+            }
+            auto d = P::mul(qa[0], qb[0]);
+            for (size_t c = 1; c < 4; ++c) d = P::fmadd(qa[c], qb[c], d);
+            // 点积为负时取 -b, 走最短路径
+            auto cosTheta = P::min(P::select_gt(zero, d, P::sub(zero, d), d), one);
+            auto sinTheta = P::sqrt(P::max(P::sub(one, P::mul(cosTheta, cosTheta)), zero));
+            auto theta = fast_atan2<A, P>(sinTheta, cosTheta);
+
+            auto vt = P::load(t + i);
+            auto ut = P::sub(one, vt);
+            auto invSin = P::div(one, P::max(sinTheta, P::set1(1e-6f)));
+            auto wa = P::mul(fast_sin<A, P>(P::mul(ut, theta)), invSin);
+            auto wb = P::mul(fast_sin<A, P>(P::mul(vt, theta)), invSin);
+            wa = P::select_gt(cosTheta, linear, ut, wa);
+            wb = P::select_gt(cosTheta, linear, vt, wb);
+            wb = P::select_gt(zero, d, P::sub(zero, wb), wb);
+
+            typename P::reg r[4];
+            auto len2 = zero;
+            for (size_t c = 0; c < 4; ++c) {
+                r[c] = P::fmadd(qb[c], wb, P::mul(qa[c], wa));
+                len2 = P::fmadd(r[c], r[c], len2);
+            }
+            // 所有通道都重新归一化, 抵消近似权重的长度误差 (精确权重时只差舍入误差)
+            auto inv = P::select_gt(len2, zero, P::div(one, P::sqrt(len2)), one);
+            for (size_t c = 0; c < 4; ++c) P::store(out[c] + i, P::mul(r[c], inv));
+        }
+        return i;
+    }
+
+    template<Accuracy A>
+    void quat_slerp_soa(const float* const* a, const float* const* b, const float* t, float* const* out, size_t count) {
+        size_t i = batch_quat_slerp<simd::native_t<float>, A>(a, b, t, out, 0, count);
+        batch_quat_slerp<simd::scalar<float>, A>(a, b, t, out, i, count);
+    }
+
+    // AoS 批量 slerp: 每次把 kQuatChunk 个四元数转为栈上的 SoA 分量数组后调用 SoA 内核
+    constexpr size_t kQuatChunk = 64;
+
+    template<typename TAt>
+    void quat_slerp_aos(Span<const Quaternion> a, Span<const Quaternion> b, TAt tAt, Span<Quaternion> out,
+                        Accuracy accuracy) {
+        alignas(64) float buf[13][kQuatChunk];
+        const float* pa[4] = {buf[0], buf[1], buf[2], buf[3]};
+        const float* pb[4] = {buf[4], buf[5], buf[6], buf[7]};
+        float* po[4] = {buf[8], buf[9], buf[10], buf[11]};
+        for (size_t base = 0; base < a.size(); base += kQuatChunk) {
+            size_t n = std::min(kQuatChunk, a.size() - base);
+            for (size_t k = 0; k < n; ++k) {
+                for (size_t c = 0; c < 4; ++c) {
+                    buf[c][k] = a[base + k].data[c];
+                    buf[4 + c][k] = b[base + k].data[c];
+                }
+                buf[12][k] = tAt(base + k);
+            }
+            with_accuracy(accuracy, [&](auto tag) { quat_slerp_soa<tag.value>(pa, pb, buf[12], po, n); });
+            for (size_t k = 0; k < n; ++k) {
+                out[base + k] = Quaternion(buf[8][k], buf[9][k], buf[10][k], buf[11][k]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 批量 nlerp (AoS): out[i] = nlerp(a[i], b[i], t)
+ *
+ * 逐个调用标量 nlerp (每个四元数一次 SSE 运算); 大量混合时用 SoA 版本.
+ * @param out 输出数组, 大小必须与 a/b 相同, 可以与 a 或 b 相同
+ */
+inline void nlerp(Span<const Quaternion> a, Span<const Quaternion> b, float t, Span<Quaternion> out) {
+    detail::check_quat_spans(a.size(), b.size(), out.size());
+    for (size_t i = 0; i < a.size(); ++i) out[i] = nlerp(a[i], b[i], t);
+}
+
+/**
+ * @brief 批量 nlerp (AoS), 每个元素使用各自的插值参数 t[i]
+ */
+inline void nlerp(Span<const Quaternion> a, Span<const Quaternion> b, Span<const float> t, Span<Quaternion> out) {
+    detail::check_quat_spans(a.size(), b.size(), out.size());
+    detail::check_span_size(t.size(), out.size());
+    for (size_t i = 0; i < a.size(); ++i) out[i] = nlerp(a[i], b[i], t[i]);
+}
+
+/**
+ * @brief 批量 slerp (AoS): out[i] = slerp(a[i], b[i], t)
+ *
+ * 分块转为 SoA 后使用与 SoA 版本相同的打包内核.
+ * @param accuracy 角度与权重的近似档位 (见 FastMath.hpp), Exact 逐通道调用 libm
+ */
+inline void slerp(Span<const Quaternion> a, Span<const Quaternion> b, float t, Span<Quaternion> out,
+                  Accuracy accuracy = Accuracy::High) {
+    detail::check_quat_spans(a.size(), b.size(), out.size());
+    detail::quat_slerp_aos(a, b, [t](size_t) { return t; }, out, accuracy);
+}
+
+/**
+ * @brief 批量 slerp (AoS), 每个元素使用各自的插值参数 t[i]
+ */
+inline void slerp(Span<const Quaternion> a, Span<const Quaternion> b, Span<const float> t, Span<Quaternion> out,
+                  Accuracy accuracy = Accuracy::High) {
+    detail::check_quat_spans(a.size(), b.size(), out.size());
+    detail::check_span_size(t.size(), out.size());
+    detail::quat_slerp_aos(a, b, [t](size_t i) { return t[i]; }, out, accuracy);
+}
+
+/**
+ * @brief SoA 批量 nlerp, 四元数以 Vec4Batch 的 (x, y, z, w) 分量存储
+ *
+ * 一次处理 4/8/16 个四元数, 适合对大量骨骼关键帧做混合.
+ * @param t 每个元素的插值参数, 大小必须与 a 相同
+ */
+inline void nlerp(const Vec4Batch& a, const Vec4Batch& b, Span<const float> t, Vec4Batch& out) {
+    using P = simd::native_t<float>;
+    detail::check_batch_size(a, b);
+    detail::check_span_size(t.size(), a.size());
+    out.resize(a.size());
+    const float* pa[4];
+    const float* pb[4];
+    float* po[4];
+    detail::component_pointers(a, pa);
+    detail::component_pointers(b, pb);
+    for (size_t c = 0; c < 4; ++c) po[c] = out.component(c);
+    size_t i = detail::batch_quat_nlerp<P>(pa, pb, t.data(), po, 0, a.size());
+    detail::batch_quat_nlerp<simd::scalar<float>>(pa, pb, t.data(), po, i, a.size());
+}
+
+/**
+ * @brief SoA 批量 slerp
+ *
+ * 夹角与权重用打包的 atan2/sin 近似一次求 4/8/16 个, 接近的四元数退化为 nlerp.
+ * @param accuracy 近似档位 (见 FastMath.hpp): 各分量误差 High 约 1e-6, Low 约 2e-4; Exact 逐通道调用 libm
+ */
+inline void slerp(const Vec4Batch& a, const Vec4Batch& b, Span<const float> t, Vec4Batch& out,
+                  Accuracy accuracy = Accuracy::High) {
+    detail::check_batch_size(a, b);
+    detail::check_span_size(t.size(), a.size());
+    out.resize(a.size());
+    const float* pa[4];
+    const float* pb[4];
+    float* po[4];
+    detail::component_pointers(a, pa);
+    detail::component_pointers(b, pb);
+    for (size_t c = 0; c < 4; ++c) po[c] = out.component(c);
+    detail::with_accuracy(accuracy, [&](auto tag) { detail::quat_slerp_soa<tag.value>(pa, pb, t.data(), po, a.size()); });
+}
+
+} // namespace GameMath
@@ -0,0 +1,315 @@
+/******************************
+ *         随机数生成           *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Dispatch.hpp"
+#include "Span.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+namespace GameMath {
+
+/**
+ * @brief xoshiro128** 伪随机数引擎 (周期 2^128 - 1, 状态 16 字节)
+ *
+ * 满足 UniformRandomBitGenerator 要求, 可直接用于 <random> 中的分布与 std::shuffle.
+ * 同一种子的不同 stream 相隔 2^96 步, 序列互不重叠, 可为每个工作线程分配一条.
+ */
+class Xoshiro128 {
+public:
+    using result_type = uint32_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    explicit Xoshiro128(uint64_t seed = 0, uint64_t stream = 0) { this->seed(seed, stream); }
+
+    /**
+     * @brief 以 SplitMix64 展开种子, 再前进 stream * 2^96 步
+     *
+     * 代价随 stream 线性增长 (每条约 128 次状态更新), 适合线程数量级的 stream.
+     */
+    void seed(uint64_t seed, uint64_t stream = 0) {
+        for (size_t i = 0; i < 4; i += 2) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            m_s[i] = static_cast<uint32_t>(z);
+            m_s[i + 1] = static_cast<uint32_t>(z >> 32);
+        }
+        for (uint64_t i = 0; i < stream; ++i) long_jump();
+    }
+
+    result_type operator()() {
+        uint32_t result = rotl(m_s[1] * 5, 7) * 9;
+        uint32_t t = m_s[1] << 9;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = rotl(m_s[3], 11);
+        return result;
+    }
+
+    // [0, 1) 均匀浮点, 取高 24 位
+    float next_float() { return static_cast<float>((*this)() >> 8) * (1.0f / 16777216.0f); }
+
+    // [0, 1) 均匀双精度, 取两次输出的高 53 位
+    double next_double() {
+        uint64_t bits = (uint64_t((*this)()) << 32) | (*this)();
+        return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief [0, bound) 均匀整数 (Lemire 乘法拒绝法, 无取模偏差, 通常无除法)
+     */
+    uint32_t next_below(uint32_t bound) {
+        uint64_t m = uint64_t((*this)()) * bound;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                m = uint64_t((*this)()) * bound;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // 前进 2^64 步
+    void jump() {
+        static constexpr uint32_t kJump[4] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+        apply_jump(kJump);
+    }
+
+    // 前进 2^96 步
+    void long_jump() {
+        static constexpr uint32_t kLongJump[4] = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+        apply_jump(kLongJump);
+    }
+
+    const uint32_t (&state() const)[4] { return m_s; }
+
+    friend bool operator==(const Xoshiro128& a, const Xoshiro128& b) {
+        return std::equal(a.m_s, a.m_s + 4, b.m_s);
+    }
+    friend bool operator!=(const Xoshiro128& a, const Xoshiro128& b) { return !(a == b); }
+
+private:
+    uint32_t m_s[4];
+
+    static constexpr uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    // 按跳跃多项式累加状态 (参考实现中的 jump/long_jump)
+    void apply_jump(const uint32_t (&poly)[4]) {
+        uint32_t s[4] = {0, 0, 0, 0};
+        for (uint32_t word : poly) {
+            for (int b = 0; b < 32; ++b) {
+                if (word & (1u << b)) {
+                    for (size_t w = 0; w < 4; ++w) s[w] ^= m_s[w];
+                }
+                (*this)();
+            }
+        }
+        std::copy(s, s + 4, m_s);
+    }
+};
+
+namespace detail {
+    // 进程级默认种子, 只取一次 random_device
+    inline uint64_t random_default_seed() {
+        static const uint64_t seed = [] {
+            std::random_device device;
+            return (uint64_t(device()) << 32) | device();
+        }();
+        return seed;
+    }
+
+    // 每个线程首次使用 Random 时领取一个 stream 编号
+    inline uint64_t random_next_stream() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 随机数工具, 每个线程持有独立的引擎 (无锁, 无共享状态)
+ *
+ * 线程首次使用时以进程默认种子和递增的 stream 初始化, 各线程序列互不重叠.
+ * 需要可复现的结果时, 在各工作线程中调用 seed(种子, 线程序号).
+ * fill_* 批量接口使用 16 条独立通道按 SIMD 生成, 与单个接口的序列不同但同样可复现.
+ */
+class Random {
+public:
+    // 批量生成使用的独立通道数
+    static constexpr size_t kLanes = 16;
+
+    // 当前线程的引擎, 可直接配合 <random> 中的分布使用
+    static Xoshiro128& engine() { return thread_state().engine; }
+
+    /**
+     * @brief 重新设定当前线程的种子 (不影响其他线程)
+     *
+     * 相同的 (seed, stream) 总是得到相同的序列 (包括 fill_* 的结果).
+     */
+    static void seed(uint64_t seed, uint64_t stream = 0) { thread_state().reseed(seed, stream); }
+
+    /**
+     * @brief 均匀随机数: 整数取闭区间 [min, max], 浮点取 [min, max)
+     */
+    template<typename T>
+    static T range(T min, T max) {
+        Xoshiro128& rng = engine();
+        if constexpr (std::is_integral_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            uint64_t span = uint64_t(U(U(max) - U(min)));
+            uint64_t offset;
+            if (span < 0xFFFFFFFFull) {
+                offset = rng.next_below(static_cast<uint32_t>(span + 1));
+            } else {
+                offset = below64(rng, span);
+            }
+            return static_cast<T>(U(U(min) + U(offset)));
+        } else {
+            static_assert(std::is_floating_point_v<T>, "Random::range requires an arithmetic type");
+            T u = sizeof(T) > sizeof(float) ? T(rng.next_double()) : T(rng.next_float());
+            T r = min + (max - min) * u;
+            // 舍入可能得到 max 本身
+            return r == max ? std::nextafter(max, min) : r;
+        }
+    }
+
+    /**
+     * @brief 半径为 radius 的圆内均匀分布的点 (拒绝采样, 不调用三角函数)
+     */
+    template<typename T>
+    static Vector<T, 2> in_circle(T radius) {
+        static_assert(std::is_floating_point_v<T>, "Random::in_circle requires a floating point type");
+        T x, y;
+        do {
+            x = range<T>(-1, 1);
+            y = range<T>(-1, 1);
+        } while (x * x + y * y >= T(1));
+        return Vector<T, 2>{x * radius, y * radius};
+    }
+
+    /**
+     * @brief 半径为 radius 的圆周上均匀分布的点
+     */
+    template<typename T>
+    static Vector<T, 2> on_circle(T radius) {
+        static_assert(std::is_floating_point_v<T>, "Random::on_circle requires a floating point type");
+        T x, y, r2;
+        do {
+            x = range<T>(-1, 1);
+            y = range<T>(-1, 1);
+            r2 = x * x + y * y;
+        } while (r2 >= T(1) || r2 <= T(1e-8));
+        T s = radius / std::sqrt(r2);
+        return Vector<T, 2>{x * s, y * s};
+    }
+
+    /******************************
+     *          批量生成            *
+     ******************************/
+
+    /**
+     * @brief 以 [min, max) 均匀随机数填满 out (SIMD, 按运行时检测的 CPU 档位分派)
+     */
+    static void fill_range(Span<float> out, float min, float max) {
+        ThreadState& s = thread_state();
+        const simd::KernelTable& k = simd::kernels();
+        size_t blocks = out.size() / kLanes;
+        k.random_uniform(s.lanes, min, max, out.data(), blocks);
+        size_t done = blocks * kLanes;
+        if (done < out.size()) {
+            alignas(64) float tail[kLanes];
+            k.random_uniform(s.lanes, min, max, tail, 1);
+            std::copy(tail, tail + (out.size() - done), out.data() + done);
+        }
+    }
+
+    /**
+     * @brief 以 [min, max] 均匀整数填满 out
+     *
+     * 整数需要无偏的拒绝采样, 使用当前线程的引擎逐个生成.
+     */
+    static void fill_range(Span<int32_t> out, int32_t min, int32_t max) {
+        Xoshiro128& rng = engine();
+        uint32_t span = uint32_t(max) - uint32_t(min);
+        for (int32_t& v : out) {
+            uint32_t offset = span == 0xFFFFFFFFu ? rng() : rng.next_below(span + 1);
+            v = static_cast<int32_t>(uint32_t(min) + offset);
+        }
+    }
+
+    /**
+     * @brief 以圆内均匀分布的点填满 out (SIMD)
+     */
+    static void fill_in_circle(Span<Vector2f> out, float radius) {
+        if (out.empty()) return;
+        simd::kernels().random_in_circle(thread_state().lanes, radius, components(out), out.size());
+    }
+
+    /**
+     * @brief 以圆周上均匀分布的点填满 out (SIMD)
+     */
+    static void fill_on_circle(Span<Vector2f> out, float radius) {
+        if (out.empty()) return;
+        simd::kernels().random_on_circle(thread_state().lanes, radius, components(out), out.size());
+    }
+
+private:
+    struct ThreadState {
+        Xoshiro128 engine;
+        alignas(64) uint32_t lanes[4][kLanes];  // lanes[字][通道]
+
+        void reseed(uint64_t seed, uint64_t stream) {
+            engine.seed(seed, stream);
+            // 批量通道由引擎逐次 jump 得到, 彼此相隔 2^64 步, 仍在本 stream 的 2^96 步之内
+            Xoshiro128 lane = engine;
+            for (size_t k = 0; k < kLanes; ++k) {
+                lane.jump();
+                for (size_t w = 0; w < 4; ++w) lanes[w][k] = lane.state()[w];
+            }
+        }
+    };
+
+    static ThreadState& thread_state() {
+        thread_local ThreadState state = [] {
+            ThreadState s;
+            s.reseed(detail::random_default_seed(), detail::random_next_stream());
+            return s;
+        }();
+        return state;
+    }
+
+    // span 超过 32 位时的 [0, span] 均匀整数
+    static uint64_t below64(Xoshiro128& rng, uint64_t span) {
+        auto next = [&rng] { return (uint64_t(rng()) << 32) | rng(); };
+        if (span == std::numeric_limits<uint64_t>::max()) return next();
+        uint64_t bound = span + 1;
+        uint64_t threshold = (0 - bound) % bound;
+        uint64_t r;
+        do {
+            r = next();
+        } while (r < threshold);
+        return r % bound;
+    }
+
+    // Vector2f 为两个连续的 float, 批量内核按 (x, y) 交错写入
+    static float* components(Span<Vector2f> out) {
+        static_assert(sizeof(Vector2f) == 2 * sizeof(float), "Vector2f must be two packed floats");
+        return out.data()->data;
+    }
+};
+
+} // namespace GameMath
@@ -0,0 +1,264 @@
+/******************************
+ *      SIMD 打包类型           *
+ ******************************/
+#pragma once
+#include "Config.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace GameMath {
+namespace simd {
+
+// 每个打包类型以静态函数描述一组通道上的运算,
+// 批量内核以打包类型为模板参数, 同一份代码可生成 1/4/8/16 通道版本.
+// ireg 为同宽度的 32 位无符号整数通道, 供随机数生成等位运算使用.
+
+// 标量回退 (也用于处理批量数据的尾部)
+template<typename T>
+struct scalar {
+    using reg = T;
+    static constexpr size_t width = 1;
+
+    static reg load(const T* p) { return *p; }
+    static void store(T* p, reg v) { *p = v; }
+    static reg set1(T s) { return s; }
+    static reg zero() { return T(0); }
+    static reg add(reg a, reg b) { return a + b; }
+    static reg sub(reg a, reg b) { return a - b; }
+    static reg mul(reg a, reg b) { return a * b; }
+    static reg div(reg a, reg b) { return a / b; }
+    static reg fmadd(reg a, reg b, reg c) { return a * b + c; }
+    static reg sqrt(reg a) { return std::sqrt(a); }
+    // a > b ? x : y
+    static reg select_gt(reg a, reg b, reg x, reg y) { return a > b ? x : y; }
+    static reg min(reg a, reg b) { return b < a ? b : a; }
+    static reg max(reg a, reg b) { return a < b ? b : a; }
+    // a >= b 的通道位掩码 (第 k 位对应第 k 个通道)
+    static unsigned mask_ge(reg a, reg b) { return a >= b ? 1u : 0u; }
+    static unsigned mask_gt(reg a, reg b) { return a > b ? 1u : 0u; }
+
+    using ireg = uint32_t;
+    static ireg iload(const uint32_t* p) { return *p; }
+    static void istore(uint32_t* p, ireg v) { *p = v; }
+    static ireg iadd(ireg a, ireg b) { return a + b; }
+    static ireg ixor(ireg a, ireg b) { return a ^ b; }
+    static ireg ior(ireg a, ireg b) { return a | b; }
+    static ireg ishl(ireg a, unsigned k) { return a << k; }
+    static ireg ishr(ireg a, unsigned k) { return a >> k; }
+    static ireg iand(ireg a, ireg b) { return a & b; }
+    static ireg isub(ireg a, ireg b) { return a - b; }
+    static ireg iset1(uint32_t s) { return s; }
+    // 高 24 位转为 [0, 1) 浮点
+    static reg to_unit(ireg a) { return reg(a >> 8) * reg(1.0 / 16777216.0); }
+    // 就近取整为 int32 / int32 转浮点 (整数通道按补码存放)
+    static ireg round_int(reg a) { return static_cast<uint32_t>(static_cast<int32_t>(std::lrint(a))); }
+    static reg to_float(ireg a) { return reg(static_cast<int32_t>(a)); }
+    // 向零取整为 int32
+    static ireg trunc_int(reg a) { return static_cast<uint32_t>(static_cast<int32_t>(a)); }
+    // base[index[k]] (index 为 int32 元素下标)
+    static reg gather(const T* base, ireg index) { return base[static_cast<int32_t>(index)]; }
+    // 按位重新解释 (仅 float)
+    static ireg as_ireg(reg a) {
+        static_assert(sizeof(reg) == sizeof(ireg), "Bit casts require 32-bit lanes");
+        ireg r;
+        std::memcpy(&r, &a, sizeof(r));
+        return r;
+    }
+    static reg as_reg(ireg a) {
+        static_assert(sizeof(reg) == sizeof(ireg), "Bit casts require 32-bit lanes");
+        reg r;
+        std::memcpy(&r, &a, sizeof(r));
+        return r;
+    }
+    // 倒数平方根估计 (SSE 下约 12 位精度, 其他情况为精确值)
+    static reg rsqrt(reg a) {
+#if defined(GM_SIMD_SSE)
+        if constexpr (std::is_same_v<T, float>) return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)));
+#endif
+        return T(1) / std::sqrt(a);
+    }
+};
+
+#if defined(GM_SIMD_SSE)
+// 4通道 (SSE)
+struct f32x4 {
+    using reg = __m128;
+    static constexpr size_t width = 4;
+
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+    static reg set1(float s) { return _mm_set1_ps(s); }
+    static reg zero() { return _mm_setzero_ps(); }
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+    static reg fmadd(reg a, reg b, reg c) {
+#if defined(GM_SIMD_FMA)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+    static reg sqrt(reg a) { return _mm_sqrt_ps(a); }
+    static reg select_gt(reg a, reg b, reg x, reg y) {
+        reg m = _mm_cmpgt_ps(a, b);
+        return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y));
+    }
+    static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+    static unsigned mask_ge(reg a, reg b) { return unsigned(_mm_movemask_ps(_mm_cmpge_ps(a, b))); }
+    static unsigned mask_gt(reg a, reg b) { return unsigned(_mm_movemask_ps(_mm_cmpgt_ps(a, b))); }
+
+    using ireg = __m128i;
+    static ireg iload(const uint32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void istore(uint32_t* p, ireg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static ireg iadd(ireg a, ireg b) { return _mm_add_epi32(a, b); }
+    static ireg ixor(ireg a, ireg b) { return _mm_xor_si128(a, b); }
+    static ireg ior(ireg a, ireg b) { return _mm_or_si128(a, b); }
+    static ireg ishl(ireg a, unsigned k) { return _mm_slli_epi32(a, int(k)); }
+    static ireg ishr(ireg a, unsigned k) { return _mm_srli_epi32(a, int(k)); }
+    static ireg iand(ireg a, ireg b) { return _mm_and_si128(a, b); }
+    static ireg isub(ireg a, ireg b) { return _mm_sub_epi32(a, b); }
+    static ireg iset1(uint32_t s) { return _mm_set1_epi32(int(s)); }
+    static reg to_unit(ireg a) {
+        return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(a, 8)), _mm_set1_ps(1.0f / 16777216.0f));
+    }
+    static ireg round_int(reg a) { return _mm_cvtps_epi32(a); }
+    static reg to_float(ireg a) { return _mm_cvtepi32_ps(a); }
+    static ireg trunc_int(reg a) { return _mm_cvttps_epi32(a); }
+    static reg gather(const float* base, ireg index) {
+        alignas(16) int32_t k[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(k), index);
+        return _mm_setr_ps(base[k[0]], base[k[1]], base[k[2]], base[k[3]]);
+    }
+    static ireg as_ireg(reg a) { return _mm_castps_si128(a); }
+    static reg as_reg(ireg a) { return _mm_castsi128_ps(a); }
+    static reg rsqrt(reg a) { return _mm_rsqrt_ps(a); }
+};
+#endif
+
+#if defined(GM_SIMD_AVX2) || defined(GM_SIMD_DISPATCH)
+GM_TARGET_AVX2_BEGIN
+// 8通道 (AVX2 + FMA)
+struct f32x8 {
+    using reg = __m256;
+    static constexpr size_t width = 8;
+
+    static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+    static reg set1(float s) { return _mm256_set1_ps(s); }
+    static reg zero() { return _mm256_setzero_ps(); }
+    static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+    static reg fmadd(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+    static reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+    static reg select_gt(reg a, reg b, reg x, reg y) {
+        return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_GT_OQ));
+    }
+    static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+    static unsigned mask_ge(reg a, reg b) { return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ))); }
+    static unsigned mask_gt(reg a, reg b) { return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ))); }
+
+    using ireg = __m256i;
+    static ireg iload(const uint32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void istore(uint32_t* p, ireg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static ireg iadd(ireg a, ireg b) { return _mm256_add_epi32(a, b); }
+    static ireg ixor(ireg a, ireg b) { return _mm256_xor_si256(a, b); }
+    static ireg ior(ireg a, ireg b) { return _mm256_or_si256(a, b); }
+    static ireg ishl(ireg a, unsigned k) { return _mm256_slli_epi32(a, int(k)); }
+    static ireg ishr(ireg a, unsigned k) { return _mm256_srli_epi32(a, int(k)); }
+    static ireg iand(ireg a, ireg b) { return _mm256_and_si256(a, b); }
+    static ireg isub(ireg a, ireg b) { return _mm256_sub_epi32(a, b); }
+    static ireg iset1(uint32_t s) { return _mm256_set1_epi32(int(s)); }
+    static reg to_unit(ireg a) {
+        return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(a, 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+    }
+    static ireg round_int(reg a) { return _mm256_cvtps_epi32(a); }
+    static reg to_float(ireg a) { return _mm256_cvtepi32_ps(a); }
+    static ireg trunc_int(reg a) { return _mm256_cvttps_epi32(a); }
+    static reg gather(const float* base, ireg index) { return _mm256_i32gather_ps(base, index, 4); }
+    static ireg as_ireg(reg a) { return _mm256_castps_si256(a); }
+    static reg as_reg(ireg a) { return _mm256_castsi256_ps(a); }
+    static reg rsqrt(reg a) { return _mm256_rsqrt_ps(a); }
+};
+GM_TARGET_END
+#endif
+
+#if defined(GM_SIMD_AVX512) || defined(GM_SIMD_DISPATCH)
+GM_TARGET_AVX512_BEGIN
+// 16通道 (AVX-512)
+struct f32x16 {
+    using reg = __m512;
+    static constexpr size_t width = 16;
+
+    static reg load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm512_storeu_ps(p, v); }
+    static reg set1(float s) { return _mm512_set1_ps(s); }
+    static reg zero() { return _mm512_setzero_ps(); }
+    static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+    static reg fmadd(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+    // 带掩码形式避免 GCC 对 _mm512_undefined_ps 的误报 (-Wmaybe-uninitialized), min/max 同理
+    static reg sqrt(reg a) { return _mm512_mask_sqrt_ps(a, 0xFFFF, a); }
+    static reg select_gt(reg a, reg b, reg x, reg y) {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ), y, x);
+    }
+    static reg min(reg a, reg b) { return _mm512_mask_min_ps(a, 0xFFFF, a, b); }
+    static reg max(reg a, reg b) { return _mm512_mask_max_ps(a, 0xFFFF, a, b); }
+    static unsigned mask_ge(reg a, reg b) { return unsigned(_mm512_cmp_ps_mask(a, b, _CMP_GE_OQ)); }
+    static unsigned mask_gt(reg a, reg b) { return unsigned(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ)); }
+
+    using ireg = __m512i;
+    static ireg iload(const uint32_t* p) { return _mm512_loadu_si512(p); }
+    static void istore(uint32_t* p, ireg v) { _mm512_storeu_si512(p, v); }
+    static ireg iadd(ireg a, ireg b) { return _mm512_add_epi32(a, b); }
+    static ireg ixor(ireg a, ireg b) { return _mm512_xor_si512(a, b); }
+    static ireg ior(ireg a, ireg b) { return _mm512_or_si512(a, b); }
+    static ireg ishl(ireg a, unsigned k) { return _mm512_maskz_slli_epi32(0xFFFF, a, k); }
+    static ireg ishr(ireg a, unsigned k) { return _mm512_maskz_srli_epi32(0xFFFF, a, k); }
+    static ireg iand(ireg a, ireg b) { return _mm512_and_si512(a, b); }
+    static ireg isub(ireg a, ireg b) { return _mm512_sub_epi32(a, b); }
+    static ireg iset1(uint32_t s) { return _mm512_set1_epi32(int(s)); }
+    static reg to_unit(ireg a) {
+        return _mm512_mul_ps(to_float(ishr(a, 8)), _mm512_set1_ps(1.0f / 16777216.0f));
+    }
+    static ireg round_int(reg a) { return _mm512_maskz_cvtps_epi32(0xFFFF, a); }
+    static reg to_float(ireg a) { return _mm512_maskz_cvtepi32_ps(0xFFFF, a); }
+    static ireg trunc_int(reg a) { return _mm512_maskz_cvttps_epi32(0xFFFF, a); }
+    static reg gather(const float* base, ireg index) {
+        return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, index, base, 4);
+    }
+    static ireg as_ireg(reg a) { return _mm512_castps_si512(a); }
+    static reg as_reg(ireg a) { return _mm512_castsi512_ps(a); }
+    // rsqrt14: 约 14 位精度
+    static reg rsqrt(reg a) { return _mm512_maskz_rsqrt14_ps(0xFFFF, a); }
+};
+GM_TARGET_END
+#endif
+
+// 编译期可用的最宽打包类型
+template<typename T>
+struct native { using type = scalar<T>; };
+
+#if defined(GM_SIMD_AVX512)
+template<> struct native<float> { using type = f32x16; };
+#elif defined(GM_SIMD_AVX2) && defined(GM_SIMD_FMA)
+template<> struct native<float> { using type = f32x8; };
+#elif defined(GM_SIMD_SSE)
+template<> struct native<float> { using type = f32x4; };
+#endif
+
+template<typename T>
+using native_t = typename native<T>::type;
+
+} // namespace simd
+} // namespace GameMath
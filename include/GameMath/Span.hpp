@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace GameMath {
+
+/**
+ * @brief 连续内存的非拥有视图 (C++17 下 std::span 的精简替代)
+ *
+ * 可由 指针+长度、C数组 或任意提供 data()/size() 的容器 (如 std::vector) 隐式构造.
+ */
+template<typename T>
+class Span {
+    T* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    // 构造函数
+    constexpr Span() = default;
+
+    constexpr Span(T* data, size_t size) : m_data(data), m_size(size) {}
+
+    template<size_t N>
+    constexpr Span(T (&array)[N]) : m_data(array), m_size(N) {}
+
+    template<typename Container,
+             typename = std::enable_if_t<
+                 !std::is_same_v<std::decay_t<Container>, Span> &&
+                 std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+    constexpr Span(Container&& c) : m_data(c.data()), m_size(c.size()) {}
+
+    // 允许 Span<T> -> Span<const T>
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    constexpr Span(const Span<U>& other) : m_data(other.data()), m_size(other.size()) {}
+
+    // 访问
+    constexpr T* data() const { return m_data; }
+    constexpr size_t size() const { return m_size; }
+    constexpr bool empty() const { return m_size == 0; }
+
+    constexpr T& operator[](size_t index) const { return m_data[index]; }
+
+    constexpr T* begin() const { return m_data; }
+    constexpr T* end() const { return m_data + m_size; }
+
+    // 子视图
+    constexpr Span subspan(size_t offset, size_t count) const {
+        if (offset > m_size || count > m_size - offset) {
+            throw std::out_of_range("Span subspan out of range");
+        }
+        return Span(m_data + offset, count);
+    }
+};
+
+} // namespace GameMath
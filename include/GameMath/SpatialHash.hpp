@@ -0,0 +1,352 @@
+/******************************
+ *    均匀网格空间哈希 (粗检测)    *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Batch.hpp"
+#include "Utility.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace GameMath {
+
+/**
+ * @brief 二维矩形的均匀网格粗检测 (broadphase)
+ *
+ * 矩形以 rect_collision 的约定表示 (左下角 pos 与尺寸 size), 按所覆盖的网格单元分桶,
+ * 只有共享单元的矩形才成为候选对, 避免 O(n²) 的两两检测. 单元坐标经乘法哈希
+ * 映射到开放寻址表, 只为实际占用的单元分配存储.
+ *
+ * 支持增量插入/移动/删除; 移动后仍在原单元范围内时只更新坐标.
+ * 单元尺寸宜与常见物体尺寸相当: 单元过小时大物体会覆盖大量单元, 过大时候选对增多.
+ */
+class SpatialHash {
+public:
+    using Handle = uint32_t;
+    using Pair = std::pair<Handle, Handle>;  // first < second
+    static constexpr Handle kInvalid = std::numeric_limits<Handle>::max();
+
+    /**
+     * @throws std::invalid_argument 当 cellSize 不为正数时
+     */
+    explicit SpatialHash(float cellSize) {
+        if (!(cellSize > 0.0f)) {
+            throw std::invalid_argument("SpatialHash cell size must be positive");
+        }
+        m_cellSize = cellSize;
+        m_invCellSize = 1.0f / cellSize;
+        rehash(64);
+    }
+
+    float cell_size() const { return m_cellSize; }
+
+    // 有效矩形数量
+    size_t size() const { return m_proxies.size() - m_freeHandles.size(); }
+    bool empty() const { return size() == 0; }
+
+    // 已占用 (非空) 的单元数
+    size_t cell_count() const { return m_cells.size() - m_emptyCells; }
+
+    bool valid(Handle h) const {
+        return h < m_proxies.size() && m_proxies[h].alive;
+    }
+
+    Vector2f position(Handle h) const {
+        const Proxy& p = proxy(h);
+        return Vector2f{p.x, p.y};
+    }
+
+    Vector2f size(Handle h) const {
+        const Proxy& p = proxy(h);
+        return Vector2f{p.w, p.h};
+    }
+
+    /**
+     * @brief 插入矩形, 返回句柄 (删除后句柄会被复用)
+     * @throws std::invalid_argument 当位置或尺寸不是有限值时
+     */
+    Handle insert(const Vector2f& pos, const Vector2f& size) {
+        check_rect(pos, size);
+        Handle h;
+        if (!m_freeHandles.empty()) {
+            h = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        } else {
+            h = static_cast<Handle>(m_proxies.size());
+            m_proxies.emplace_back();
+        }
+        Proxy& p = m_proxies[h];
+        p.alive = true;
+        set_rect(p, pos, size);
+        for_cells(p.x0, p.y0, p.x1, p.y1, [&](int32_t cx, int32_t cy) { add_to_cell(cx, cy, h); });
+        return h;
+    }
+
+    /**
+     * @brief 移动矩形 (尺寸不变)
+     * @throws std::invalid_argument 当句柄无效或位置不是有限值时
+     */
+    void move(Handle h, const Vector2f& pos) {
+        const Proxy& p = proxy(h);
+        update(h, pos, Vector2f{p.w, p.h});
+    }
+
+    /**
+     * @brief 更新矩形位置与尺寸, 只增删进出的单元
+     * @throws std::invalid_argument 当句柄无效或位置、尺寸不是有限值时
+     */
+    void update(Handle h, const Vector2f& pos, const Vector2f& size) {
+        Proxy& p = proxy(h);
+        check_rect(pos, size);
+        int32_t ox0 = p.x0, oy0 = p.y0, ox1 = p.x1, oy1 = p.y1;
+        set_rect(p, pos, size);
+        if (p.x0 == ox0 && p.y0 == oy0 && p.x1 == ox1 && p.y1 == oy1) return;
+
+        int32_t nx0 = p.x0, ny0 = p.y0, nx1 = p.x1, ny1 = p.y1;
+        for_cells(ox0, oy0, ox1, oy1, [&](int32_t cx, int32_t cy) {
+            if (!inside(cx, cy, nx0, ny0, nx1, ny1)) remove_from_cell(cx, cy, h);
+        });
+        for_cells(nx0, ny0, nx1, ny1, [&](int32_t cx, int32_t cy) {
+            if (!inside(cx, cy, ox0, oy0, ox1, oy1)) add_to_cell(cx, cy, h);
+        });
+        maybe_prune();
+    }
+
+    void remove(Handle h) {
+        Proxy& p = proxy(h);
+        for_cells(p.x0, p.y0, p.x1, p.y1, [&](int32_t cx, int32_t cy) { remove_from_cell(cx, cy, h); });
+        p.alive = false;
+        m_freeHandles.push_back(h);
+        maybe_prune();
+    }
+
+    void clear() {
+        m_proxies.clear();
+        m_freeHandles.clear();
+        m_cells.clear();
+        m_emptyCells = 0;
+        rehash(64);
+    }
+
+    /**
+     * @brief 查询与矩形相交的所有句柄 (结果追加到 out, 每个句柄只出现一次)
+     */
+    void query(const Vector2f& pos, const Vector2f& size, std::vector<Handle>& out) const {
+        Proxy q;
+        set_rect(q, pos, size);
+        for_cells(q.x0, q.y0, q.x1, q.y1, [&](int32_t cx, int32_t cy) {
+            uint32_t c = find_cell(cx, cy);
+            if (c == kNoCell) return;
+            for (Handle h : m_cells[c].items) {
+                const Proxy& p = m_proxies[h];
+                if (!first_shared_cell(p, q, cx, cy)) continue;
+                if (rect_collision(pos, size, Vector2f{p.x, p.y}, Vector2f{p.w, p.h})) out.push_back(h);
+            }
+        });
+    }
+
+    /**
+     * @brief 粗检测: 所有共享至少一个单元的矩形对 (覆盖 out, 每对只出现一次)
+     */
+    void candidate_pairs(std::vector<Pair>& out) const {
+        out.clear();
+        for (const Cell& cell : m_cells) {
+            const auto& items = cell.items;
+            for (size_t i = 0; i + 1 < items.size(); ++i) {
+                const Proxy& a = m_proxies[items[i]];
+                for (size_t j = i + 1; j < items.size(); ++j) {
+                    const Proxy& b = m_proxies[items[j]];
+                    if (!first_shared_cell(a, b, cell.x, cell.y)) continue;
+                    out.emplace_back(std::min(items[i], items[j]), std::max(items[i], items[j]));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 粗检测后以批量 rect_collision 做精确检测, 返回真正相交的矩形对 (覆盖 out)
+     *
+     * 候选对的矩形先收集为 SoA 形式, 再按 SIMD 通道宽度批量检测; 内部缓冲区在调用间复用.
+     */
+    void colliding_pairs(std::vector<Pair>& out) {
+        candidate_pairs(out);
+        size_t count = out.size();
+        m_pairA.resize(count);
+        m_pairB.resize(count);
+        float* a[4] = {m_pairA.x(), m_pairA.y(), m_pairA.z(), m_pairA.w()};
+        float* b[4] = {m_pairB.x(), m_pairB.y(), m_pairB.z(), m_pairB.w()};
+        for (size_t i = 0; i < count; ++i) {
+            const Proxy& pa = m_proxies[out[i].first];
+            const Proxy& pb = m_proxies[out[i].second];
+            a[0][i] = pa.x; a[1][i] = pa.y; a[2][i] = pa.w; a[3][i] = pa.h;
+            b[0][i] = pb.x; b[1][i] = pb.y; b[2][i] = pb.w; b[3][i] = pb.h;
+        }
+        size_t hits = rect_collision(m_pairA, m_pairB, m_hits);
+        for (size_t i = 0; i < hits; ++i) out[i] = out[m_hits[i]];
+        out.resize(hits);
+    }
+
+private:
+    static constexpr uint32_t kNoCell = std::numeric_limits<uint32_t>::max();
+    // 空单元超过该数量且超过半数时重建哈希表
+    static constexpr size_t kPruneThreshold = 256;
+
+    struct Proxy {
+        float x = 0.0f, y = 0.0f, w = 0.0f, h = 0.0f;
+        int32_t x0 = 0, y0 = 0, x1 = -1, y1 = -1;  // 覆盖的单元范围 (闭区间)
+        bool alive = false;
+    };
+
+    struct Cell {
+        int32_t x, y;
+        std::vector<Handle> items;
+    };
+
+    float m_cellSize = 1.0f;
+    float m_invCellSize = 1.0f;
+    std::vector<Proxy> m_proxies;
+    std::vector<Handle> m_freeHandles;
+    std::vector<Cell> m_cells;
+    std::vector<uint32_t> m_slots;  // 开放寻址表: 单元下标或 kNoCell
+    unsigned m_shift = 58;          // 64 - log2(m_slots.size())
+    size_t m_emptyCells = 0;
+
+    // colliding_pairs 的复用缓冲区
+    Vec4Batch m_pairA, m_pairB;
+    std::vector<uint32_t> m_hits;
+
+    Proxy& proxy(Handle h) {
+        if (!valid(h)) {
+            throw std::invalid_argument("Invalid spatial hash handle");
+        }
+        return m_proxies[h];
+    }
+
+    const Proxy& proxy(Handle h) const {
+        if (!valid(h)) {
+            throw std::invalid_argument("Invalid spatial hash handle");
+        }
+        return m_proxies[h];
+    }
+
+    // 单元坐标的范围: 更远的坐标归入边界单元, 且逐单元遍历时 ++cx 不会溢出
+    static constexpr float kMaxCell = float(1 << 30);
+
+    static void check_rect(const Vector2f& pos, const Vector2f& size) {
+        if (!std::isfinite(pos[0]) || !std::isfinite(pos[1]) || !std::isfinite(size[0]) || !std::isfinite(size[1])) {
+            throw std::invalid_argument("SpatialHash position and size must be finite");
+        }
+    }
+
+    // 截断后再转换, 避免越界或 NaN 转换为整数的未定义行为 (NaN 归入 -kMaxCell)
+    int32_t cell_coord(float v) const {
+        float c = std::floor(v * m_invCellSize);
+        if (!(c >= -kMaxCell)) c = -kMaxCell;
+        if (c > kMaxCell) c = kMaxCell;
+        return static_cast<int32_t>(c);
+    }
+
+    void set_rect(Proxy& p, const Vector2f& pos, const Vector2f& size) const {
+        p.x = pos[0]; p.y = pos[1]; p.w = size[0]; p.h = size[1];
+        p.x0 = cell_coord(p.x);
+        p.y0 = cell_coord(p.y);
+        p.x1 = cell_coord(p.x + p.w);
+        p.y1 = cell_coord(p.y + p.h);
+    }
+
+    template<typename F>
+    static void for_cells(int32_t x0, int32_t y0, int32_t x1, int32_t y1, F&& f) {
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            for (int32_t cx = x0; cx <= x1; ++cx) f(cx, cy);
+        }
+    }
+
+    static bool inside(int32_t cx, int32_t cy, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+        return cx >= x0 && cx <= x1 && cy >= y0 && cy <= y1;
+    }
+
+    // 两个矩形共享的单元中只在左下角那个上报, 避免重复
+    static bool first_shared_cell(const Proxy& a, const Proxy& b, int32_t cx, int32_t cy) {
+        return cx == std::max(a.x0, b.x0) && cy == std::max(a.y0, b.y0);
+    }
+
+    // 乘法 (Fibonacci) 哈希: 取乘积的高位, 相邻单元分散到不同槽位
+    size_t slot_of(int32_t cx, int32_t cy) const {
+        uint64_t key = (uint64_t(uint32_t(cx)) << 32) | uint32_t(cy);
+        return size_t((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    uint32_t find_cell(int32_t cx, int32_t cy) const {
+        size_t mask = m_slots.size() - 1;
+        for (size_t s = slot_of(cx, cy);; s = (s + 1) & mask) {
+            uint32_t c = m_slots[s];
+            if (c == kNoCell) return kNoCell;
+            if (m_cells[c].x == cx && m_cells[c].y == cy) return c;
+        }
+    }
+
+    uint32_t find_or_create_cell(int32_t cx, int32_t cy) {
+        size_t mask = m_slots.size() - 1;
+        size_t s = slot_of(cx, cy);
+        for (;; s = (s + 1) & mask) {
+            uint32_t c = m_slots[s];
+            if (c == kNoCell) break;
+            if (m_cells[c].x == cx && m_cells[c].y == cy) return c;
+        }
+        uint32_t c = static_cast<uint32_t>(m_cells.size());
+        m_cells.push_back(Cell{cx, cy, {}});
+        ++m_emptyCells;
+        m_slots[s] = c;
+        // 负载因子保持在 1/2 以下
+        if (m_cells.size() * 2 > m_slots.size()) rehash(m_slots.size() * 2);
+        return c;
+    }
+
+    void add_to_cell(int32_t cx, int32_t cy, Handle h) {
+        Cell& cell = m_cells[find_or_create_cell(cx, cy)];
+        if (cell.items.empty()) --m_emptyCells;
+        cell.items.push_back(h);
+    }
+
+    void remove_from_cell(int32_t cx, int32_t cy, Handle h) {
+        uint32_t c = find_cell(cx, cy);
+        if (c == kNoCell) return;
+        auto& items = m_cells[c].items;
+        auto it = std::find(items.begin(), items.end(), h);
+        if (it == items.end()) return;
+        *it = items.back();
+        items.pop_back();
+        if (items.empty()) ++m_emptyCells;
+    }
+
+    void rehash(size_t slotCount) {
+        m_slots.assign(slotCount, kNoCell);
+        m_shift = 64;
+        for (size_t n = slotCount; n > 1; n >>= 1) --m_shift;
+        size_t mask = slotCount - 1;
+        for (uint32_t c = 0; c < m_cells.size(); ++c) {
+            size_t s = slot_of(m_cells[c].x, m_cells[c].y);
+            while (m_slots[s] != kNoCell) s = (s + 1) & mask;
+            m_slots[s] = c;
+        }
+    }
+
+    // 物体移动后留下的空单元过多时丢弃空单元并重建哈希表
+    void maybe_prune() {
+        if (m_emptyCells < kPruneThreshold || m_emptyCells * 2 < m_cells.size()) return;
+        m_cells.erase(std::remove_if(m_cells.begin(), m_cells.end(),
+                                     [](const Cell& c) { return c.items.empty(); }),
+                      m_cells.end());
+        m_emptyCells = 0;
+        size_t slots = 64;
+        while (slots < m_cells.size() * 2) slots *= 2;
+        rehash(slots);
+    }
+};
+
+} // namespace GameMath
@@ -0,0 +1,240 @@
+/******************************
+ *         工作窃取线程池          *
+ ******************************/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GameMath {
+
+/**
+ * @brief 数据并行用的工作窃取线程池
+ *
+ * parallel_for 把下标区间均分给各线程; 每个线程从自己区间的前端按 grain 个取任务,
+ * 自己的区间做完后从其他线程区间的后端窃取剩余的一半.
+ * 每个区间以 (begin, end) 两个 32 位下标打包在一个原子量中, 取任务与窃取都只是一次 CAS.
+ * 调用线程也参与执行, size() 为后台线程数 + 1.
+ * 重载了 operator()(count, task), 可直接作为 BVH::build、TransformHierarchy::update、gemm 的 parallelFor 参数.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 创建共 threads 个执行线程的池 (包括调用线程), 0 视为 1
+     */
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<size_t>(threads, 1);
+        m_slots.reset(new Slot[threads]);
+        m_size = threads;
+        m_threads.reserve(threads - 1);
+        for (size_t i = 1; i < threads; ++i) m_threads.emplace_back([this, i] { worker_main(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_threads) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return m_size; }
+
+    // 当前线程在本池中的编号 (发起 parallel_for 的线程为 0), 不在本池任务中时返回 size()
+    size_t current_worker() const {
+        const WorkerTag& t = worker_tag();
+        return t.pool == this ? t.index : m_size;
+    }
+
+    /**
+     * @brief 并行执行 task(i) 或 task(i, worker), i ∈ [0, count), worker ∈ [0, size())
+     *
+     * worker 可用于索引每线程的私有数据 (同一 worker 编号不会被两个线程同时使用).
+     * 所有任务完成后返回; 任务抛出异常时其余线程不再领取新任务, 第一个异常在返回前重新抛出.
+     * 在本池的任务中嵌套调用时在当前线程串行执行.
+     * 多个外部线程同时调用时依次执行.
+     * @throws std::length_error 当 count 不小于 2^32 时
+     */
+    template<typename F>
+    void parallel_for(size_t count, F&& task, size_t grain = 1) {
+        using Task = std::remove_reference_t<F>;
+        if (count == 0) return;
+        if (count > 0xFFFFFFFFull) throw std::length_error("ThreadPool::parallel_for supports fewer than 2^32 tasks");
+        grain = std::max<size_t>(grain, 1);
+
+        WorkerTag& tag = worker_tag();
+        if (tag.pool == this) {
+            invoke_range<Task>(&task, 0, count, tag.index);
+            return;
+        }
+
+        // 外部调用即使串行执行也占用 0 号 worker, 须与其他外部调用互斥
+        std::lock_guard<std::mutex> call(m_call);
+        TagScope scope(tag, WorkerTag{this, 0});
+        if (m_size == 1 || count <= grain) {
+            invoke_range<Task>(&task, 0, count, 0);
+            return;
+        }
+
+        for (size_t k = 0; k < m_size; ++k) {
+            m_slots[k].range.store(pack(count * k / m_size, count * (k + 1) / m_size), std::memory_order_relaxed);
+        }
+        m_invoke = &invoke_range<Task>;
+        m_context = const_cast<void*>(static_cast<const void*>(&task));
+        m_grain = grain;
+        m_failed.store(false, std::memory_order_relaxed);
+        m_error = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active = m_size - 1;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        run_job(0);
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_active == 0; });
+        }
+        if (m_error) std::rethrow_exception(m_error);
+    }
+
+    template<typename F>
+    void operator()(size_t count, F&& task) { parallel_for(count, std::forward<F>(task)); }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> range{0};  // 低 32 位 begin, 高 32 位 end
+    };
+
+    struct WorkerTag {
+        const ThreadPool* pool;
+        size_t index;
+    };
+
+    // 在作用域内把当前线程标记为 tag, 离开时 (包括异常) 恢复
+    struct TagScope {
+        WorkerTag& tag;
+        WorkerTag saved;
+        TagScope(WorkerTag& t, WorkerTag now) : tag(t), saved(t) { tag = now; }
+        ~TagScope() { tag = saved; }
+        TagScope(const TagScope&) = delete;
+        TagScope& operator=(const TagScope&) = delete;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_size = 1;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_call;   // 串行化外部的 parallel_for 调用
+    std::mutex m_mutex;  // 保护以下调度状态
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    uint64_t m_generation = 0;
+    size_t m_active = 0;
+    bool m_stop = false;
+
+    // 当前任务 (在 m_generation 递增前写好, 由互斥量保证对后台线程可见)
+    void (*m_invoke)(void*, size_t, size_t, size_t) = nullptr;
+    void* m_context = nullptr;
+    size_t m_grain = 1;
+    std::atomic<bool> m_failed{false};
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error;
+
+    static WorkerTag& worker_tag() {
+        thread_local WorkerTag tag{nullptr, 0};
+        return tag;
+    }
+
+    static uint64_t pack(uint64_t begin, uint64_t end) { return begin | (end << 32); }
+    static uint32_t range_begin(uint64_t r) { return static_cast<uint32_t>(r); }
+    static uint32_t range_end(uint64_t r) { return static_cast<uint32_t>(r >> 32); }
+
+    template<typename Task>
+    static void invoke_range(void* context, size_t begin, size_t end, size_t worker) {
+        Task& task = *static_cast<Task*>(context);
+        for (size_t i = begin; i < end; ++i) {
+            if constexpr (std::is_invocable_v<Task&, size_t, size_t>) {
+                task(i, worker);
+            } else {
+                task(i);
+            }
+        }
+    }
+
+    void worker_main(size_t index) {
+        worker_tag() = WorkerTag{this, index};
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+            }
+            run_job(index);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_active == 0) m_done.notify_one();
+            }
+        }
+    }
+
+    void run_job(size_t self) {
+        std::atomic<uint64_t>& own = m_slots[self].range;
+        for (;;) {
+            // 从自己区间的前端取任务
+            uint64_t r = own.load(std::memory_order_acquire);
+            while (range_begin(r) < range_end(r)) {
+                if (m_failed.load(std::memory_order_relaxed)) return;
+                uint32_t begin = range_begin(r);
+                uint32_t end = static_cast<uint32_t>(std::min<uint64_t>(range_end(r), begin + m_grain));
+                if (!own.compare_exchange_weak(r, pack(end, range_end(r)), std::memory_order_acq_rel)) continue;
+                try {
+                    m_invoke(m_context, begin, end, self);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m_errorMutex);
+                    if (!m_error) m_error = std::current_exception();
+                    m_failed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                r = own.load(std::memory_order_acquire);
+            }
+            if (!steal(self)) return;
+        }
+    }
+
+    // 从其他线程区间的后端窃取剩余的一半放入自己的区间, 所有区间都空时返回 false
+    bool steal(size_t self) {
+        for (size_t k = 1; k < m_size; ++k) {
+            std::atomic<uint64_t>& victim = m_slots[(self + k) % m_size].range;
+            uint64_t v = victim.load(std::memory_order_acquire);
+            while (range_begin(v) < range_end(v)) {
+                uint32_t remaining = range_end(v) - range_begin(v);
+                uint32_t split = range_end(v) - (remaining + 1) / 2;
+                if (victim.compare_exchange_weak(v, pack(range_begin(v), split), std::memory_order_acq_rel)) {
+                    m_slots[self].range.store(pack(split, range_end(v)), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace GameMath
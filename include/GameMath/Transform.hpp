@@ -0,0 +1,265 @@
+/******************************
+ *         变换层级             *
+ ******************************/
+#pragma once
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace GameMath {
+
+/**
+ * @brief 由平移/旋转/缩放构造变换矩阵 M = T * R * S
+ */
+inline Matrix4x4 compose_trs(const Vector3f& position, const Quaternion& rotation, const Vector3f& scale) noexcept {
+    Matrix3x3 r = rotation.to_matrix3();
+    return Matrix4x4{
+        Vector4f{r(0, 0) * scale.x, r(0, 1) * scale.y, r(0, 2) * scale.z, position.x},
+        Vector4f{r(1, 0) * scale.x, r(1, 1) * scale.y, r(1, 2) * scale.z, position.y},
+        Vector4f{r(2, 0) * scale.x, r(2, 1) * scale.y, r(2, 2) * scale.z, position.z},
+        Vector4f{0.0f, 0.0f, 0.0f, 1.0f}
+    };
+}
+
+/**
+ * @brief 场景变换层级: 局部 TRS 与世界矩阵的扁平存储
+ *
+ * 节点按深度优先先序存放在连续数组中, 每个节点的子树是紧随其后的一段区间,
+ * 父节点总在子节点之前. 修改局部变换只标记节点为脏, update() 时只重算
+ * 脏节点所在的子树; 互不包含的脏子树相互独立, 可以并行处理.
+ *
+ * 节点以句柄 (Handle) 引用, 句柄在插入/删除其他节点后保持不变.
+ * 插入与删除需要移动数组, 代价为 O(节点数), 适合在加载或生成时进行.
+ */
+class TransformHierarchy {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle kInvalid = std::numeric_limits<Handle>::max();
+
+    TransformHierarchy() = default;
+
+    // 节点数量
+    size_t size() const { return m_handle.size(); }
+    bool empty() const { return m_handle.empty(); }
+
+    bool valid(Handle node) const {
+        return node < m_index.size() && m_index[node] != kInvalid;
+    }
+
+    /**
+     * @brief 创建节点, 作为 parent 的最后一个子节点 (parent 为 kInvalid 时为根节点)
+     * @throws std::invalid_argument 当 parent 不是有效句柄时
+     */
+    Handle create(Handle parent = kInvalid, const Vector3f& position = Vector3f::zero(),
+                  const Quaternion& rotation = Quaternion::identity(), const Vector3f& scale = Vector3f::one()) {
+        uint32_t parentIndex = kInvalid;
+        uint32_t pos = static_cast<uint32_t>(size());
+        if (parent != kInvalid) {
+            parentIndex = index_of(parent);
+            pos = parentIndex + m_subtreeSize[parentIndex];
+        }
+
+        Handle handle;
+        if (!m_freeHandles.empty()) {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        } else {
+            handle = static_cast<Handle>(m_index.size());
+            m_index.push_back(kInvalid);
+        }
+
+        m_position.insert(m_position.begin() + pos, position);
+        m_rotation.insert(m_rotation.begin() + pos, rotation);
+        m_scale.insert(m_scale.begin() + pos, scale);
+        m_world.insert(m_world.begin() + pos, Matrix4x4::identity());
+        m_parent.insert(m_parent.begin() + pos, parentIndex);
+        m_subtreeSize.insert(m_subtreeSize.begin() + pos, 1u);
+        m_handle.insert(m_handle.begin() + pos, handle);
+        m_dirty.insert(m_dirty.begin() + pos, uint8_t(1));
+
+        // 插入点之后的节点整体后移一位
+        for (size_t i = pos + 1; i < size(); ++i) {
+            if (m_parent[i] != kInvalid && m_parent[i] >= pos) ++m_parent[i];
+            m_index[m_handle[i]] = static_cast<uint32_t>(i);
+        }
+        m_index[handle] = pos;
+        for (uint32_t a = parentIndex; a != kInvalid; a = m_parent[a]) {
+            ++m_subtreeSize[a];
+        }
+        m_dirtyList.push_back(handle);
+        return handle;
+    }
+
+    /**
+     * @brief 删除节点及其整个子树
+     */
+    void destroy(Handle node) {
+        uint32_t first = index_of(node);
+        uint32_t count = m_subtreeSize[first];
+        uint32_t last = first + count;
+
+        for (uint32_t a = m_parent[first]; a != kInvalid; a = m_parent[a]) {
+            m_subtreeSize[a] -= count;
+        }
+        for (uint32_t i = first; i < last; ++i) {
+            m_index[m_handle[i]] = kInvalid;
+            m_freeHandles.push_back(m_handle[i]);
+        }
+
+        auto erase = [first, last](auto& v) { v.erase(v.begin() + first, v.begin() + last); };
+        erase(m_position);
+        erase(m_rotation);
+        erase(m_scale);
+        erase(m_world);
+        erase(m_parent);
+        erase(m_subtreeSize);
+        erase(m_handle);
+        erase(m_dirty);
+
+        for (size_t i = first; i < size(); ++i) {
+            if (m_parent[i] != kInvalid && m_parent[i] >= last) m_parent[i] -= count;
+            m_index[m_handle[i]] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // 层级查询
+    Handle parent(Handle node) const {
+        uint32_t p = m_parent[index_of(node)];
+        return p == kInvalid ? kInvalid : m_handle[p];
+    }
+
+    // 子树节点数 (包含自身)
+    size_t subtree_size(Handle node) const { return m_subtreeSize[index_of(node)]; }
+
+    // 局部变换读写 (写入会标记节点为脏)
+    const Vector3f& position(Handle node) const { return m_position[index_of(node)]; }
+    const Quaternion& rotation(Handle node) const { return m_rotation[index_of(node)]; }
+    const Vector3f& scale(Handle node) const { return m_scale[index_of(node)]; }
+
+    void set_position(Handle node, const Vector3f& position) {
+        uint32_t i = index_of(node);
+        m_position[i] = position;
+        mark_dirty(i);
+    }
+
+    void set_rotation(Handle node, const Quaternion& rotation) {
+        uint32_t i = index_of(node);
+        m_rotation[i] = rotation;
+        mark_dirty(i);
+    }
+
+    void set_scale(Handle node, const Vector3f& scale) {
+        uint32_t i = index_of(node);
+        m_scale[i] = scale;
+        mark_dirty(i);
+    }
+
+    void set_local(Handle node, const Vector3f& position, const Quaternion& rotation, const Vector3f& scale) {
+        uint32_t i = index_of(node);
+        m_position[i] = position;
+        m_rotation[i] = rotation;
+        m_scale[i] = scale;
+        mark_dirty(i);
+    }
+
+    Matrix4x4 local_matrix(Handle node) const {
+        uint32_t i = index_of(node);
+        return compose_trs(m_position[i], m_rotation[i], m_scale[i]);
+    }
+
+    /**
+     * @brief 世界矩阵 (上次 update() 的结果)
+     */
+    const Matrix4x4& world(Handle node) const { return m_world[index_of(node)]; }
+
+    // 是否有等待 update() 的修改
+    bool dirty() const { return !m_dirtyList.empty(); }
+
+    /**
+     * @brief 重算所有脏子树的世界矩阵
+     *
+     * @param parallelFor 并行调度函数, 约定见 detail::SerialFor.
+     *        每个任务处理一棵互不相交的脏子树, 只读取子树根节点已是最新的父节点.
+     */
+    template<typename ParallelFor>
+    void update(ParallelFor&& parallelFor) {
+        if (m_dirtyList.empty()) return;
+        collect_dirty_roots();
+        parallelFor(m_tasks.size(), [this](size_t task) { update_subtree(m_tasks[task]); });
+        m_dirtyList.clear();
+    }
+
+    // 单线程更新
+    void update() {
+        update(detail::SerialFor());
+    }
+
+    // 上次 update() 重算的子树根节点数, 可用于调整并行粒度
+    size_t last_task_count() const { return m_tasks.size(); }
+
+private:
+    // 按 DFS 顺序存储的节点数据
+    std::vector<Vector3f> m_position;
+    std::vector<Quaternion> m_rotation;
+    std::vector<Vector3f> m_scale;
+    std::vector<Matrix4x4> m_world;
+    std::vector<uint32_t> m_parent;       // 父节点下标, 根节点为 kInvalid
+    std::vector<uint32_t> m_subtreeSize;  // 子树节点数, 包含自身
+    std::vector<Handle> m_handle;         // 下标 -> 句柄
+    std::vector<uint8_t> m_dirty;
+
+    std::vector<uint32_t> m_index;        // 句柄 -> 下标
+    std::vector<Handle> m_freeHandles;
+    std::vector<Handle> m_dirtyList;
+    std::vector<uint32_t> m_tasks;        // 本次更新的脏子树根节点下标
+
+    uint32_t index_of(Handle node) const {
+        if (!valid(node)) {
+            throw std::invalid_argument("Invalid transform handle");
+        }
+        return m_index[node];
+    }
+
+    void mark_dirty(uint32_t index) {
+        if (!m_dirty[index]) {
+            m_dirty[index] = 1;
+            m_dirtyList.push_back(m_handle[index]);
+        }
+    }
+
+    // 脏节点按下标排序后, 去掉已被前一棵脏子树覆盖的节点
+    void collect_dirty_roots() {
+        m_tasks.clear();
+        for (Handle h : m_dirtyList) {
+            if (valid(h) && m_dirty[m_index[h]]) m_tasks.push_back(m_index[h]);
+        }
+        std::sort(m_tasks.begin(), m_tasks.end());
+        m_tasks.erase(std::unique(m_tasks.begin(), m_tasks.end()), m_tasks.end());
+        size_t count = 0;
+        uint32_t coveredEnd = 0;
+        for (uint32_t index : m_tasks) {
+            if (count > 0 && index < coveredEnd) continue;
+            m_tasks[count++] = index;
+            coveredEnd = index + m_subtreeSize[index];
+        }
+        m_tasks.resize(count);
+    }
+
+    // 先序遍历保证父节点先于子节点计算
+    void update_subtree(uint32_t root) {
+        uint32_t end = root + m_subtreeSize[root];
+        for (uint32_t i = root; i < end; ++i) {
+            Matrix4x4 local = compose_trs(m_position[i], m_rotation[i], m_scale[i]);
+            uint32_t p = m_parent[i];
+            m_world[i] = p == kInvalid ? local : m_world[p] * local;
+            m_dirty[i] = 0;
+        }
+    }
+};
+
+} // namespace GameMath
@@ -1,8 +1,12 @@
 #pragma once
 #include "Config.hpp"
+#include "FastMath.hpp"
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 
 namespace GameMath {
 
@@ -10,115 +14,188 @@ namespace GameMath {
 template<typename T, size_t N>
 struct Vector {
     T data[N];
+
+    // 整数除零是未定义行为, 因此整数向量的除法始终检查
+    static constexpr bool kNoThrow = !kChecked && !std::is_integral_v<T>;
     
     // 构造函数
     Vector() = default;
     
-    explicit Vector(T scalar) { fill(scalar); }
+    constexpr explicit Vector(T scalar) : data{} { fill(scalar); }
     
-    Vector(std::initializer_list<T> list) {
+    constexpr Vector(std::initializer_list<T> list) : data{} {
         if (list.size() != N) {
             throw std::invalid_argument("Initializer list size does not match vector dimension");
         }
-        std::copy(list.begin(), list.end(), data);
+        for (size_t i = 0; i < N; ++i) {
+            data[i] = list.begin()[i];
+        }
     }
     
-    // 访问操作符
-    T& operator[](size_t index) { 
-        if (index >= N) throw std::out_of_range("Vector index out of range");
+    // 访问操作符 (GM_CHECKED 为 0 时不检查下标)
+    constexpr T& operator[](size_t index) noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (index >= N) throw std::out_of_range("Vector index out of range");
+        }
         return data[index]; 
     }
     
-    const T& operator[](size_t index) const { 
-        if (index >= N) throw std::out_of_range("Vector index out of range");
+    constexpr const T& operator[](size_t index) const noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (index >= N) throw std::out_of_range("Vector index out of range");
+        }
         return data[index]; 
     }
+
+    // 始终检查下标的访问
+    constexpr T& at(size_t index) {
+        if (index >= N) throw std::out_of_range("Vector index out of range");
+        return data[index];
+    }
+
+    constexpr const T& at(size_t index) const {
+        if (index >= N) throw std::out_of_range("Vector index out of range");
+        return data[index];
+    }
+
+    // 从不检查下标的访问, 供库内部循环使用
+    constexpr T& unchecked(size_t index) noexcept { return data[index]; }
+    constexpr const T& unchecked(size_t index) const noexcept { return data[index]; }
     
     // 数学运算
-    Vector operator+(const Vector& rhs) const {
-        Vector result;
+    constexpr Vector operator+(const Vector& rhs) const noexcept {
+        Vector result{};
         for (size_t i = 0; i < N; ++i) {
-            result[i] = data[i] + rhs[i];
+            result.data[i] = data[i] + rhs.data[i];
         }
         return result;
     }
     
-    Vector operator-(const Vector& rhs) const {
-        Vector result;
+    constexpr Vector operator-(const Vector& rhs) const noexcept {
+        Vector result{};
         for (size_t i = 0; i < N; ++i) {
-            result[i] = data[i] - rhs[i];
+            result.data[i] = data[i] - rhs.data[i];
         }
         return result;
     }
     
-    Vector operator*(T scalar) const {
-        Vector result;
+    constexpr Vector operator*(T scalar) const noexcept {
+        Vector result{};
         for (size_t i = 0; i < N; ++i) {
-            result[i] = data[i] * scalar;
+            result.data[i] = data[i] * scalar;
         }
         return result;
     }
     
-    Vector operator/(T scalar) const {
-        if (scalar == 0) throw std::runtime_error("Division by zero");
-        Vector result;
+    constexpr Vector operator/(T scalar) const noexcept(kNoThrow) {
+        if constexpr (!kNoThrow) {
+            if (scalar == 0) throw std::runtime_error("Division by zero");
+        }
+        Vector result{};
         for (size_t i = 0; i < N; ++i) {
-            result[i] = data[i] / scalar;
+            result.data[i] = data[i] / scalar;
         }
         return result;
     }
     
     // 点积
-    T dot(const Vector& rhs) const {
+    constexpr T dot(const Vector& rhs) const noexcept {
         T result = 0;
         for (size_t i = 0; i < N; ++i) {
-            result += data[i] * rhs[i];
+            result += data[i] * rhs.data[i];
         }
         return result;
     }
     
     // 向量长度
-    T length() const {
+    T length() const noexcept {
         return std::sqrt(length_squared());
     }
     
     // 向量长度平方
-    T length_squared() const {
+    constexpr T length_squared() const noexcept {
         return dot(*this);
     }
     
-    // 归一化向量
-    Vector normalized() const {
+    // 归一化向量 (GM_CHECKED 为 0 时零向量得到 NaN)
+    Vector normalized() const noexcept(kNoThrow) {
         T len = length();
-        if (len == 0) throw std::runtime_error("Cannot normalize zero vector");
+        if constexpr (!kNoThrow) {
+            if (len == 0) throw std::runtime_error("Cannot normalize zero vector");
+        }
         return *this / len;
     }
+
+    // 不抛异常的归一化, 零向量返回 std::nullopt
+    std::optional<Vector> try_normalized() const noexcept {
+        T len = length();
+        if (len == 0) return std::nullopt;
+        Vector result;
+        for (size_t i = 0; i < N; ++i) {
+            result.data[i] = data[i] / len;
+        }
+        return result;
+    }
+
+    // 不抛异常的归一化, 零向量返回 fallback
+    Vector safe_normalized(const Vector& fallback = Vector::zero()) const noexcept {
+        T len = length();
+        if (len == 0) return fallback;
+        Vector result;
+        for (size_t i = 0; i < N; ++i) {
+            result.data[i] = data[i] / len;
+        }
+        return result;
+    }
+
+    // 近似长度与归一化 (精度档位见 FastMath.hpp). 长度平方低于 FLT_MIN (长度约 1e-19) 的向量
+    // 超出 rsqrt 估计值的输入范围, 与零向量一样归一化得到零向量
+    template<Accuracy A = Accuracy::High>
+    T fast_length() const noexcept {
+        static_assert(std::is_same_v<T, float>, "fast_length requires float components");
+        return fast::sqrt<A>(length_squared());
+    }
+
+    template<Accuracy A = Accuracy::High>
+    Vector fast_normalized() const noexcept {
+        static_assert(std::is_same_v<T, float>, "fast_normalized requires float components");
+        T len2 = length_squared();
+        if (!(len2 >= std::numeric_limits<T>::min())) return Vector::zero();
+        T inv = fast::rsqrt<A>(len2);
+        Vector result;
+        for (size_t i = 0; i < N; ++i) {
+            result.data[i] = data[i] * inv;
+        }
+        return result;
+    }
     
     // 填充值
-    void fill(T value) {
-        std::fill(data, data + N, value);
+    constexpr void fill(T value) noexcept {
+        for (size_t i = 0; i < N; ++i) {
+            data[i] = value;
+        }
     }
     
     // 静态方法
-    static Vector zero() {
+    static constexpr Vector zero() noexcept {
         return Vector(T(0));
     }
     
-    static Vector one() {
+    static constexpr Vector one() noexcept {
         return Vector(T(1));
     }
     
     // 比较操作符
-    bool operator==(const Vector& rhs) const {
+    constexpr bool operator==(const Vector& rhs) const noexcept {
         for (size_t i = 0; i < N; ++i) {
-            if (data[i] != rhs[i]) {
+            if (data[i] != rhs.data[i]) {
                 return false;
             }
         }
         return true;
     }
     
-    bool operator!=(const Vector& rhs) const {
+    constexpr bool operator!=(const Vector& rhs) const {
         return !(*this == rhs);
     }
 };
@@ -133,13 +210,13 @@ struct Vector<float, 3> {
     };
     
     // 构造函数
-    Vector() : x(0), y(0), z(0) {}
+    constexpr Vector() : x(0), y(0), z(0) {}
     
-    explicit Vector(float scalar) : x(scalar), y(scalar), z(scalar) {}
+    constexpr explicit Vector(float scalar) : x(scalar), y(scalar), z(scalar) {}
     
-    Vector(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vector(float x, float y, float z) : x(x), y(y), z(z) {}
     
-    Vector(std::initializer_list<float> list) {
+    constexpr Vector(std::initializer_list<float> list) : x(0), y(0), z(0) {
         if (list.size() != 3) {
             throw std::invalid_argument("Initializer list size must be 3");
         }
@@ -149,42 +226,74 @@ struct Vector<float, 3> {
         z = *it;
     }
     
-    // 访问操作符
-    float& operator[](size_t index) { 
-        if (index >= 3) throw std::out_of_range("Vector3 index out of range");
-        return data[index]; 
+    // 访问操作符 (GM_CHECKED 为 0 时不检查下标)
+    constexpr float& operator[](size_t index) noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (index >= 3) throw std::out_of_range("Vector3 index out of range");
+        }
+        return unchecked(index);
     }
     
-    const float& operator[](size_t index) const { 
+    constexpr const float& operator[](size_t index) const noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (index >= 3) throw std::out_of_range("Vector3 index out of range");
+        }
+        return unchecked(index);
+    }
+
+    // 始终检查下标的访问
+    constexpr float& at(size_t index) {
         if (index >= 3) throw std::out_of_range("Vector3 index out of range");
-        return data[index]; 
+        return unchecked(index);
+    }
+
+    constexpr const float& at(size_t index) const {
+        if (index >= 3) throw std::out_of_range("Vector3 index out of range");
+        return unchecked(index);
+    }
+
+    // 从不检查下标的访问; 常量求值时只能读取已初始化的具名分量
+    constexpr float& unchecked(size_t index) noexcept {
+        if (detail::is_constant_evaluated()) {
+            return index == 0 ? x : index == 1 ? y : z;
+        }
+        return data[index];
+    }
+
+    constexpr const float& unchecked(size_t index) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            return index == 0 ? x : index == 1 ? y : z;
+        }
+        return data[index];
     }
     
     // 数学运算
-    Vector operator+(const Vector& rhs) const {
+    constexpr Vector operator+(const Vector& rhs) const noexcept {
         return Vector(x + rhs.x, y + rhs.y, z + rhs.z);
     }
     
-    Vector operator-(const Vector& rhs) const {
+    constexpr Vector operator-(const Vector& rhs) const noexcept {
         return Vector(x - rhs.x, y - rhs.y, z - rhs.z);
     }
     
-    Vector operator*(float scalar) const {
+    constexpr Vector operator*(float scalar) const noexcept {
         return Vector(x * scalar, y * scalar, z * scalar);
     }
     
-    Vector operator/(float scalar) const {
-        if (scalar == 0) throw std::runtime_error("Division by zero");
+    constexpr Vector operator/(float scalar) const noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (scalar == 0) throw std::runtime_error("Division by zero");
+        }
         return Vector(x / scalar, y / scalar, z / scalar);
     }
     
     // 点积
-    float dot(const Vector& rhs) const {
+    constexpr float dot(const Vector& rhs) const noexcept {
         return x * rhs.x + y * rhs.y + z * rhs.z;
     }
     
     // 叉积
-    Vector cross(const Vector& rhs) const {
+    constexpr Vector cross(const Vector& rhs) const noexcept {
         return Vector(
             y * rhs.z - z * rhs.y,
             z * rhs.x - x * rhs.z,
@@ -193,45 +302,278 @@ struct Vector<float, 3> {
     }
     
     // 向量长度
-    float length() const {
+    float length() const noexcept {
         return std::sqrt(length_squared());
     }
     
     // 向量长度平方
-    float length_squared() const {
+    constexpr float length_squared() const noexcept {
         return dot(*this);
     }
     
-    // 归一化向量
-    Vector normalized() const {
+    // 归一化向量 (GM_CHECKED 为 0 时零向量得到 NaN)
+    Vector normalized() const noexcept(!kChecked) {
         float len = length();
-        if (len == 0) throw std::runtime_error("Cannot normalize zero vector");
-        return *this / len;
+        if constexpr (kChecked) {
+            if (len == 0) throw std::runtime_error("Cannot normalize zero vector");
+        }
+        return *this * (1.0f / len);
+    }
+
+    // 不抛异常的归一化, 零向量返回 std::nullopt
+    std::optional<Vector> try_normalized() const noexcept {
+        float len = length();
+        if (len == 0) return std::nullopt;
+        return *this * (1.0f / len);
+    }
+
+    // 不抛异常的归一化, 零向量返回 fallback
+    Vector safe_normalized(const Vector& fallback = Vector::zero()) const noexcept {
+        float len = length();
+        if (len == 0) return fallback;
+        return *this * (1.0f / len);
+    }
+
+    // 近似长度与归一化 (精度档位见 FastMath.hpp). 长度平方低于 FLT_MIN (长度约 1e-19) 的向量
+    // 超出 rsqrt 估计值的输入范围, 与零向量一样归一化得到零向量
+    template<Accuracy A = Accuracy::High>
+    float fast_length() const noexcept {
+        return fast::sqrt<A>(length_squared());
+    }
+
+    template<Accuracy A = Accuracy::High>
+    Vector fast_normalized() const noexcept {
+        float len2 = length_squared();
+        if (!(len2 >= std::numeric_limits<float>::min())) return Vector::zero();
+        return *this * fast::rsqrt<A>(len2);
     }
     
     // 填充值
-    void fill(float value) {
+    constexpr void fill(float value) noexcept {
         x = y = z = value;
     }
     
     // 静态方法
-    static Vector zero() {
+    static constexpr Vector zero() noexcept {
         return Vector(0.0f);
     }
     
-    static Vector one() {
+    static constexpr Vector one() noexcept {
         return Vector(1.0f);
     }
     
     // 比较操作符
-    bool operator==(const Vector& rhs) const {
+    constexpr bool operator==(const Vector& rhs) const noexcept {
         return x == rhs.x && y == rhs.y && z == rhs.z;
     }
     
-    bool operator!=(const Vector& rhs) const {
+    constexpr bool operator!=(const Vector& rhs) const {
+        return !(*this == rhs);
+    }
+};
+
+#if defined(GM_SIMD_SSE)
+namespace detail {
+    // 水平求和: v.x + v.y + v.z + v.w
+    inline float hsum_ps(__m128 v) {
+        __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(v, shuf);
+        shuf = _mm_movehl_ps(shuf, sums);
+        sums = _mm_add_ss(sums, shuf);
+        return _mm_cvtss_f32(sums);
+    }
+}
+
+// 特化优化实现 - Vector4 (SSE)
+// 运行时走 __m128 路径, 常量求值时改用标量分量, 因此同样可用于 constexpr
+template<>
+struct Vector<float, 4> {
+    union {
+        __m128 simd;
+        struct { float x, y, z, w; };
+        struct { float r, g, b, a; };
+        float data[4];
+    };
+
+    // 构造函数
+    constexpr Vector() : x(0), y(0), z(0), w(0) {}
+
+    constexpr explicit Vector(float scalar) : x(scalar), y(scalar), z(scalar), w(scalar) {}
+
+    constexpr Vector(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+    explicit Vector(__m128 v) : simd(v) {}
+
+    constexpr Vector(std::initializer_list<float> list) : x(0), y(0), z(0), w(0) {
+        if (list.size() != 4) {
+            throw std::invalid_argument("Initializer list size must be 4");
+        }
+        auto it = list.begin();
+        x = it[0];
+        y = it[1];
+        z = it[2];
+        w = it[3];
+    }
+
+    // 访问操作符 (GM_CHECKED 为 0 时不检查下标)
+    constexpr float& operator[](size_t index) noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (index >= 4) throw std::out_of_range("Vector4 index out of range");
+        }
+        return unchecked(index);
+    }
+    
+    constexpr const float& operator[](size_t index) const noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (index >= 4) throw std::out_of_range("Vector4 index out of range");
+        }
+        return unchecked(index);
+    }
+
+    // 始终检查下标的访问
+    constexpr float& at(size_t index) {
+        if (index >= 4) throw std::out_of_range("Vector4 index out of range");
+        return unchecked(index);
+    }
+
+    constexpr const float& at(size_t index) const {
+        if (index >= 4) throw std::out_of_range("Vector4 index out of range");
+        return unchecked(index);
+    }
+
+    // 从不检查下标的访问; 常量求值时只能读取已初始化的具名分量
+    constexpr float& unchecked(size_t index) noexcept {
+        if (detail::is_constant_evaluated()) {
+            return index == 0 ? x : index == 1 ? y : index == 2 ? z : w;
+        }
+        return data[index];
+    }
+
+    constexpr const float& unchecked(size_t index) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            return index == 0 ? x : index == 1 ? y : index == 2 ? z : w;
+        }
+        return data[index];
+    }
+
+    // 数学运算
+    constexpr Vector operator+(const Vector& rhs) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            return Vector(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
+        }
+        return Vector(_mm_add_ps(simd, rhs.simd));
+    }
+
+    constexpr Vector operator-(const Vector& rhs) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            return Vector(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
+        }
+        return Vector(_mm_sub_ps(simd, rhs.simd));
+    }
+
+    constexpr Vector operator*(float scalar) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            return Vector(x * scalar, y * scalar, z * scalar, w * scalar);
+        }
+        return Vector(_mm_mul_ps(simd, _mm_set1_ps(scalar)));
+    }
+
+    constexpr Vector operator/(float scalar) const noexcept(!kChecked) {
+        if constexpr (kChecked) {
+            if (scalar == 0) throw std::runtime_error("Division by zero");
+        }
+        if (detail::is_constant_evaluated()) {
+            return Vector(x / scalar, y / scalar, z / scalar, w / scalar);
+        }
+        return Vector(_mm_div_ps(simd, _mm_set1_ps(scalar)));
+    }
+
+    // 点积
+    constexpr float dot(const Vector& rhs) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w;
+        }
+        return detail::hsum_ps(_mm_mul_ps(simd, rhs.simd));
+    }
+
+    // 向量长度
+    float length() const noexcept {
+        return std::sqrt(length_squared());
+    }
+
+    // 向量长度平方
+    constexpr float length_squared() const noexcept {
+        return dot(*this);
+    }
+
+    // 归一化向量 (GM_CHECKED 为 0 时零向量得到 NaN)
+    Vector normalized() const noexcept(!kChecked) {
+        float len = length();
+        if constexpr (kChecked) {
+            if (len == 0) throw std::runtime_error("Cannot normalize zero vector");
+        }
+        return *this * (1.0f / len);
+    }
+
+    // 不抛异常的归一化, 零向量返回 std::nullopt
+    std::optional<Vector> try_normalized() const noexcept {
+        float len = length();
+        if (len == 0) return std::nullopt;
+        return *this * (1.0f / len);
+    }
+
+    // 不抛异常的归一化, 零向量返回 fallback
+    Vector safe_normalized(const Vector& fallback = Vector::zero()) const noexcept {
+        float len = length();
+        if (len == 0) return fallback;
+        return *this * (1.0f / len);
+    }
+
+    // 近似长度与归一化 (精度档位见 FastMath.hpp). 长度平方低于 FLT_MIN (长度约 1e-19) 的向量
+    // 超出 rsqrt 估计值的输入范围, 与零向量一样归一化得到零向量
+    template<Accuracy A = Accuracy::High>
+    float fast_length() const noexcept {
+        return fast::sqrt<A>(length_squared());
+    }
+
+    template<Accuracy A = Accuracy::High>
+    Vector fast_normalized() const noexcept {
+        float len2 = length_squared();
+        if (!(len2 >= std::numeric_limits<float>::min())) return Vector::zero();
+        return *this * fast::rsqrt<A>(len2);
+    }
+
+    // 填充值
+    constexpr void fill(float value) noexcept {
+        if (detail::is_constant_evaluated()) {
+            x = y = z = w = value;
+            return;
+        }
+        simd = _mm_set1_ps(value);
+    }
+
+    // 静态方法
+    static constexpr Vector zero() noexcept {
+        return Vector(0.0f);
+    }
+
+    static constexpr Vector one() noexcept {
+        return Vector(1.0f);
+    }
+
+    // 比较操作符
+    constexpr bool operator==(const Vector& rhs) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w;
+        }
+        return _mm_movemask_ps(_mm_cmpeq_ps(simd, rhs.simd)) == 0xF;
+    }
+
+    constexpr bool operator!=(const Vector& rhs) const {
         return !(*this == rhs);
     }
 };
+#endif
 
 // 常用特化别名
 using Vector2f = Vector<float, 2>;
@@ -243,7 +585,7 @@ using Vector4i = Vector<int, 4>;
 
 // 运算符重载
 template<typename T, size_t N>
-Vector<T, N> operator*(T scalar, const Vector<T, N>& vec) {
+constexpr Vector<T, N> operator*(T scalar, const Vector<T, N>& vec) {
     return vec * scalar;
 }
 
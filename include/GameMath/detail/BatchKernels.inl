@@ -0,0 +1,431 @@
+// 批量内核实现
+//
+// 本文件没有 include guard: Batch.hpp 在 detail 命名空间中包含一次供编译期路径使用,
+// Dispatch.hpp 再在各指令集目标区域内的 detail::tier_* 命名空间中分别包含,
+// 使同一份模板按 SSE2/AVX2/AVX-512 各生成一份代码.
+// 包含前须已包含 Simd.hpp 与 Dispatch.hpp 中的 simd::KernelTable 定义,
+// 且同一命名空间中已包含 detail/FastMath.inl.
+
+// 批量内核: 以打包类型 P 处理 [i, count) 中完整的通道组, 返回未处理部分的起点.
+// 调用方先用最宽的打包类型, 再用 simd::scalar 处理尾部.
+
+template<typename P, typename T>
+size_t batch_add(const T* a, const T* b, T* out, size_t i, size_t count) {
+    for (; i + P::width <= count; i += P::width) {
+        P::store(out + i, P::add(P::load(a + i), P::load(b + i)));
+    }
+    return i;
+}
+
+template<typename P, typename T>
+size_t batch_sub(const T* a, const T* b, T* out, size_t i, size_t count) {
+    for (; i + P::width <= count; i += P::width) {
+        P::store(out + i, P::sub(P::load(a + i), P::load(b + i)));
+    }
+    return i;
+}
+
+template<typename P, typename T>
+size_t batch_scale(const T* a, T s, T* out, size_t i, size_t count) {
+    auto vs = P::set1(s);
+    for (; i + P::width <= count; i += P::width) {
+        P::store(out + i, P::mul(P::load(a + i), vs));
+    }
+    return i;
+}
+
+template<typename P, typename T>
+size_t batch_lerp(const T* a, const T* b, T t, T* out, size_t i, size_t count) {
+    auto vt = P::set1(t);
+    for (; i + P::width <= count; i += P::width) {
+        auto va = P::load(a + i);
+        P::store(out + i, P::fmadd(P::sub(P::load(b + i), va), vt, va));
+    }
+    return i;
+}
+
+template<typename P, size_t N, typename T>
+size_t batch_dot(const T* const* a, const T* const* b, T* out, size_t i, size_t count) {
+    for (; i + P::width <= count; i += P::width) {
+        auto acc = P::mul(P::load(a[0] + i), P::load(b[0] + i));
+        for (size_t c = 1; c < N; ++c) {
+            acc = P::fmadd(P::load(a[c] + i), P::load(b[c] + i), acc);
+        }
+        P::store(out + i, acc);
+    }
+    return i;
+}
+
+template<typename P, size_t N, Accuracy A = Accuracy::Exact, typename T>
+size_t batch_length(const T* const* a, T* out, size_t i, size_t count) {
+    for (; i + P::width <= count; i += P::width) {
+        auto v = P::load(a[0] + i);
+        auto acc = P::mul(v, v);
+        for (size_t c = 1; c < N; ++c) {
+            v = P::load(a[c] + i);
+            acc = P::fmadd(v, v, acc);
+        }
+        P::store(out + i, fast_sqrt<A, P>(acc));
+    }
+    return i;
+}
+
+// 零向量归一化结果为零向量, 不抛出异常. 近似档位下长度平方低于 FLT_MIN 的向量
+// 同样视为零向量 (rsqrt 估计值不支持非规格化数)
+template<typename P, size_t N, Accuracy A = Accuracy::Exact, typename T>
+size_t batch_normalize(const T* const* a, T* const* out, size_t i, size_t count) {
+    auto zero = P::zero();
+    auto tiny = A == Accuracy::Exact ? zero : P::set1(std::numeric_limits<T>::min());
+    for (; i + P::width <= count; i += P::width) {
+        typename P::reg v[N];
+        v[0] = P::load(a[0] + i);
+        auto acc = P::mul(v[0], v[0]);
+        for (size_t c = 1; c < N; ++c) {
+            v[c] = P::load(a[c] + i);
+            acc = P::fmadd(v[c], v[c], acc);
+        }
+        auto inv = P::select_gt(acc, tiny, fast_rsqrt<A, P>(acc), zero);
+        for (size_t c = 0; c < N; ++c) {
+            P::store(out[c] + i, P::mul(v[c], inv));
+        }
+    }
+    return i;
+}
+
+// 批量点变换: out = (M * [in, w]).xyz, Divide 为真时再除以齐次分量
+template<typename P, bool Divide, typename T>
+size_t batch_transform3(const T (&m)[4][4], T w, const T* const* in, T* const* out,
+                        size_t i, size_t count) {
+    constexpr size_t outRows = Divide ? 4 : 3;
+    typename P::reg mr[4][3];
+    typename P::reg mw[4];
+    for (size_t r = 0; r < outRows; ++r) {
+        for (size_t c = 0; c < 3; ++c) mr[r][c] = P::set1(m[r][c]);
+        mw[r] = P::set1(m[r][3] * w);
+    }
+    for (; i + P::width <= count; i += P::width) {
+        auto x = P::load(in[0] + i);
+        auto y = P::load(in[1] + i);
+        auto z = P::load(in[2] + i);
+        typename P::reg o[4];
+        for (size_t r = 0; r < outRows; ++r) {
+            o[r] = P::fmadd(mr[r][0], x, P::fmadd(mr[r][1], y, P::fmadd(mr[r][2], z, mw[r])));
+        }
+        if constexpr (Divide) {
+            auto inv = P::div(P::set1(T(1)), o[3]);
+            for (size_t r = 0; r < 3; ++r) o[r] = P::mul(o[r], inv);
+        }
+        for (size_t r = 0; r < 3; ++r) P::store(out[r] + i, o[r]);
+    }
+    return i;
+}
+
+// 批量视锥剔除: planes 为 6 个 (nx, ny, nz, d) 平面, 法线指向视锥内部.
+// 物体在所有平面的内侧距离 (中心距离 + 投影半径) 的最小值不小于 0 时可见,
+// 可见物体的下标按原顺序写入 out[visible...]. Sphere 为真时 extent[0] 是半径.
+template<typename P, bool Sphere, typename T>
+size_t batch_cull(const T (&planes)[6][4], const T* const* center, const T* const* extent,
+                  uint32_t* out, size_t& visible, size_t i, size_t count) {
+    typename P::reg pn[6][3];
+    typename P::reg pa[6][3];
+    typename P::reg pd[6];
+    for (size_t p = 0; p < 6; ++p) {
+        for (size_t c = 0; c < 3; ++c) {
+            pn[p][c] = P::set1(planes[p][c]);
+            pa[p][c] = P::set1(std::fabs(planes[p][c]));
+        }
+        pd[p] = P::set1(planes[p][3]);
+    }
+    auto zero = P::zero();
+    for (; i + P::width <= count; i += P::width) {
+        auto x = P::load(center[0] + i);
+        auto y = P::load(center[1] + i);
+        auto z = P::load(center[2] + i);
+        auto ex = P::load(extent[0] + i);
+        auto ey = Sphere ? ex : P::load(extent[1] + i);
+        auto ez = Sphere ? ex : P::load(extent[2] + i);
+        auto distance = [&](size_t p) {
+            auto d = P::fmadd(pn[p][0], x, P::fmadd(pn[p][1], y, P::fmadd(pn[p][2], z, pd[p])));
+            if constexpr (Sphere) {
+                return P::add(d, ex);
+            } else {
+                return P::fmadd(pa[p][0], ex, P::fmadd(pa[p][1], ey, P::fmadd(pa[p][2], ez, d)));
+            }
+        };
+        auto nearest = distance(0);
+        for (size_t p = 1; p < 6; ++p) nearest = P::min(nearest, distance(p));
+        // 无分支压缩: 每个通道都写入, 只有可见通道推进写位置
+        unsigned mask = P::mask_ge(nearest, zero);
+        for (size_t k = 0; k < P::width; ++k) {
+            out[visible] = static_cast<uint32_t>(i + k);
+            visible += (mask >> k) & 1u;
+        }
+    }
+    return i;
+}
+
+// 批量矩形相交 (与 rect_collision 相同的开区间判定), a/b 为 x, y, w, h 四个分量数组,
+// 相交的下标按原顺序写入 out[hits...]
+template<typename P, typename T>
+size_t batch_rect_overlap(const T* const* a, const T* const* b, uint32_t* out, size_t& hits,
+                          size_t i, size_t count) {
+    for (; i + P::width <= count; i += P::width) {
+        auto ax = P::load(a[0] + i);
+        auto ay = P::load(a[1] + i);
+        auto bx = P::load(b[0] + i);
+        auto by = P::load(b[1] + i);
+        unsigned mask = P::mask_gt(P::add(bx, P::load(b[2] + i)), ax) &
+                        P::mask_gt(P::add(ax, P::load(a[2] + i)), bx) &
+                        P::mask_gt(P::add(by, P::load(b[3] + i)), ay) &
+                        P::mask_gt(P::add(ay, P::load(a[3] + i)), by);
+        for (size_t k = 0; k < P::width; ++k) {
+            out[hits] = static_cast<uint32_t>(i + k);
+            hits += (mask >> k) & 1u;
+        }
+    }
+    return i;
+}
+
+// 批量均匀随机数: state[w][k] 为 16 条 xoshiro128** 通道的状态,
+// out[b * 16 + k] = lo + (hi - lo) * u 取自通道 k 的第 b 个输出 (u 在 [0, 1) 内), 共 blocks 组.
+// 舍入可能使结果恰好等于 hi, 此时取 hi 向 lo 方向的相邻值, 保持半开区间.
+// 各档位按通道分组处理, 生成的整数序列完全相同.
+template<typename P>
+void batch_random_uniform(uint32_t (&state)[4][16], float lo, float hi, float* out, size_t blocks) {
+    static_assert(16 % P::width == 0, "Random lanes must be a multiple of the pack width");
+    using ireg = typename P::ireg;
+    // 带捕获的 lambda 不生成函数指针转换, 避免 GCC 对向量参数的 -Wpsabi 警告
+    auto rotl = [&](ireg x, unsigned k) { return P::ior(P::ishl(x, k), P::ishr(x, 32 - k)); };
+    // xoshiro128** 前进一步; 乘 5 与乘 9 以移位加法实现 (SSE2 没有 32 位整数乘法)
+    auto next = [&rotl](ireg (&s)[4]) {
+        ireg r = rotl(P::iadd(P::ishl(s[1], 2), s[1]), 7);
+        ireg result = P::iadd(P::ishl(r, 3), r);
+        ireg t = P::ishl(s[1], 9);
+        s[2] = P::ixor(s[2], s[0]);
+        s[3] = P::ixor(s[3], s[1]);
+        s[1] = P::ixor(s[1], s[2]);
+        s[0] = P::ixor(s[0], s[3]);
+        s[2] = P::ixor(s[2], t);
+        s[3] = rotl(s[3], 11);
+        return result;
+    };
+    auto vlo = P::set1(lo);
+    auto vscale = P::set1(hi - lo);
+    auto vlast = P::set1(std::nextafter(hi, lo));
+    const bool ascending = hi >= lo;
+    for (size_t g = 0; g < 16; g += P::width) {
+        ireg s[4];
+        for (size_t w = 0; w < 4; ++w) s[w] = P::iload(state[w] + g);
+        for (size_t b = 0; b < blocks; ++b) {
+            auto r = P::fmadd(P::to_unit(next(s)), vscale, vlo);
+            P::store(out + b * 16 + g, ascending ? P::min(r, vlast) : P::max(r, vlast));
+        }
+        for (size_t w = 0; w < 4; ++w) P::istore(state[w] + g, s[w]);
+    }
+}
+
+// 批量圆内 / 圆周采样 (拒绝采样, 无三角函数): 在 [-1, 1)^2 中生成候选点, 保留单位圆内的点,
+// OnCircle 为真时再除以长度投影到圆周. 结果乘以 radius 后按 (x, y) 交错写入 out, 共 count 个点.
+template<typename P, bool OnCircle>
+void batch_random_disc(uint32_t (&state)[4][16], float radius, float* out, size_t count) {
+    constexpr size_t kBlocks = 16;  // 每轮 256 个候选点, 约 79% 被接受
+    alignas(64) float cx[kBlocks * 16];
+    alignas(64) float cy[kBlocks * 16];
+    auto one = P::set1(1.0f);
+    auto tiny = P::set1(1e-8f);  // 过于接近原点的候选点投影方向不稳定
+    auto vr = P::set1(radius);
+    size_t n = 0;
+    while (n < count) {
+        batch_random_uniform<P>(state, -1.0f, 1.0f, cx, kBlocks);
+        batch_random_uniform<P>(state, -1.0f, 1.0f, cy, kBlocks);
+        for (size_t i = 0; i < kBlocks * 16 && n < count; i += P::width) {
+            auto x = P::load(cx + i);
+            auto y = P::load(cy + i);
+            auto r2 = P::fmadd(x, x, P::mul(y, y));
+            unsigned mask = P::mask_gt(one, r2);
+            auto scale = vr;
+            if constexpr (OnCircle) {
+                mask &= P::mask_gt(r2, tiny);
+                scale = P::div(vr, P::sqrt(r2));
+            }
+            P::store(cx + i, P::mul(x, scale));
+            P::store(cy + i, P::mul(y, scale));
+            if (count - n >= P::width) {
+                // 无分支压缩, 同 batch_cull
+                for (size_t k = 0; k < P::width; ++k) {
+                    out[2 * n] = cx[i + k];
+                    out[2 * n + 1] = cy[i + k];
+                    n += (mask >> k) & 1u;
+                }
+            } else {
+                for (size_t k = 0; k < P::width && n < count; ++k) {
+                    if ((mask >> k) & 1u) {
+                        out[2 * n] = cx[i + k];
+                        out[2 * n + 1] = cy[i + k];
+                        ++n;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 逐元素近似数学函数, b 只在 Atan2 时使用 (out = atan2(a, b))
+template<typename P, simd::MathOp Op, Accuracy A>
+size_t batch_math(const float* a, const float* b, float* out, size_t i, size_t count) {
+    for (; i + P::width <= count; i += P::width) {
+        auto x = P::load(a + i);
+        typename P::reg r;
+        if constexpr (Op == simd::MathOp::Sqrt) {
+            r = fast_sqrt<A, P>(x);
+        } else if constexpr (Op == simd::MathOp::Rsqrt) {
+            r = fast_rsqrt<A, P>(x);
+        } else if constexpr (Op == simd::MathOp::Sin) {
+            r = fast_sin<A, P>(x);
+        } else if constexpr (Op == simd::MathOp::Cos) {
+            r = fast_cos<A, P>(x);
+        } else if constexpr (Op == simd::MathOp::Atan2) {
+            r = fast_atan2<A, P>(x, P::load(b + i));
+        } else {
+            r = fast_exp<A, P>(x);
+        }
+        P::store(out + i, r);
+    }
+    return i;
+}
+
+// 分派入口: 以打包类型 P 处理主体, simd::scalar 处理尾部
+template<typename P>
+void transform3_entry(const float (&m)[4][4], float w, const float* const* in, float* const* out, size_t count) {
+    size_t i = batch_transform3<P, false>(m, w, in, out, 0, count);
+    batch_transform3<simd::scalar<float>, false>(m, w, in, out, i, count);
+}
+
+template<typename P>
+void transform3_projected_entry(const float (&m)[4][4], float w, const float* const* in, float* const* out, size_t count) {
+    size_t i = batch_transform3<P, true>(m, w, in, out, 0, count);
+    batch_transform3<simd::scalar<float>, true>(m, w, in, out, i, count);
+}
+
+template<typename P>
+void dot3_entry(const float* const* a, const float* const* b, float* out, size_t count) {
+    size_t i = batch_dot<P, 3>(a, b, out, 0, count);
+    batch_dot<simd::scalar<float>, 3>(a, b, out, i, count);
+}
+
+template<typename P, Accuracy A>
+void length3_run(const float* const* a, float* out, size_t count) {
+    size_t i = batch_length<P, 3, A>(a, out, 0, count);
+    batch_length<simd::scalar<float>, 3, A>(a, out, i, count);
+}
+
+template<typename P>
+void length3_entry(const float* const* a, float* out, size_t count, Accuracy accuracy) {
+    switch (accuracy) {
+        case Accuracy::High: return length3_run<P, Accuracy::High>(a, out, count);
+        case Accuracy::Low: return length3_run<P, Accuracy::Low>(a, out, count);
+        default: return length3_run<P, Accuracy::Exact>(a, out, count);
+    }
+}
+
+template<typename P, Accuracy A>
+void normalize3_run(const float* const* a, float* const* out, size_t count) {
+    size_t i = batch_normalize<P, 3, A>(a, out, 0, count);
+    batch_normalize<simd::scalar<float>, 3, A>(a, out, i, count);
+}
+
+template<typename P>
+void normalize3_entry(const float* const* a, float* const* out, size_t count, Accuracy accuracy) {
+    switch (accuracy) {
+        case Accuracy::High: return normalize3_run<P, Accuracy::High>(a, out, count);
+        case Accuracy::Low: return normalize3_run<P, Accuracy::Low>(a, out, count);
+        default: return normalize3_run<P, Accuracy::Exact>(a, out, count);
+    }
+}
+
+template<typename P>
+size_t cull_aabb_entry(const float (&planes)[6][4], const float* const* center, const float* const* extent,
+                       uint32_t* out, size_t count) {
+    size_t visible = 0;
+    size_t i = batch_cull<P, false>(planes, center, extent, out, visible, 0, count);
+    batch_cull<simd::scalar<float>, false>(planes, center, extent, out, visible, i, count);
+    return visible;
+}
+
+template<typename P>
+size_t cull_sphere_entry(const float (&planes)[6][4], const float* const* center, const float* radius,
+                         uint32_t* out, size_t count) {
+    size_t visible = 0;
+    size_t i = batch_cull<P, true>(planes, center, &radius, out, visible, 0, count);
+    batch_cull<simd::scalar<float>, true>(planes, center, &radius, out, visible, i, count);
+    return visible;
+}
+
+template<typename P>
+size_t rect_overlap_entry(const float* const* a, const float* const* b, uint32_t* out, size_t count) {
+    size_t hits = 0;
+    size_t i = batch_rect_overlap<P>(a, b, out, hits, 0, count);
+    batch_rect_overlap<simd::scalar<float>>(a, b, out, hits, i, count);
+    return hits;
+}
+
+// 随机数内核以 16 组为单位, 各档位宽度都整除 16, 没有尾部
+template<typename P>
+void random_uniform_entry(uint32_t (&state)[4][16], float lo, float hi, float* out, size_t blocks) {
+    batch_random_uniform<P>(state, lo, hi, out, blocks);
+}
+
+template<typename P>
+void random_in_circle_entry(uint32_t (&state)[4][16], float radius, float* out, size_t count) {
+    batch_random_disc<P, false>(state, radius, out, count);
+}
+
+template<typename P>
+void random_on_circle_entry(uint32_t (&state)[4][16], float radius, float* out, size_t count) {
+    batch_random_disc<P, true>(state, radius, out, count);
+}
+
+template<typename P, simd::MathOp Op, Accuracy A>
+void math_run(const float* a, const float* b, float* out, size_t count) {
+    size_t i = batch_math<P, Op, A>(a, b, out, 0, count);
+    batch_math<simd::scalar<float>, Op, A>(a, b, out, i, count);
+}
+
+template<typename P, simd::MathOp Op>
+void math_op_entry(Accuracy accuracy, const float* a, const float* b, float* out, size_t count) {
+    switch (accuracy) {
+        case Accuracy::High: return math_run<P, Op, Accuracy::High>(a, b, out, count);
+        case Accuracy::Low: return math_run<P, Op, Accuracy::Low>(a, b, out, count);
+        default: return math_run<P, Op, Accuracy::Exact>(a, b, out, count);
+    }
+}
+
+template<typename P>
+void math_entry(simd::MathOp op, Accuracy accuracy, const float* a, const float* b, float* out, size_t count) {
+    switch (op) {
+        case simd::MathOp::Sqrt: return math_op_entry<P, simd::MathOp::Sqrt>(accuracy, a, b, out, count);
+        case simd::MathOp::Rsqrt: return math_op_entry<P, simd::MathOp::Rsqrt>(accuracy, a, b, out, count);
+        case simd::MathOp::Sin: return math_op_entry<P, simd::MathOp::Sin>(accuracy, a, b, out, count);
+        case simd::MathOp::Cos: return math_op_entry<P, simd::MathOp::Cos>(accuracy, a, b, out, count);
+        case simd::MathOp::Atan2: return math_op_entry<P, simd::MathOp::Atan2>(accuracy, a, b, out, count);
+        case simd::MathOp::Exp: return math_op_entry<P, simd::MathOp::Exp>(accuracy, a, b, out, count);
+    }
+}
+
+template<typename P>
+constexpr simd::KernelTable make_kernel_table() {
+    return simd::KernelTable{
+        &transform3_entry<P>,
+        &transform3_projected_entry<P>,
+        &dot3_entry<P>,
+        &length3_entry<P>,
+        &normalize3_entry<P>,
+        &cull_aabb_entry<P>,
+        &cull_sphere_entry<P>,
+        &rect_overlap_entry<P>,
+        &random_uniform_entry<P>,
+        &random_in_circle_entry<P>,
+        &random_on_circle_entry<P>,
+        &math_entry<P>,
+    };
+}
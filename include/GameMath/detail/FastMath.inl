@@ -0,0 +1,179 @@
+// 近似数学函数实现 (以打包类型 P 为模板参数)
+//
+// 与 BatchKernels.inl 相同, 本文件没有 include guard: FastMath.hpp 在 detail 命名空间中包含一次,
+// Dispatch.hpp 再在各指令集目标区域内的 detail::tier_* 命名空间中分别包含.
+// 包含前须已包含 Simd.hpp 并定义 Accuracy.
+//
+// 误差 (float, 与双精度 libm 比较):
+//   rsqrt  High 约 3e-7 相对误差 (一次牛顿迭代), Low 为硬件估计值, 约 3e-4;
+//          输入须为正规数 (>= FLT_MIN), 非规格化数的硬件估计值为 inf, 牛顿迭代后得到 NaN
+//   sqrt   High 与 Exact 相同 (硬件开方本身已足够快), Low 为 x * rsqrt 估计值, 约 3e-4
+//   sin/cos  High 约 1e-7 绝对误差, Low 约 3e-4; |x| <= 8192 时有效
+//   atan2  High 约 3e-7 弧度, Low 约 1.5e-3 弧度
+//   exp    High 约 1e-7 相对误差, Low 约 6e-5; 输入截断到 [-87.3, 88.37]
+
+// 按通道调用标量函数 (Exact 档位)
+template<typename P, typename F>
+typename P::reg fast_per_lane(typename P::reg x, F f) {
+    alignas(64) float v[P::width];
+    P::store(v, x);
+    for (size_t k = 0; k < P::width; ++k) v[k] = f(v[k]);
+    return P::load(v);
+}
+
+// m 为全 1 的通道取 x, 否则取 y
+template<typename P>
+typename P::reg fast_blend(typename P::ireg m, typename P::reg x, typename P::reg y) {
+    auto bx = P::as_ireg(x);
+    auto by = P::as_ireg(y);
+    return P::as_reg(P::ixor(by, P::iand(P::ixor(bx, by), m)));
+}
+
+template<Accuracy A, typename P>
+typename P::reg fast_rsqrt(typename P::reg x) {
+    if constexpr (A == Accuracy::Exact) {
+        return P::div(P::set1(1.0f), P::sqrt(x));
+    } else if constexpr (A == Accuracy::Low) {
+        return P::rsqrt(x);
+    } else {
+        // 牛顿迭代 y' = y * (1.5 - 0.5 * x * y * y)
+        auto y = P::rsqrt(x);
+        auto t = P::mul(P::mul(P::mul(P::set1(0.5f), x), y), y);
+        return P::mul(y, P::sub(P::set1(1.5f), t));
+    }
+}
+
+// x <= 0 时结果为 0; Low 档位对非规格化的 x 也返回 0
+template<Accuracy A, typename P>
+typename P::reg fast_sqrt(typename P::reg x) {
+    if constexpr (A == Accuracy::Low) {
+        auto zero = P::zero();
+        return P::select_gt(x, P::set1(std::numeric_limits<float>::min()), P::mul(x, P::rsqrt(x)), zero);
+    } else {
+        return P::sqrt(x);
+    }
+}
+
+// 同时求 sin 与 cos: 以 pi/2 为周期做 Cody-Waite 约减, 在 [-pi/4, pi/4] 上用多项式逼近
+template<Accuracy A, typename P>
+void fast_sincos(typename P::reg x, typename P::reg& s, typename P::reg& c) {
+    if constexpr (A == Accuracy::Exact) {
+        s = fast_per_lane<P>(x, [](float v) { return std::sin(v); });
+        c = fast_per_lane<P>(x, [](float v) { return std::cos(v); });
+    } else {
+        auto q = P::round_int(P::mul(x, P::set1(0.636619772367581343f)));  // 2 / pi
+        auto qf = P::to_float(q);
+        // pi/2 拆成三段, 乘积在 float 中精确
+        auto r = P::fmadd(qf, P::set1(-1.5703125f), x);
+        r = P::fmadd(qf, P::set1(-4.837512969970703125e-4f), r);
+        r = P::fmadd(qf, P::set1(-7.54978995489188216e-8f), r);
+        auto r2 = P::mul(r, r);
+        auto one = P::set1(1.0f);
+        typename P::reg ps, pc;
+        if constexpr (A == Accuracy::High) {
+            // Cephes sinf/cosf 系数
+            ps = P::fmadd(P::set1(-1.9515295891e-4f), r2, P::set1(8.3321608736e-3f));
+            ps = P::fmadd(ps, r2, P::set1(-1.6666654611e-1f));
+            ps = P::fmadd(ps, P::mul(r2, r), r);
+            pc = P::fmadd(P::set1(2.443315711809948e-5f), r2, P::set1(-1.388731625493765e-3f));
+            pc = P::fmadd(pc, r2, P::set1(4.166664568298827e-2f));
+            pc = P::fmadd(pc, P::mul(r2, r2), P::fmadd(P::set1(-0.5f), r2, one));
+        } else {
+            // 泰勒展开截断
+            ps = P::fmadd(P::fmadd(P::set1(1.0f / 120.0f), r2, P::set1(-1.0f / 6.0f)), P::mul(r2, r), r);
+            pc = P::fmadd(P::fmadd(P::set1(1.0f / 24.0f), r2, P::set1(-0.5f)), r2, one);
+        }
+        // 象限 q & 3: sin = [ps, pc, -ps, -pc], cos = [pc, -ps, -pc, ps]
+        auto odd = P::isub(P::iset1(0), P::iand(q, P::iset1(1)));
+        auto two = P::iset1(2);
+        auto sinSign = P::ishl(P::iand(q, two), 30);
+        auto cosSign = P::ishl(P::iand(P::iadd(q, P::iset1(1)), two), 30);
+        s = P::as_reg(P::ixor(P::as_ireg(fast_blend<P>(odd, pc, ps)), sinSign));
+        c = P::as_reg(P::ixor(P::as_ireg(fast_blend<P>(odd, ps, pc)), cosSign));
+    }
+}
+
+template<Accuracy A, typename P>
+typename P::reg fast_sin(typename P::reg x) {
+    typename P::reg s, c;
+    fast_sincos<A, P>(x, s, c);
+    return s;
+}
+
+template<Accuracy A, typename P>
+typename P::reg fast_cos(typename P::reg x) {
+    typename P::reg s, c;
+    fast_sincos<A, P>(x, s, c);
+    return c;
+}
+
+// 在 [0, 1] 上逼近 atan(t) 后按八分区展开; atan2(0, 0) 为 0
+template<Accuracy A, typename P>
+typename P::reg fast_atan2(typename P::reg y, typename P::reg x) {
+    if constexpr (A == Accuracy::Exact) {
+        alignas(64) float vy[P::width];
+        alignas(64) float vx[P::width];
+        P::store(vy, y);
+        P::store(vx, x);
+        for (size_t k = 0; k < P::width; ++k) vy[k] = std::atan2(vy[k], vx[k]);
+        return P::load(vy);
+    } else {
+        auto zero = P::zero();
+        auto one = P::set1(1.0f);
+        auto absMask = P::iset1(0x7FFFFFFFu);
+        auto ax = P::as_reg(P::iand(P::as_ireg(x), absMask));
+        auto ay = P::as_reg(P::iand(P::as_ireg(y), absMask));
+        auto hi = P::max(ax, ay);
+        auto t = P::select_gt(hi, zero, P::div(P::min(ax, ay), hi), zero);
+        typename P::reg a;
+        if constexpr (A == Accuracy::High) {
+            // t > tan(pi/8) 时用 atan(t) = pi/4 + atan((t - 1) / (t + 1)), Cephes atanf 系数
+            auto split = P::set1(0.414213562373095f);
+            auto u = P::select_gt(t, split, P::div(P::sub(t, one), P::add(t, one)), t);
+            auto z = P::mul(u, u);
+            auto p = P::fmadd(P::set1(8.05374449538e-2f), z, P::set1(-1.38776856032e-1f));
+            p = P::fmadd(p, z, P::set1(1.99777106478e-1f));
+            p = P::fmadd(p, z, P::set1(-3.33329491539e-1f));
+            a = P::add(P::fmadd(p, P::mul(z, u), u), P::select_gt(t, split, P::set1(0.785398163397448f), zero));
+        } else {
+            // atan(t) ~ t * (pi/4 + (1 - t) * (0.2447 + 0.0663 t))
+            auto k = P::fmadd(P::set1(0.0663f), t, P::set1(0.2447f));
+            a = P::mul(t, P::fmadd(P::sub(one, t), k, P::set1(0.785398163397448f)));
+        }
+        a = P::select_gt(ay, ax, P::sub(P::set1(1.57079632679490f), a), a);
+        a = P::select_gt(zero, x, P::sub(P::set1(3.14159265358979f), a), a);
+        // 结果取 y 的符号
+        return P::as_reg(P::ior(P::as_ireg(a), P::iand(P::as_ireg(y), P::iset1(0x80000000u))));
+    }
+}
+
+// exp(x) = 2^n * exp(r), n = round(x / ln2), |r| <= ln2 / 2
+template<Accuracy A, typename P>
+typename P::reg fast_exp(typename P::reg x) {
+    if constexpr (A == Accuracy::Exact) {
+        return fast_per_lane<P>(x, [](float v) { return std::exp(v); });
+    } else {
+        // 截断保证 2^n 为规格化数
+        x = P::min(P::max(x, P::set1(-87.3365447505531f)), P::set1(88.3762626647949f));
+        auto n = P::round_int(P::mul(x, P::set1(1.44269504088896341f)));
+        auto nf = P::to_float(n);
+        auto r = P::fmadd(nf, P::set1(-0.693359375f), x);
+        r = P::fmadd(nf, P::set1(2.12194440e-4f), r);
+        auto one = P::set1(1.0f);
+        typename P::reg y;
+        if constexpr (A == Accuracy::High) {
+            // Cephes expf 系数
+            auto p = P::fmadd(P::set1(1.9875691500e-4f), r, P::set1(1.3981999507e-3f));
+            p = P::fmadd(p, r, P::set1(8.3334519073e-3f));
+            p = P::fmadd(p, r, P::set1(4.1665795894e-2f));
+            p = P::fmadd(p, r, P::set1(1.6666665459e-1f));
+            p = P::fmadd(p, r, P::set1(5.0000001201e-1f));
+            y = P::add(P::fmadd(p, P::mul(r, r), r), one);
+        } else {
+            auto p = P::fmadd(P::fmadd(P::set1(1.0f / 24.0f), r, P::set1(1.0f / 6.0f)), r, P::set1(0.5f));
+            y = P::add(P::fmadd(p, P::mul(r, r), r), one);
+        }
+        auto scale = P::as_reg(P::ishl(P::iadd(n, P::iset1(127)), 23));
+        return P::mul(y, scale);
+    }
+}
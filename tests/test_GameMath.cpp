@@ -1,8 +1,25 @@
 #define CATCH_CONFIG_MAIN
 
 #include <catch2/catch_all.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
 #include "../include/GameMath/Matrix.hpp"
+#include "../include/GameMath/MatrixView.hpp"
+#include "../include/GameMath/DynamicMatrix.hpp"
+#include "../include/GameMath/Memory.hpp"
 #include "../include/GameMath/Vector.hpp"
+#include "../include/GameMath/Batch.hpp"
+#include "../include/GameMath/Expr.hpp"
+#include "../include/GameMath/Quaternion.hpp"
+#include "../include/GameMath/Transform.hpp"
+#include "../include/GameMath/Geometry.hpp"
+#include "../include/GameMath/SpatialHash.hpp"
+#include "../include/GameMath/BVH.hpp"
+#include "../include/GameMath/Random.hpp"
+#include "../include/GameMath/FastMath.hpp"
+#include "../include/GameMath/Interpolation.hpp"
+#include "../include/GameMath/ThreadPool.hpp"
 
 TEST_CASE("Matrix Rotation Operations", "[matrix][rotation]") {
     GameMath::Matrix<int, 2, 3> mat = {
@@ -78,4 +95,1560 @@ TEST_CASE("Matrix Flip Operations", "[matrix][flip]") {
         REQUIRE(flipped[1][1] == 5);
         REQUIRE(flipped[1][2] == 6);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Vector4f Operations", "[vector][simd]") {
+    GameMath::Vector4f a{1.0f, 2.0f, 3.0f, 4.0f};
+    GameMath::Vector4f b{4.0f, 3.0f, 2.0f, 1.0f};
+
+    REQUIRE((a + b) == GameMath::Vector4f(5.0f));
+    REQUIRE((a - b) == GameMath::Vector4f{-3.0f, -1.0f, 1.0f, 3.0f});
+    REQUIRE((a * 2.0f) == GameMath::Vector4f{2.0f, 4.0f, 6.0f, 8.0f});
+    REQUIRE(a.dot(b) == 20.0f);
+    REQUIRE(a.length_squared() == 30.0f);
+    REQUIRE(a[3] == 4.0f);
+    REQUIRE_THROWS_AS(a[4], std::out_of_range);
+    REQUIRE_THROWS_AS(GameMath::Vector4f::zero().normalized(), std::runtime_error);
+}
+
+TEST_CASE("Matrix4x4 Multiply and Transpose", "[matrix][simd]") {
+    GameMath::Matrix4x4 a = {
+        {1, 2, 3, 4},
+        {5, 6, 7, 8},
+        {9, 10, 11, 12},
+        {13, 14, 15, 16}
+    };
+    GameMath::Matrix4x4 b = {
+        {2, 0, 1, 0},
+        {0, 1, 0, 3},
+        {1, 0, 2, 0},
+        {0, 4, 0, 1}
+    };
+
+    SECTION("Matrix product matches scalar reference") {
+        auto c = a * b;
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                float expected = 0;
+                for (size_t k = 0; k < 4; ++k) {
+                    expected += a(i, k) * b(k, j);
+                }
+                REQUIRE(c(i, j) == expected);
+            }
+        }
+        REQUIRE(a * GameMath::Matrix4x4::identity() == a);
+    }
+
+    SECTION("Matrix times vector") {
+        GameMath::Vector4f v{1.0f, 0.0f, -1.0f, 2.0f};
+        auto r = a * v;
+        REQUIRE(r == GameMath::Vector4f{6.0f, 14.0f, 22.0f, 30.0f});
+    }
+
+    SECTION("Transpose") {
+        auto t = a.transposed();
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                REQUIRE(t(i, j) == a(j, i));
+            }
+        }
+    }
+}
+
+TEST_CASE("Vec3Batch Operations", "[batch][simd]") {
+    // 37 个元素, 覆盖 SIMD 主循环与标量尾部
+    const size_t count = 37;
+    GameMath::Vec3Batch a, b;
+    for (size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        a.push_back(GameMath::Vector3f(f, f + 1.0f, f + 2.0f));
+        b.push_back(GameMath::Vector3f(1.0f, -f, 0.5f * f));
+    }
+    a.set(0, GameMath::Vector3f(0.0f, 0.0f, 0.0f));
+
+    SECTION("Add, scale and lerp match per-element results") {
+        GameMath::Vec3Batch sum, scaled, mixed;
+        add(a, b, sum);
+        scale(a, 2.0f, scaled);
+        lerp(a, b, 0.25f, mixed);
+        for (size_t i = 0; i < count; ++i) {
+            REQUIRE(sum.get(i) == a.get(i) + b.get(i));
+            REQUIRE(scaled.get(i) == a.get(i) * 2.0f);
+            auto expected = a.get(i) + (b.get(i) - a.get(i)) * 0.25f;
+            REQUIRE(mixed.get(i).x == Approx(expected.x));
+            REQUIRE(mixed.get(i).y == Approx(expected.y));
+            REQUIRE(mixed.get(i).z == Approx(expected.z));
+        }
+    }
+
+    SECTION("Dot, length and normalize") {
+        std::vector<float> dots(count), lengths(count);
+        dot(a, b, dots.data());
+        length(a, lengths.data());
+        GameMath::Vec3Batch n;
+        normalize(a, n);
+        REQUIRE(n.get(0) == GameMath::Vector3f::zero());
+        for (size_t i = 1; i < count; ++i) {
+            REQUIRE(dots[i] == Approx(a.get(i).dot(b.get(i))));
+            REQUIRE(lengths[i] == Approx(a.get(i).length()));
+            REQUIRE(n.get(i).length() == Approx(1.0f));
+        }
+    }
+
+    SECTION("Mismatched sizes throw") {
+        GameMath::Vec3Batch shorter(3), out;
+        REQUIRE_THROWS_AS(add(a, shorter, out), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Batch Matrix Transforms", "[batch][transform]") {
+    GameMath::Matrix4x4 m = {
+        {0, -1, 0, 10},
+        {1, 0, 0, 20},
+        {0, 0, 2, 30},
+        {0, 0, 0, 1}
+    };
+    std::vector<GameMath::Vector3f> points;
+    GameMath::Vec3Batch batch;
+    for (size_t i = 0; i < 21; ++i) {
+        GameMath::Vector3f p(static_cast<float>(i), 1.0f, -static_cast<float>(i));
+        points.push_back(p);
+        batch.push_back(p);
+    }
+
+    SECTION("Points and directions") {
+        std::vector<GameMath::Vector3f> tp(points.size()), td(points.size());
+        GameMath::transform_points(m, points, tp);
+        GameMath::transform_directions(m, points, td);
+        GameMath::Vec3Batch bp;
+        GameMath::transform_points(m, batch, bp);
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto& p = points[i];
+            REQUIRE(tp[i] == GameMath::Vector3f(10.0f - p.y, 20.0f + p.x, 30.0f + 2.0f * p.z));
+            REQUIRE(td[i] == GameMath::Vector3f(-p.y, p.x, 2.0f * p.z));
+            REQUIRE(bp.get(i) == tp[i]);
+        }
+    }
+
+    SECTION("Homogeneous divide and Vector4f") {
+        GameMath::Matrix4x4 proj = GameMath::Matrix4x4::identity();
+        proj(3, 3) = 0.0f;
+        proj(3, 2) = -1.0f;
+        std::vector<GameMath::Vector3f> out(points.size());
+        GameMath::transform_points_projected(proj, GameMath::Span<const GameMath::Vector3f>(points).subspan(1, 20),
+                                             GameMath::Span<GameMath::Vector3f>(out).subspan(1, 20));
+        GameMath::Vec3Batch bout;
+        GameMath::transform_points_projected(proj, batch, bout);
+        for (size_t i = 1; i < points.size(); ++i) {
+            float inv = 1.0f / -points[i].z;
+            REQUIRE(out[i].x == Approx(points[i].x * inv));
+            REQUIRE(out[i].y == Approx(points[i].y * inv));
+            REQUIRE(out[i].z == Approx(-1.0f));
+            REQUIRE(bout.get(i).x == Approx(out[i].x));
+        }
+
+        std::vector<GameMath::Vector4f> v4 = {{1, 2, 3, 1}, {0, 1, 0, 0}};
+        GameMath::transform(m, v4, v4);
+        REQUIRE(v4[0] == GameMath::Vector4f{8.0f, 21.0f, 36.0f, 1.0f});
+        REQUIRE(v4[1] == GameMath::Vector4f{-1.0f, 0.0f, 0.0f, 0.0f});
+    }
+
+    SECTION("Size mismatch throws") {
+        std::vector<GameMath::Vector3f> out(3);
+        REQUIRE_THROWS_AS(GameMath::transform_points(m, points, out), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Runtime SIMD Dispatch", "[batch][dispatch]") {
+    using GameMath::simd::Tier;
+    GameMath::Vec3Batch in;
+    for (size_t i = 0; i < 45; ++i) {
+        float f = static_cast<float>(i);
+        in.push_back(GameMath::Vector3f(f - 20.0f, 0.5f * f, 3.0f));
+    }
+    GameMath::Matrix4x4 m = GameMath::Matrix4x4::identity();
+    m(0, 3) = 5.0f;
+    m(1, 1) = 2.0f;
+
+    REQUIRE(GameMath::simd::active_tier() == GameMath::simd::detected_tier());
+
+    GameMath::simd::force_tier(Tier::Scalar);
+    GameMath::Vec3Batch refNormalized, refTransformed;
+    normalize(in, refNormalized);
+    GameMath::transform_points(m, in, refTransformed);
+
+    for (int t = 0; t <= static_cast<int>(GameMath::simd::detected_tier()); ++t) {
+        auto tier = static_cast<Tier>(t);
+        GameMath::simd::force_tier(tier);
+        REQUIRE(GameMath::simd::active_tier() == tier);
+        GameMath::Vec3Batch normalized, transformed;
+        normalize(in, normalized);
+        GameMath::transform_points(m, in, transformed);
+        for (size_t i = 0; i < in.size(); ++i) {
+            REQUIRE(normalized.get(i).x == Approx(refNormalized.get(i).x));
+            REQUIRE(normalized.get(i).y == Approx(refNormalized.get(i).y));
+            REQUIRE(transformed.get(i) == refTransformed.get(i));
+        }
+    }
+
+    if (GameMath::simd::detected_tier() != Tier::AVX512) {
+        REQUIRE_THROWS_AS(GameMath::simd::force_tier(Tier::AVX512), std::runtime_error);
+    }
+    GameMath::simd::reset_tier();
+    REQUIRE(GameMath::simd::active_tier() == GameMath::simd::detected_tier());
+}
+
+TEST_CASE("Checked Access and Non-throwing Normalization", "[vector][policy]") {
+    GameMath::Vector3f v(3.0f, 0.0f, 4.0f);
+    GameMath::Vector<float, 2> zero2{0.0f, 0.0f};
+
+    SECTION("at() always checks bounds") {
+        REQUIRE(v.at(2) == 4.0f);
+        REQUIRE_THROWS_AS(v.at(3), std::out_of_range);
+        REQUIRE_THROWS_AS(zero2.at(2), std::out_of_range);
+        GameMath::Matrix<int, 2, 2> m = {{1, 2}, {3, 4}};
+        REQUIRE(m.at(1, 0) == 3);
+        REQUIRE_THROWS_AS(m.at(2, 0), std::out_of_range);
+    }
+
+    SECTION("try_normalized and safe_normalized never throw") {
+        auto n = v.try_normalized();
+        REQUIRE(n.has_value());
+        REQUIRE(n->x == Approx(0.6f));
+        REQUIRE_FALSE(GameMath::Vector3f::zero().try_normalized().has_value());
+        REQUIRE_FALSE(zero2.try_normalized().has_value());
+        REQUIRE(GameMath::Vector4f::zero().safe_normalized(GameMath::Vector4f{0, 0, 1, 0}) ==
+                GameMath::Vector4f{0, 0, 1, 0});
+        REQUIRE(v.safe_normalized().z == Approx(0.8f));
+        STATIC_REQUIRE(noexcept(v.safe_normalized()));
+    }
+}
+
+TEST_CASE("Constexpr Vector and Matrix", "[vector][matrix][constexpr]") {
+    using GameMath::Matrix;
+    using GameMath::Vector3f;
+    using GameMath::Vector4f;
+
+    constexpr Vector3f a(1.0f, 2.0f, 3.0f);
+    constexpr Vector3f b{4.0f, 5.0f, 6.0f};
+    STATIC_REQUIRE(a.dot(b) == 32.0f);
+    STATIC_REQUIRE(a.cross(b) == Vector3f(-3.0f, 6.0f, -3.0f));
+    STATIC_REQUIRE((a + b - a * 2.0f)[2] == 3.0f);
+
+    constexpr Vector4f v(1.0f, 2.0f, 3.0f, 1.0f);
+    constexpr auto translate = Matrix<float, 4, 4>{
+        Vector4f(1, 0, 0, 5),
+        Vector4f(0, 1, 0, 6),
+        Vector4f(0, 0, 1, 7),
+        Vector4f(0, 0, 0, 1)
+    };
+    constexpr Vector4f moved = translate * v;
+    STATIC_REQUIRE(moved == Vector4f(6.0f, 8.0f, 10.0f, 1.0f));
+    STATIC_REQUIRE(translate * GameMath::Matrix4x4::identity() == translate);
+    STATIC_REQUIRE(translate.transposed()(3, 0) == 5.0f);
+
+    constexpr auto ortho = GameMath::orthographic(-2.0f, 2.0f, -1.0f, 1.0f, 0.0f, 10.0f);
+    STATIC_REQUIRE(ortho(0, 0) == 0.5f);
+    STATIC_REQUIRE(ortho(2, 3) == -1.0f);
+
+    // 编译期生成的棋盘变换与运行时结果一致
+    constexpr Matrix<int, 2, 3> board = {{1, 2, 3}, {4, 5, 6}};
+    constexpr auto cw = rotate_90_clockwise(board);
+    constexpr auto ccw = rotate_90_counterclockwise(board);
+    STATIC_REQUIRE(cw(0, 0) == 4 && cw(2, 1) == 3);
+    STATIC_REQUIRE(rotate_90_clockwise(ccw) == board);
+    STATIC_REQUIRE(flip_vertical(flip_horizontal(board)) == rotate_180(board));
+
+    Matrix<int, 2, 3> runtimeBoard = board;
+    REQUIRE(rotate_90_clockwise(runtimeBoard) == cw);
+    Vector4f runtimeV = v;
+    REQUIRE(translate * runtimeV == moved);
+}
+
+TEST_CASE("Expression Templates", "[vector][matrix][expr]") {
+    using namespace GameMath;
+    Vector4f a(1.0f, 2.0f, 3.0f, 4.0f);
+    Vector4f b(5.0f, 6.0f, 7.0f, 8.0f);
+
+    SECTION("fused chains match value semantics") {
+        Vector4f fused = expr::lazy(a) + (expr::lazy(b) - expr::lazy(a)) * 0.25f;
+        Vector4f reference = a + (b - a) * 0.25f;
+        for (size_t i = 0; i < 4; ++i) REQUIRE(fused[i] == Approx(reference[i]));
+        REQUIRE(expr::lerp(a, b, 0.5f) == Vector4f(3.0f, 4.0f, 5.0f, 6.0f));
+
+        Vector3f c(1.0f, 2.0f, 3.0f), d(3.0f, 2.0f, 1.0f);
+        Vector3f e = expr::lazy(c) * 2.0f - expr::lazy(d) * 0.5f;
+        REQUIRE(e == Vector3f(0.5f, 3.0f, 5.5f));
+    }
+
+    SECTION("matrix sums and in-place assignment") {
+        Matrix4x4 m = Matrix4x4::identity();
+        Matrix4x4 n(2.0f);
+        Matrix4x4 sum = expr::lazy(m) + expr::lazy(n) * 3.0f + expr::lazy(m);
+        REQUIRE(sum == m + n * 3.0f + m);
+
+        Matrix<int, 2, 2> mi = {{1, 2}, {3, 4}};
+        expr::assign(mi, expr::lazy(mi) * 2 * 3 - expr::lazy(mi));
+        REQUIRE(mi == Matrix<int, 2, 2>{{5, 10}, {15, 20}});
+    }
+}
+
+TEST_CASE("Matrix Determinant and Inverse", "[matrix][inverse]") {
+    using namespace GameMath;
+
+    auto requireIdentity = [](const auto& m) {
+        using M = std::decay_t<decltype(m)>;
+        for (size_t i = 0; i < m.numRows(); ++i)
+            for (size_t j = 0; j < m.numCols(); ++j)
+                REQUIRE(m(i, j) == Approx(i == j ? 1.0f : 0.0f).margin(1e-5));
+        (void)sizeof(M);
+    };
+
+    SECTION("3x3 closed form") {
+        Matrix3x3 m = {{2.0f, -1.0f, 0.0f}, {1.0f, 3.0f, 2.0f}, {0.0f, 1.0f, 4.0f}};
+        REQUIRE(m.determinant() == Approx(24.0f));
+        requireIdentity(m * m.inverse());
+        REQUIRE_THROWS_AS(Matrix3x3(1.0f).inverse(), std::runtime_error);
+        REQUIRE_FALSE(Matrix3x3(1.0f).try_inverse().has_value());
+    }
+
+    SECTION("4x4 SIMD and scalar paths agree") {
+        Matrix4x4 m = {{1.0f, 2.0f, 0.5f, 3.0f}, {0.0f, 1.0f, 4.0f, 1.0f},
+                       {2.0f, 0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 1.0f, 2.0f}};
+        Matrix<double, 4, 4> md;
+        for (size_t i = 0; i < 4; ++i)
+            for (size_t j = 0; j < 4; ++j) md(i, j) = m(i, j);
+        REQUIRE(m.determinant() == Approx(md.determinant()));
+        Matrix4x4 inv = m.inverse();
+        Matrix<double, 4, 4> invd = md.inverse();
+        for (size_t i = 0; i < 4; ++i)
+            for (size_t j = 0; j < 4; ++j) REQUIRE(inv(i, j) == Approx(invd(i, j)).margin(1e-5));
+        requireIdentity(m * inv);
+        REQUIRE_THROWS_AS(Matrix4x4(2.0f).inverse(), std::runtime_error);
+    }
+
+    SECTION("affine and orthonormal inverses") {
+        Matrix4x4 view = lookAt(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(0.0f, 0.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f));
+        Matrix4x4 general = view.inverse();
+        Matrix4x4 affine = view.inverse_affine();
+        Matrix4x4 rigid = view.inverse_orthonormal();
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                REQUIRE(affine(i, j) == Approx(general(i, j)).margin(1e-5));
+                REQUIRE(rigid(i, j) == Approx(general(i, j)).margin(1e-5));
+            }
+        }
+
+        constexpr Matrix3x3 xform = {{2.0f, 0.0f, 4.0f}, {0.0f, 0.5f, -1.0f}, {0.0f, 0.0f, 1.0f}};
+        constexpr Matrix3x3 inv = xform.inverse_affine();
+        STATIC_REQUIRE(inv(0, 0) == 0.5f);
+        STATIC_REQUIRE(inv(0, 2) == -2.0f);
+        STATIC_REQUIRE(inv(1, 2) == 2.0f);
+    }
+}
+
+TEST_CASE("Quaternion Operations", "[quaternion]") {
+    using namespace GameMath;
+    Quaternion qx = Quaternion::from_axis_angle(Vector3f(1.0f, 0.0f, 0.0f), PI * 0.5f);
+    Quaternion qy = Quaternion::from_axis_angle(Vector3f(0.0f, 1.0f, 0.0f), PI * 0.5f);
+
+    SECTION("multiply, rotate and matrix conversion agree") {
+        Vector3f v(1.0f, 2.0f, 3.0f);
+        Quaternion q = qy * qx;
+        Vector3f viaQuat = q * v;
+        Vector3f viaCompose = qy * (qx * v);
+        Vector3f viaMatrix = q.to_matrix3() * v;
+        for (size_t i = 0; i < 3; ++i) {
+            REQUIRE(viaQuat[i] == Approx(viaCompose[i]).margin(1e-5));
+            REQUIRE(viaQuat[i] == Approx(viaMatrix[i]).margin(1e-5));
+        }
+        REQUIRE((qx * Vector3f(0.0f, 1.0f, 0.0f)).z == Approx(1.0f));
+
+        Quaternion back = Quaternion::from_matrix(q.to_matrix4());
+        REQUIRE(std::abs(back.dot(q)) == Approx(1.0f));
+        Quaternion unit = q * q.conjugate();
+        REQUIRE(unit.w == Approx(1.0f));
+        REQUIRE(q.inverse().dot(q.conjugate()) == Approx(1.0f));
+    }
+
+    SECTION("slerp and nlerp take the shortest path") {
+        Quaternion half = slerp(Quaternion::identity(), qx, 0.5f);
+        Quaternion expected = Quaternion::from_axis_angle(Vector3f(1.0f, 0.0f, 0.0f), PI * 0.25f);
+        REQUIRE(half.dot(expected) == Approx(1.0f));
+        REQUIRE(slerp(Quaternion::identity(), -qx, 0.5f).dot(expected) == Approx(1.0f));
+        REQUIRE(nlerp(Quaternion::identity(), qx, 0.5f).dot(expected) == Approx(1.0f));
+    }
+
+    SECTION("batch interpolation matches scalar") {
+        std::vector<Quaternion> a, b, out(37);
+        std::vector<float> t;
+        Vec4Batch sa, sb, so;
+        for (size_t i = 0; i < 37; ++i) {
+            float angle = 0.1f * static_cast<float>(i);
+            Quaternion qa = Quaternion::from_axis_angle(Vector3f(0.0f, 0.0f, 1.0f), angle);
+            Quaternion qb = Quaternion::from_axis_angle(Vector3f(0.0f, 1.0f, 0.0f), -angle);
+            a.push_back(qa);
+            b.push_back(i % 3 == 0 ? -qb : qb);
+            t.push_back(static_cast<float>(i) / 36.0f);
+            sa.push_back(Vector4f{qa.x, qa.y, qa.z, qa.w});
+            sb.push_back(Vector4f{b.back().x, b.back().y, b.back().z, b.back().w});
+        }
+
+        slerp(a, b, t, out);
+        slerp(sa, sb, t, so);
+        for (size_t i = 0; i < a.size(); ++i) {
+            Quaternion ref = slerp(a[i], b[i], t[i]);
+            REQUIRE(out[i].dot(ref) == Approx(1.0f));
+            REQUIRE(so.w()[i] == Approx(ref.w).margin(1e-5));
+        }
+
+        // 批量 slerp 与标量版本的最大误差 (含接近与相同的四元数, 走线性权重的通道)
+        a.push_back(a[5]);
+        b.push_back(a[5]);
+        a.push_back(a[7]);
+        b.push_back(Quaternion::from_axis_angle(Vector3f(1.0f, 0.0f, 0.0f), 0.01f) * a[7]);
+        t.push_back(0.3f);
+        t.push_back(0.6f);
+        out.resize(a.size());
+        for (Accuracy acc : {Accuracy::Exact, Accuracy::High, Accuracy::Low}) {
+            float tol = acc == Accuracy::Low ? 1e-3f : 2e-6f;
+            slerp(a, b, t, out, acc);
+            for (size_t i = 0; i < a.size(); ++i) {
+                Quaternion ref = slerp(a[i], b[i], t[i]);
+                for (size_t c = 0; c < 4; ++c) REQUIRE(out[i].data[c] == Approx(ref.data[c]).margin(tol));
+            }
+            slerp(a, b, 0.25f, out, acc);
+            for (size_t i = 0; i < a.size(); ++i) REQUIRE(out[i].dot(slerp(a[i], b[i], 0.25f)) == Approx(1.0f).margin(tol));
+        }
+        out.resize(sa.size());
+        a.resize(sa.size());
+        b.resize(sa.size());
+        t.resize(sa.size());
+
+        nlerp(a, b, t, out);
+        nlerp(sa, sb, t, so);
+        for (size_t i = 0; i < a.size(); ++i) {
+            Quaternion ref = nlerp(a[i], b[i], t[i]);
+            REQUIRE(out[i].dot(ref) == Approx(1.0f));
+            REQUIRE(so.x()[i] == Approx(ref.x).margin(1e-5));
+            REQUIRE(so.w()[i] == Approx(ref.w).margin(1e-5));
+        }
+        REQUIRE_THROWS_AS(nlerp(sa, sb, Span<const float>(t.data(), 3), so), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Transform Hierarchy", "[transform]") {
+    using namespace GameMath;
+    using Handle = TransformHierarchy::Handle;
+
+    auto requireMatrixNear = [](const Matrix4x4& a, const Matrix4x4& b) {
+        for (size_t i = 0; i < 4; ++i)
+            for (size_t j = 0; j < 4; ++j) REQUIRE(a(i, j) == Approx(b(i, j)).margin(1e-5));
+    };
+
+    TransformHierarchy scene;
+    Handle root = scene.create(TransformHierarchy::kInvalid, Vector3f(1.0f, 0.0f, 0.0f));
+    Handle arm = scene.create(root, Vector3f(0.0f, 2.0f, 0.0f),
+                              Quaternion::from_axis_angle(Vector3f(0.0f, 0.0f, 1.0f), PI * 0.5f));
+    Handle other = scene.create(TransformHierarchy::kInvalid, Vector3f(0.0f, 0.0f, 5.0f));
+    Handle hand = scene.create(arm, Vector3f(3.0f, 0.0f, 0.0f), Quaternion::identity(), Vector3f(2.0f, 2.0f, 2.0f));
+    REQUIRE(scene.size() == 4);
+    REQUIRE(scene.parent(hand) == arm);
+    REQUIRE(scene.subtree_size(root) == 3);
+
+    scene.update();
+    REQUIRE_FALSE(scene.dirty());
+    requireMatrixNear(scene.world(hand), scene.local_matrix(root) * scene.local_matrix(arm) * scene.local_matrix(hand));
+    Vector4f tip = scene.world(hand) * Vector4f(1.0f, 0.0f, 0.0f, 1.0f);
+    REQUIRE(tip.x == Approx(1.0f).margin(1e-5));
+    REQUIRE(tip.y == Approx(7.0f));
+
+    SECTION("only dirty subtrees are recomputed") {
+        Matrix4x4 otherWorld = scene.world(other);
+        scene.set_position(arm, Vector3f(0.0f, 4.0f, 0.0f));
+        scene.set_scale(hand, Vector3f(1.0f, 1.0f, 1.0f));
+        REQUIRE(scene.dirty());
+        scene.update();
+        REQUIRE(scene.last_task_count() == 1);
+        REQUIRE(scene.world(other) == otherWorld);
+        requireMatrixNear(scene.world(hand), scene.local_matrix(root) * scene.local_matrix(arm) * scene.local_matrix(hand));
+    }
+
+    SECTION("independent subtrees update in parallel") {
+        scene.set_position(root, Vector3f(-1.0f, 0.0f, 0.0f));
+        scene.set_position(other, Vector3f(0.0f, 0.0f, -5.0f));
+        scene.update([](size_t count, auto&& task) {
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < count; ++i) threads.emplace_back([&task, i] { task(i); });
+            for (auto& t : threads) t.join();
+        });
+        REQUIRE(scene.last_task_count() == 2);
+        REQUIRE(scene.world(other)(2, 3) == Approx(-5.0f));
+        requireMatrixNear(scene.world(hand), scene.local_matrix(root) * scene.local_matrix(arm) * scene.local_matrix(hand));
+    }
+
+    SECTION("destroy removes the subtree and keeps other handles valid") {
+        scene.destroy(arm);
+        REQUIRE(scene.size() == 2);
+        REQUIRE_FALSE(scene.valid(hand));
+        REQUIRE(scene.subtree_size(root) == 1);
+        REQUIRE_THROWS_AS(scene.world(hand), std::invalid_argument);
+        Handle child = scene.create(other, Vector3f(1.0f, 0.0f, 0.0f));
+        scene.update();
+        REQUIRE(scene.parent(child) == other);
+        REQUIRE(scene.world(child)(0, 3) == Approx(1.0f));
+        REQUIRE(scene.world(child)(2, 3) == Approx(5.0f));
+    }
+}
+
+TEST_CASE("Geometry and Frustum Culling", "[geometry][dispatch]") {
+    using namespace GameMath;
+    using GameMath::simd::Tier;
+
+    AABB box(Vector3f(-1.0f, -1.0f, -1.0f), Vector3f(1.0f, 2.0f, 3.0f));
+    REQUIRE(box.center() == Vector3f(0.0f, 0.5f, 1.0f));
+    REQUIRE(box.surface_area() == Approx(2.0f * (2 * 3 + 3 * 4 + 4 * 2)));
+    REQUIRE(box.contains(Vector3f(0.5f, 1.5f, 2.5f)));
+    REQUIRE_FALSE(box.intersects(AABB(Vector3f(2.0f, 0.0f, 0.0f), Vector3f(3.0f, 1.0f, 1.0f))));
+    AABB grown = AABB::empty();
+    REQUIRE_FALSE(grown.valid());
+    grown.expand(Vector3f(1.0f, 2.0f, 3.0f));
+    grown.expand(Vector3f(-1.0f, 0.0f, 0.0f));
+    REQUIRE(grown.min == Vector3f(-1.0f, 0.0f, 0.0f));
+    REQUIRE(grown.max == Vector3f(1.0f, 2.0f, 3.0f));
+
+    // 绕 z 轴旋转 90 度后平移 (10, 0, 0)
+    Matrix4x4 m{
+        Vector4f{0.0f, -1.0f, 0.0f, 10.0f},
+        Vector4f{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4f{0.0f, 0.0f, 1.0f, 0.0f},
+        Vector4f{0.0f, 0.0f, 0.0f, 1.0f}
+    };
+    AABB moved = box.transformed(m);
+    REQUIRE(moved.min.x == Approx(8.0f));
+    REQUIRE(moved.max.x == Approx(11.0f));
+    REQUIRE(moved.min.y == Approx(-1.0f));
+
+    Sphere sphere(Vector3f(3.0f, 0.0f, 0.0f), 2.5f);
+    REQUIRE(sphere.intersects(box));
+    REQUIRE_FALSE(Sphere(Vector3f(3.0f, 3.0f, 0.0f), 1.0f).intersects(box));
+    REQUIRE(Plane::from_point_normal(Vector3f(0.0f, 2.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f))
+                .distance(Vector3f(5.0f, 5.0f, 5.0f)) == Approx(3.0f));
+
+    // 相机在原点朝 -z, 近平面 1, 远平面 100
+    Frustum frustum = Frustum::from_matrix(perspective(1.5707963f, 1.0f, 1.0f, 100.0f));
+    REQUIRE(frustum.planes[Frustum::Near].distance(Vector3f(0.0f, 0.0f, -1.0f)) == Approx(0.0f).margin(1e-4));
+    REQUIRE(frustum.planes[Frustum::Far].distance(Vector3f(0.0f, 0.0f, -100.0f)) == Approx(0.0f).margin(1e-3));
+    REQUIRE(frustum.contains(Vector3f(0.0f, 0.0f, -10.0f)));
+    REQUIRE_FALSE(frustum.contains(Vector3f(0.0f, 0.0f, 10.0f)));
+    REQUIRE_FALSE(frustum.contains(Vector3f(11.0f, 0.0f, -10.0f)));
+    REQUIRE(frustum.intersects(AABB::from_center_extents(Vector3f(11.0f, 0.0f, -10.0f), Vector3f(2.0f, 2.0f, 2.0f))));
+    REQUIRE_FALSE(frustum.intersects(Sphere(Vector3f(0.0f, 0.0f, 5.0f), 2.0f)));
+
+    // 批量剔除与逐个测试结果一致, 各档位结果相同
+    Vec3Batch centers, extents;
+    std::vector<float> radii;
+    std::vector<uint32_t> expectedBoxes, expectedSpheres;
+    for (size_t i = 0; i < 203; ++i) {
+        float f = static_cast<float>(i);
+        Vector3f c(std::sin(f * 1.3f) * 60.0f, std::cos(f * 0.7f) * 60.0f, -std::fmod(f * 7.0f, 140.0f) + 20.0f);
+        Vector3f e(0.5f + std::fmod(f, 3.0f), 1.0f, 0.5f + std::fmod(f, 5.0f));
+        centers.push_back(c);
+        extents.push_back(e);
+        radii.push_back(e.x);
+        if (frustum.intersects(AABB::from_center_extents(c, e))) expectedBoxes.push_back(uint32_t(i));
+        if (frustum.intersects(Sphere(c, e.x))) expectedSpheres.push_back(uint32_t(i));
+    }
+    REQUIRE(expectedBoxes.size() > 10);
+    REQUIRE(expectedBoxes.size() < centers.size());
+
+    std::vector<uint32_t> visible;
+    for (int t = 0; t <= static_cast<int>(GameMath::simd::detected_tier()); ++t) {
+        GameMath::simd::force_tier(static_cast<Tier>(t));
+        REQUIRE(cull(frustum, centers, extents, visible) == expectedBoxes.size());
+        REQUIRE(visible == expectedBoxes);
+        REQUIRE(cull(frustum, centers, Span<const float>(radii), visible) == expectedSpheres.size());
+        REQUIRE(visible == expectedSpheres);
+    }
+    GameMath::simd::reset_tier();
+
+    REQUIRE_THROWS_AS(cull(frustum, centers, Vec3Batch(3), visible), std::invalid_argument);
+}
+
+TEST_CASE("Spatial Hash Broadphase", "[geometry][broadphase]") {
+    using namespace GameMath;
+    using Pair = SpatialHash::Pair;
+
+    REQUIRE_THROWS_AS(SpatialHash(0.0f), std::invalid_argument);
+
+    SpatialHash grid(4.0f);
+    auto a = grid.insert(Vector2f{0.0f, 0.0f}, Vector2f{2.0f, 2.0f});
+    auto b = grid.insert(Vector2f{1.0f, 1.0f}, Vector2f{6.0f, 6.0f});   // 跨 4 个单元
+    auto c = grid.insert(Vector2f{20.0f, 20.0f}, Vector2f{1.0f, 1.0f});
+    REQUIRE(grid.size() == 3);
+
+    std::vector<Pair> pairs;
+    grid.colliding_pairs(pairs);
+    REQUIRE(pairs == std::vector<Pair>{{a, b}});
+
+    std::vector<SpatialHash::Handle> hits;
+    grid.query(Vector2f{5.0f, 5.0f}, Vector2f{16.0f, 16.0f}, hits);
+    std::sort(hits.begin(), hits.end());
+    REQUIRE(hits == std::vector<SpatialHash::Handle>{b, c});
+
+    // 移动与删除后结果随之更新
+    grid.move(c, Vector2f{6.0f, 6.0f});
+    REQUIRE(grid.position(c) == Vector2f{6.0f, 6.0f});
+    grid.colliding_pairs(pairs);
+    std::sort(pairs.begin(), pairs.end());
+    REQUIRE(pairs == std::vector<Pair>{{a, b}, {b, c}});
+    grid.remove(b);
+    REQUIRE_FALSE(grid.valid(b));
+    REQUIRE_THROWS_AS(grid.move(b, Vector2f{0.0f, 0.0f}), std::invalid_argument);
+
+    // 非有限值被拒绝, 网格不受影响; 超出 int32 范围的坐标归入边界单元
+    SpatialHash edge(1.0f);
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    REQUIRE_THROWS_AS(edge.insert(Vector2f{nan, 0.0f}, Vector2f{1.0f, 1.0f}), std::invalid_argument);
+    REQUIRE_THROWS_AS(edge.insert(Vector2f{0.0f, 0.0f}, Vector2f{inf, 1.0f}), std::invalid_argument);
+    REQUIRE(edge.empty());
+    auto far = edge.insert(Vector2f{1e12f, -1e12f}, Vector2f{1e6f, 1e6f});
+    auto near = edge.insert(Vector2f{0.0f, 0.0f}, Vector2f{1.0f, 1.0f});
+    REQUIRE_THROWS_AS(edge.move(near, Vector2f{0.0f, inf}), std::invalid_argument);
+    REQUIRE(edge.position(near) == Vector2f{0.0f, 0.0f});
+    std::vector<SpatialHash::Handle> edgeHits;
+    edge.query(Vector2f{1e12f, -1e12f}, Vector2f{1e6f, 1e6f}, edgeHits);
+    REQUIRE(edgeHits == std::vector<SpatialHash::Handle>{far});
+    edgeHits.clear();
+    edge.query(Vector2f{nan, nan}, Vector2f{1.0f, 1.0f}, edgeHits);
+    REQUIRE(edgeHits.empty());
+    grid.colliding_pairs(pairs);
+    REQUIRE(pairs.empty());
+    REQUIRE(grid.insert(Vector2f{0.0f, 0.0f}, Vector2f{1.0f, 1.0f}) == b);
+
+    // 与暴力 O(n²) 结果一致, 包含负坐标与大量移动
+    SpatialHash world(3.0f);
+    std::vector<Vector2f> pos, size;
+    std::vector<SpatialHash::Handle> handles;
+    for (int i = 0; i < 300; ++i) {
+        float f = static_cast<float>(i);
+        pos.push_back(Vector2f{std::sin(f * 1.7f) * 40.0f, std::cos(f * 0.9f) * 40.0f});
+        size.push_back(Vector2f{0.5f + std::fmod(f, 4.0f), 0.5f + std::fmod(f, 3.0f)});
+        handles.push_back(world.insert(pos.back(), size.back()));
+    }
+    for (int step = 0; step < 3; ++step) {
+        for (size_t i = 0; i < pos.size(); i += 2) {
+            pos[i] = pos[i] + Vector2f{2.5f, -1.5f};
+            world.move(handles[i], pos[i]);
+        }
+        std::vector<Pair> expected;
+        for (size_t i = 0; i < pos.size(); ++i) {
+            for (size_t j = i + 1; j < pos.size(); ++j) {
+                if (rect_collision(pos[i], size[i], pos[j], size[j])) expected.emplace_back(handles[i], handles[j]);
+            }
+        }
+        world.colliding_pairs(pairs);
+        std::sort(pairs.begin(), pairs.end());
+        REQUIRE(pairs.size() == expected.size());
+        REQUIRE(pairs == expected);
+    }
+}
+
+TEST_CASE("BVH Ray and Overlap Queries", "[geometry][bvh]") {
+    using namespace GameMath;
+
+    // 暴力 slab 测试, 返回进入距离
+    auto slabHit = [](const Ray& ray, const AABB& b, float& t) {
+        float t0 = ray.tmin, t1 = ray.tmax;
+        for (size_t a = 0; a < 3; ++a) {
+            float inv = 1.0f / ray.direction[a];
+            float n = (b.min[a] - ray.origin[a]) * inv;
+            float f = (b.max[a] - ray.origin[a]) * inv;
+            if (n > f) std::swap(n, f);
+            t0 = std::max(t0, n);
+            t1 = std::min(t1, f);
+        }
+        t = t0;
+        return t0 <= t1;
+    };
+    auto threadedFor = [](size_t count, auto&& task) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < count; ++i) threads.emplace_back([&task, i] { task(i); });
+        for (auto& t : threads) t.join();
+    };
+
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 6000; ++i) {
+        float f = static_cast<float>(i);
+        Vector3f c(std::sin(f * 0.37f) * 50.0f, std::cos(f * 0.73f) * 50.0f, std::sin(f * 1.91f) * 50.0f);
+        boxes.push_back(AABB::from_center_extents(c, Vector3f(0.3f + std::fmod(f, 1.5f), 0.4f, 0.5f)));
+    }
+    std::vector<Ray> rays;
+    for (int i = 0; i < 77; ++i) {
+        float f = static_cast<float>(i);
+        Vector3f dir(std::cos(f * 0.41f) + 0.05f, std::sin(f * 0.29f), std::sin(f * 0.83f) - 0.03f);
+        rays.emplace_back(Vector3f(std::sin(f) * 10.0f, 0.5f * f - 20.0f, 2.0f), dir, 0.0f, 200.0f);
+    }
+
+    BVH serial, parallel;
+    serial.build(boxes);
+    parallel.build(boxes, threadedFor);
+    REQUIRE(serial.primitive_count() == boxes.size());
+    REQUIRE(parallel.node_count() > 0);
+
+    auto checkAgainstBruteForce = [&](const BVH& bvh) {
+        std::vector<RayHit> hits(rays.size());
+        std::vector<uint8_t> blocked(rays.size());
+        bvh.raycast(rays, hits);
+        bvh.occluded(rays, blocked);
+        size_t hitCount = 0;
+        for (size_t r = 0; r < rays.size(); ++r) {
+            float best = std::numeric_limits<float>::infinity();
+            for (const AABB& b : boxes) {
+                float t;
+                if (slabHit(rays[r], b, t)) best = std::min(best, t);
+            }
+            RayHit single;
+            bool hit = bvh.raycast(rays[r], single);
+            REQUIRE(hit == std::isfinite(best));
+            REQUIRE(bvh.occluded(rays[r]) == hit);
+            REQUIRE(bool(blocked[r]) == hit);
+            REQUIRE(hits[r].hit() == hit);
+            if (!hit) continue;
+            ++hitCount;
+            REQUIRE(single.t == Approx(best).margin(1e-4));
+            REQUIRE(hits[r].t == Approx(best).margin(1e-4));
+            float t;
+            REQUIRE(slabHit(rays[r], boxes[single.primitive], t));
+        }
+        REQUIRE(hitCount > 10);
+
+        AABB region(Vector3f(-10.0f, -5.0f, -20.0f), Vector3f(15.0f, 25.0f, 0.0f));
+        std::vector<uint32_t> found, expected;
+        bvh.query(region, found);
+        for (uint32_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].intersects(region)) expected.push_back(i);
+        }
+        std::sort(found.begin(), found.end());
+        REQUIRE(found == expected);
+    };
+    checkAgainstBruteForce(serial);
+    checkAgainstBruteForce(parallel);
+
+    // 图元移动后 refit, 结果与重新构建一致
+    for (size_t i = 0; i < boxes.size(); i += 3) {
+        Vector3f offset(1.5f, -2.0f, 0.75f);
+        boxes[i] = AABB(boxes[i].min + offset, boxes[i].max + offset);
+    }
+    parallel.refit(boxes);
+    checkAgainstBruteForce(parallel);
+    REQUIRE_THROWS_AS(parallel.refit(Span<const AABB>(boxes.data(), 3)), std::invalid_argument);
+
+    SECTION("triangle mesh") {
+        // 单位立方体 [0, 1]^3 的 12 个三角形
+        std::vector<Vector3f> vertices = {
+            {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+            {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+        std::vector<uint32_t> indices = {
+            0, 2, 1, 0, 3, 2,  4, 5, 6, 4, 6, 7,  0, 1, 5, 0, 5, 4,
+            3, 6, 2, 3, 7, 6,  0, 4, 7, 0, 7, 3,  1, 2, 6, 1, 6, 5};
+        BVH mesh;
+        mesh.build(vertices, indices);
+        REQUIRE(mesh.is_triangle_mesh());
+        REQUIRE(mesh.primitive_count() == 12);
+
+        RayHit hit;
+        REQUIRE(mesh.raycast(Ray(Vector3f(0.25f, 0.5f, 5.0f), Vector3f(0.0f, 0.0f, -1.0f)), hit));
+        REQUIRE(hit.t == Approx(4.0f));
+        REQUIRE((hit.primitive == 2 || hit.primitive == 3));
+        const uint32_t* tri = &indices[3 * hit.primitive];
+        Vector3f onTri = vertices[tri[0]] + (vertices[tri[1]] - vertices[tri[0]]) * hit.u +
+                         (vertices[tri[2]] - vertices[tri[0]]) * hit.v;
+        REQUIRE(onTri.x == Approx(0.25f));
+        REQUIRE(onTri.y == Approx(0.5f));
+
+        // 线段未到达立方体时不遮挡
+        REQUIRE_FALSE(mesh.occluded(Ray::segment(Vector3f(0.5f, 0.5f, 5.0f), Vector3f(0.5f, 0.5f, 1.5f))));
+        REQUIRE(mesh.occluded(Ray::segment(Vector3f(0.5f, 0.5f, 5.0f), Vector3f(0.5f, 0.5f, -5.0f))));
+        REQUIRE_FALSE(mesh.raycast(Ray(Vector3f(2.0f, 2.0f, 5.0f), Vector3f(0.0f, 0.0f, -1.0f)), hit));
+
+        // 顶点上移 2 个单位后 refit
+        for (auto& v : vertices) v = v + Vector3f(0.0f, 0.0f, 2.0f);
+        mesh.refit(vertices);
+        REQUIRE(mesh.raycast(Ray(Vector3f(0.25f, 0.5f, 5.0f), Vector3f(0.0f, 0.0f, -1.0f)), hit));
+        REQUIRE(hit.t == Approx(2.0f));
+        REQUIRE(mesh.bounds().min.z == Approx(2.0f));
+
+        indices.push_back(100);
+        REQUIRE_THROWS_AS(mesh.build(vertices, indices), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Random Engine and Bulk Fill", "[random][dispatch]") {
+    using namespace GameMath;
+    using GameMath::simd::Tier;
+
+    // 同一种子可复现, 不同 stream / jump 后的序列不同
+    Xoshiro128 a(42), b(42), c(42, 1);
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+    for (int i = 0; i < 16; ++i) REQUIRE(a() == b());
+    Xoshiro128 d = b;
+    d.jump();
+    REQUIRE(d != b);
+    Xoshiro128 e(42);
+    e.long_jump();
+    REQUIRE(e == Xoshiro128(42, 1));
+
+    Random::seed(7);
+    std::vector<int> first;
+    for (int i = 0; i < 32; ++i) first.push_back(Random::range(0, 9));
+    Random::seed(7);
+    for (int i = 0; i < 32; ++i) REQUIRE(Random::range(0, 9) == first[i]);
+
+    // 整数为闭区间, 浮点为半开区间
+    bool seen[5] = {};
+    for (int i = 0; i < 1000; ++i) {
+        int v = Random::range(-2, 2);
+        REQUIRE(v >= -2);
+        REQUIRE(v <= 2);
+        seen[v + 2] = true;
+        float f = Random::range(1.0f, 2.0f);
+        REQUIRE(f >= 1.0f);
+        REQUIRE(f < 2.0f);
+    }
+    for (bool s : seen) REQUIRE(s);
+    REQUIRE(Random::range(5, 5) == 5);
+    // 区间只有一个 ulp 宽时舍入常得到 max, 结果仍须小于 max
+    const float narrowHi = std::nextafter(1.0f, 2.0f);
+    for (int i = 0; i < 200; ++i) REQUIRE(Random::range(1.0f, narrowHi) == 1.0f);
+    for (int i = 0; i < 200; ++i) REQUIRE(Random::range(1.0, std::nextafter(1.0, 2.0)) == 1.0);
+    int64_t big = Random::range<int64_t>(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+    (void)big;
+    REQUIRE(Random::range<uint8_t>(0, 255) <= 255);
+
+    Vector2f p = Random::in_circle(3.0f);
+    REQUIRE(p.length() < 3.0f);
+    REQUIRE(Random::on_circle(3.0f).length() == Approx(3.0f));
+
+    // 批量均匀分布: 各档位结果完全一致, 尾部不足 16 个也能填满
+    std::vector<float> reference(1037), values(1037);
+    for (int t = 0; t <= static_cast<int>(GameMath::simd::detected_tier()); ++t) {
+        GameMath::simd::force_tier(static_cast<Tier>(t));
+        Random::seed(99);
+        Random::fill_range(values, 0.0f, 1.0f);
+        if (t == 0) reference = values;
+        REQUIRE(values == reference);
+
+        Random::fill_range(values, -4.0f, 4.0f);
+        double sum = 0.0;
+        for (float v : values) {
+            REQUIRE(v >= -4.0f);
+            REQUIRE(v < 4.0f);
+            sum += v;
+        }
+        REQUIRE(std::fabs(sum / values.size()) < 0.3);
+        Random::fill_range(values, 1.0f, narrowHi);
+        for (float v : values) REQUIRE(v == 1.0f);
+
+        std::vector<Vector2f> points(999);
+        Random::fill_in_circle(points, 2.0f);
+        size_t inner = 0;
+        for (const Vector2f& q : points) {
+            REQUIRE(q.length() < 2.0f);
+            inner += q.length() < 1.0f;
+        }
+        // 半径一半以内的面积占 1/4
+        REQUIRE(inner > 180);
+        REQUIRE(inner < 320);
+
+        Random::fill_on_circle(points, 5.0f);
+        for (const Vector2f& q : points) REQUIRE(q.length() == Approx(5.0f).epsilon(1e-5));
+    }
+    GameMath::simd::reset_tier();
+
+    std::vector<int32_t> ints(500);
+    Random::fill_range(ints, 10, 12);
+    for (int32_t v : ints) {
+        REQUIRE(v >= 10);
+        REQUIRE(v <= 12);
+    }
+
+    // 每个线程有独立的引擎, 重新设定种子不影响其他线程
+    Random::seed(1);
+    uint32_t mainFirst = Random::engine()();
+    uint32_t otherFirst = 0;
+    std::thread worker([&] {
+        Random::seed(1, 1);
+        otherFirst = Random::engine()();
+    });
+    worker.join();
+    REQUIRE(mainFirst != otherFirst);
+    REQUIRE(Random::engine() != Xoshiro128(1, 1));
+}
+
+TEST_CASE("Fast Math Approximations", "[fastmath][dispatch]") {
+    using namespace GameMath;
+    using GameMath::simd::Tier;
+
+    double sinHigh = 0, sinLow = 0, expHigh = 0, rsqrtHigh = 0, rsqrtLow = 0, atanHigh = 0, atanLow = 0;
+    for (int i = -5000; i <= 5000; ++i) {
+        float x = i * 0.013f;
+        sinHigh = std::max(sinHigh, std::fabs(double(fast::sin(x)) - std::sin(double(x))));
+        sinHigh = std::max(sinHigh, std::fabs(double(fast::cos(x)) - std::cos(double(x))));
+        sinLow = std::max(sinLow, std::fabs(double(fast::sin<Accuracy::Low>(x)) - std::sin(double(x))));
+        expHigh = std::max(expHigh, std::fabs(double(fast::exp(x * 0.5f)) / std::exp(double(x * 0.5f)) - 1.0));
+        float r = 0.001f + (i + 5000) * 0.37f;
+        rsqrtHigh = std::max(rsqrtHigh, std::fabs(double(fast::rsqrt(r)) * std::sqrt(double(r)) - 1.0));
+        rsqrtLow = std::max(rsqrtLow, std::fabs(double(fast::rsqrt<Accuracy::Low>(r)) * std::sqrt(double(r)) - 1.0));
+        float y = std::sin(i * 0.7f) * 3.0f, xx = std::cos(i * 1.3f) * 2.0f;
+        atanHigh = std::max(atanHigh, std::fabs(double(fast::atan2(y, xx)) - std::atan2(double(y), double(xx))));
+        atanLow = std::max(atanLow, std::fabs(double(fast::atan2<Accuracy::Low>(y, xx)) - std::atan2(double(y), double(xx))));
+    }
+    REQUIRE(sinHigh < 1e-6);
+    REQUIRE(sinLow < 1e-3);
+    REQUIRE(expHigh < 1e-6);
+    REQUIRE(rsqrtHigh < 1e-5);
+    REQUIRE(rsqrtLow < 2e-3);
+    REQUIRE(atanHigh < 1e-6);
+    REQUIRE(atanLow < 2e-3);
+    REQUIRE(fast::atan2(0.0f, 0.0f) == 0.0f);
+    REQUIRE(fast::atan2(0.0f, -1.0f) == Approx(PI));
+    REQUIRE(fast::atan2(-1.0f, 0.0f) == Approx(-PI / 2));
+    REQUIRE(fast::sqrt<Accuracy::Low>(0.0f) == 0.0f);
+    REQUIRE(fast::exp(-1000.0f) >= 0.0f);
+    REQUIRE(std::isfinite(fast::exp(1000.0f)));
+    REQUIRE(fast::sin<Accuracy::Exact>(1.0f) == std::sin(1.0f));
+
+    // 向量近似归一化, 零向量得到零向量
+    Vector3f v(3.0f, 4.0f, 12.0f);
+    REQUIRE(v.fast_length() == Approx(13.0f));
+    REQUIRE(v.fast_normalized().length() == Approx(1.0f).epsilon(1e-5));
+    REQUIRE(v.fast_normalized<Accuracy::Low>().length() == Approx(1.0f).epsilon(2e-3));
+    REQUIRE(Vector3f::zero().fast_normalized() == Vector3f::zero());
+    REQUIRE(Vector4f(1.0f, 2.0f, 2.0f, 4.0f).fast_normalized()[3] == Approx(0.8f));
+    REQUIRE(Vector2f{6.0f, 8.0f}.fast_normalized()[0] == Approx(0.6f));
+    // 长度平方为非规格化数时视为零向量, 不产生 inf/NaN
+    REQUIRE(Vector3f(1e-20f, 0.0f, 0.0f).fast_normalized() == Vector3f::zero());
+    REQUIRE(Vector4f(0.0f, 1e-20f, 0.0f, 0.0f).fast_normalized<Accuracy::Low>() == Vector4f::zero());
+    REQUIRE(fast::sqrt<Accuracy::Low>(1e-40f) == 0.0f);
+
+    // 批量版本在各档位下与 libm 一致 (在对应精度内)
+    std::vector<float> xs(1003), ys(1003), out(1003);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = float(i) * 0.05f - 25.0f;
+        ys[i] = std::cos(float(i)) * 4.0f;
+    }
+    Vec3Batch vb;
+    for (size_t i = 0; i < 37; ++i) vb.push_back(Vector3f(float(i) - 18.0f, 2.0f, float(i % 5)));
+    vb.push_back(Vector3f::zero());
+    Vec3Batch exact, approx;
+    normalize(vb, exact);
+    Vec3Batch tiny, tinyOut;
+    for (size_t i = 0; i < 17; ++i) tiny.push_back(Vector3f(1e-20f, -1e-21f * float(i), 0.0f));
+    for (int t = 0; t <= static_cast<int>(GameMath::simd::detected_tier()); ++t) {
+        GameMath::simd::force_tier(static_cast<Tier>(t));
+        fast::sin(xs, out);
+        for (size_t i = 0; i < xs.size(); ++i) REQUIRE(std::fabs(out[i] - std::sin(xs[i])) < 1e-6f);
+        fast::cos(xs, out, Accuracy::Low);
+        for (size_t i = 0; i < xs.size(); ++i) REQUIRE(std::fabs(out[i] - std::cos(xs[i])) < 1e-3f);
+        fast::atan2(ys, xs, out);
+        for (size_t i = 0; i < xs.size(); ++i) REQUIRE(std::fabs(out[i] - std::atan2(ys[i], xs[i])) < 1e-6f);
+        fast::exp(ys, out);
+        for (size_t i = 0; i < xs.size(); ++i) REQUIRE(out[i] == Approx(std::exp(ys[i])).epsilon(1e-6));
+
+        normalize(vb, approx, Accuracy::High);
+        for (size_t i = 0; i < vb.size(); ++i) {
+            for (size_t c = 0; c < 3; ++c) REQUIRE(approx.component(c)[i] == Approx(exact.component(c)[i]).margin(1e-5));
+        }
+        std::vector<float> lengths(vb.size());
+        length(vb, lengths.data(), Accuracy::Low);
+        REQUIRE(lengths.back() == 0.0f);
+        REQUIRE(lengths[0] == Approx(vb.get(0).length()).epsilon(2e-3));
+        for (Accuracy a : {Accuracy::High, Accuracy::Low}) {
+            normalize(tiny, tinyOut, a);
+            for (size_t i = 0; i < tiny.size(); ++i) REQUIRE(tinyOut.get(i) == Vector3f::zero());
+        }
+    }
+    GameMath::simd::reset_tier();
+
+    // 双精度批量走编译期路径
+    VectorBatch<double, 2> vd;
+    vd.push_back(Vector<double, 2>{3.0, 4.0});
+    VectorBatch<double, 2> nd;
+    normalize(vd, nd, Accuracy::High);
+    REQUIRE(nd.component(0)[0] == Approx(0.6));
+
+    REQUIRE_THROWS_AS(fast::sin(xs, Span<float>(out.data(), 10)), std::invalid_argument);
+}
+
+TEST_CASE("Interpolation Easing and Splines", "[interpolation]") {
+    using namespace GameMath;
+
+    // 缓动: 端点固定, 批量结果与单个一致, 与 Utility 中的多项式版本一致
+    const Ease curves[] = {Ease::Linear, Ease::InQuad, Ease::OutQuad, Ease::InOutQuad, Ease::InCubic,
+                           Ease::OutCubic, Ease::InOutCubic, Ease::InSine, Ease::OutSine, Ease::InOutSine,
+                           Ease::InExpo, Ease::OutExpo, Ease::InBack, Ease::OutBack, Ease::SmoothStep};
+    std::vector<float> ts(203), out(203);
+    for (size_t i = 0; i < ts.size(); ++i) ts[i] = float(i) / 200.0f - 0.005f;
+    for (Ease curve : curves) {
+        REQUIRE(ease(curve, 0.0f) == Approx(0.0f).margin(1e-6));
+        REQUIRE(ease(curve, 1.0f) == Approx(1.0f).margin(1e-6));
+        REQUIRE(ease(curve, -3.0f) == ease(curve, 0.0f));
+        REQUIRE(ease(curve, 7.0f) == ease(curve, 1.0f));
+        ease(curve, ts, out);
+        for (size_t i = 0; i < ts.size(); ++i) REQUIRE(out[i] == Approx(ease(curve, ts[i])).margin(1e-6));
+    }
+    for (float t = 0.0f; t <= 1.0f; t += 0.125f) {
+        REQUIRE(ease(Ease::InQuad, t) == Approx(ease_in(t)));
+        REQUIRE(ease(Ease::OutQuad, t) == Approx(ease_out(t)));
+        REQUIRE(ease(Ease::InOutQuad, t) == Approx(ease_in_out(t)));
+        REQUIRE(ease(Ease::InOutSine, t) == Approx(0.5f * (1.0f - std::cos(PI * t))).margin(1e-6));
+        REQUIRE(ease(Ease::InExpo, t) == Approx(t == 0.0f ? 0.0f : std::pow(2.0f, 10.0f * t - 10.0f)).margin(1e-6));
+    }
+    REQUIRE(ease(Ease::InBack, 0.3f) < 0.0f);
+    std::vector<float> from(ts.size(), 2.0f), to(ts.size(), 6.0f);
+    tween(Ease::SmoothStep, from, to, ts, out);
+    REQUIRE(out[100] == Approx(2.0f + 4.0f * ease(Ease::SmoothStep, ts[100])));
+    REQUIRE_THROWS_AS(ease(Ease::Linear, ts, Span<float>(out.data(), 5)), std::invalid_argument);
+
+    SECTION("Catmull-Rom passes through keys") {
+        std::vector<Vector3f> pts;
+        for (int i = 0; i < 9; ++i) pts.push_back(Vector3f(float(i), std::sin(float(i)), float(i * i) * 0.1f));
+        auto spline = Spline<Vector3f>::catmull_rom(pts, 1.0f, 0.5f);
+        REQUIRE(spline.uniform());
+        REQUIRE(spline.segment_count() == 8);
+        REQUIRE(spline.end_time() == Approx(5.0f));
+        for (int i = 0; i < 9; ++i) {
+            Vector3f p = spline.evaluate(1.0f + 0.5f * float(i));
+            for (size_t c = 0; c < 3; ++c) REQUIRE(p[c] == Approx(pts[i][c]).margin(1e-5));
+        }
+        // 端点外截断; 中心差分切线
+        REQUIRE(spline.evaluate(-10.0f) == spline.evaluate(1.0f));
+        REQUIRE(spline.evaluate(99.0f)[0] == Approx(8.0f));
+        REQUIRE(spline.derivative(2.5f)[0] == Approx(2.0f));
+
+        // SIMD 批量求值 (均匀) 与逐个求值一致, 包括超出范围的 t
+        std::vector<float> times(157);
+        for (size_t i = 0; i < times.size(); ++i) times[i] = float(i) * 0.03f + 0.7f;
+        std::vector<Vector3f> aos(times.size());
+        spline.evaluate(times, aos);
+        Vec3Batch soa;
+        spline.evaluate(times, soa);
+        for (size_t i = 0; i < times.size(); ++i) {
+            Vector3f ref = spline.evaluate(times[i]);
+            for (size_t c = 0; c < 3; ++c) {
+                REQUIRE(aos[i][c] == Approx(ref[c]).margin(1e-5));
+                REQUIRE(soa.component(c)[i] == Approx(ref[c]).margin(1e-5));
+            }
+        }
+    }
+
+    SECTION("Non-uniform keys, Hermite and Bezier") {
+        std::vector<float> keys = {0.0f, 1.0f, 4.0f, 4.5f};
+        std::vector<float> vals = {0.0f, 2.0f, -1.0f, 3.0f};
+        auto spline = Spline<float>::catmull_rom(vals, keys);
+        REQUIRE_FALSE(spline.uniform());
+        for (size_t i = 0; i < keys.size(); ++i) REQUIRE(spline.evaluate(keys[i]) == Approx(vals[i]).margin(1e-6));
+        std::vector<float> out2(5);
+        std::vector<float> q = {-1.0f, 0.5f, 2.0f, 4.2f, 9.0f};
+        spline.evaluate(q, out2);
+        for (size_t i = 0; i < q.size(); ++i) REQUIRE(out2[i] == spline.evaluate(q[i]));
+
+        // 切线为零的 Hermite 即 smoothstep
+        std::vector<float> hp = {0.0f, 1.0f}, hm = {0.0f, 0.0f};
+        auto h = Spline<float>::hermite(hp, hm);
+        REQUIRE(h.evaluate(0.25f) == Approx(ease(Ease::SmoothStep, 0.25f)));
+        REQUIRE(h.derivative(0.5f) == Approx(1.5f));
+
+        // 三次 Bezier 与 de Casteljau 一致, 两段共享端点
+        std::vector<Vector2f> ctrl = {{0.0f, 0.0f}, {1.0f, 2.0f}, {3.0f, 2.0f}, {4.0f, 0.0f},
+                                      {5.0f, -2.0f}, {6.0f, 1.0f}, {7.0f, 0.0f}};
+        auto b = Spline<Vector2f>::bezier(ctrl);
+        REQUIRE(b.segment_count() == 2);
+        float u = 0.3f, w = 1.0f - u;
+        float ref = w * w * w * 0.0f + 3 * w * w * u * 2.0f + 3 * w * u * u * 2.0f + u * u * u * 0.0f;
+        REQUIRE(b.evaluate(u)[1] == Approx(ref));
+        REQUIRE(b.evaluate(1.0f)[0] == Approx(4.0f));
+        REQUIRE(b.evaluate(2.0f)[0] == Approx(7.0f));
+
+        REQUIRE_THROWS_AS(Spline<Vector2f>::bezier(Span<const Vector2f>(ctrl.data(), 5)), std::invalid_argument);
+        REQUIRE_THROWS_AS(Spline<float>::catmull_rom(Span<const float>(vals.data(), 1)), std::invalid_argument);
+        std::vector<float> badKeys = {0.0f, 1.0f, 1.0f, 2.0f};
+        REQUIRE_THROWS_AS(Spline<float>::catmull_rom(vals, badKeys), std::invalid_argument);
+        std::vector<float> none;
+        REQUIRE_THROWS_AS(Spline<float>::catmull_rom(Span<const float>(none), Span<const float>(none)), std::invalid_argument);
+        REQUIRE_THROWS_AS(Spline<float>::hermite(Span<const float>(none), Span<const float>(none), Span<const float>(none)),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(Spline<float>().evaluate(0.0f), std::runtime_error);
+
+        // NaN 的 t 截断到起点 (均匀关键帧的批量路径与标量路径一致), 不越界读取系数
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        auto uniform = Spline<float>::catmull_rom(vals, 0.0f, 0.5f);
+        REQUIRE(uniform.evaluate(nan) == Approx(vals[0]));
+        std::vector<float> nanTimes(37, nan), nanOut(37);
+        nanTimes[5] = 1.0f;
+        uniform.evaluate(nanTimes, nanOut);
+        for (size_t i = 0; i < nanTimes.size(); ++i) REQUIRE(nanOut[i] == Approx(uniform.evaluate(nanTimes[i])));
+        REQUIRE_FALSE(std::isnan(spline.evaluate(nan)));
+    }
+}
+
+TEST_CASE("ThreadPool Work Stealing", "[threadpool]") {
+    using namespace GameMath;
+
+    ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+    REQUIRE(pool.current_worker() == pool.size());
+
+    // 每个下标恰好执行一次, worker 编号在范围内
+    const size_t count = 10007;
+    std::vector<std::atomic<int>> hits(count);
+    std::atomic<bool> badWorker{false};
+    pool.parallel_for(count, [&](size_t i, size_t worker) {
+        hits[i].fetch_add(1, std::memory_order_relaxed);
+        if (worker >= pool.size() || pool.current_worker() != worker) badWorker = true;
+    }, 7);
+    for (auto& h : hits) REQUIRE(h.load() == 1);
+    REQUIRE_FALSE(badWorker.load());
+
+    // 不均匀的负载: 前几个任务很重, 其余线程窃取剩余任务
+    std::vector<double> results(64);
+    pool.parallel_for(results.size(), [&](size_t i) {
+        double sum = 0.0;
+        size_t work = i < 4 ? 200000 : 100;
+        for (size_t k = 0; k < work; ++k) sum += std::sqrt(double(k + i));
+        results[i] = sum;
+    });
+    for (size_t i = 0; i < results.size(); ++i) REQUIRE(results[i] > 0.0);
+
+    // 每线程私有累加, 结束后合并
+    std::vector<uint64_t> partial(pool.size());
+    pool.parallel_for(1000, [&](size_t i, size_t worker) { partial[worker] += i; });
+    uint64_t total = 0;
+    for (uint64_t p : partial) total += p;
+    REQUIRE(total == 999u * 1000u / 2u);
+
+    // 嵌套调用在当前线程串行执行
+    std::atomic<int> inner{0};
+    pool.parallel_for(8, [&](size_t) {
+        size_t outer = pool.current_worker();
+        pool.parallel_for(10, [&](size_t, size_t worker) {
+            if (worker == outer) inner.fetch_add(1);
+        });
+    });
+    REQUIRE(inner.load() == 80);
+
+    // 异常传回调用线程, 之后线程池仍可使用
+    REQUIRE_THROWS_AS(pool.parallel_for(1000, [](size_t i) {
+        if (i == 517) throw std::runtime_error("task failed");
+    }), std::runtime_error);
+    std::atomic<size_t> after{0};
+    pool(100, [&](size_t) { after.fetch_add(1); });
+    REQUIRE(after.load() == 100);
+
+    // 作为 parallelFor 参数构建 BVH
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 300; ++i) {
+        Vector3f c(float(i % 10), float(i / 10 % 10), float(i / 100));
+        boxes.push_back(AABB(c, c + Vector3f(0.5f, 0.5f, 0.5f)));
+    }
+    BVH serial, parallel;
+    serial.build(boxes);
+    parallel.build(boxes, pool);
+    REQUIRE(parallel.primitive_count() == serial.primitive_count());
+    REQUIRE(parallel.node_count() > 0);
+
+    // 单线程池直接串行
+    ThreadPool single(1);
+    size_t sum = 0;
+    single.parallel_for(10, [&](size_t i) { sum += i; });
+    REQUIRE(sum == 45);
+
+    // 外部线程的小任务 (count <= grain) 与另一个外部线程的长任务不会同时使用同一 worker 编号
+    for (ThreadPool* p : {&pool, &single}) {
+        std::vector<std::atomic<int>> busy(p->size());
+        std::atomic<int> overlaps{0};
+        auto occupy = [&](size_t, size_t worker) {
+            if (busy[worker].exchange(1)) overlaps.fetch_add(1);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            busy[worker].store(0);
+        };
+        std::thread longJob([&] { p->parallel_for(64, occupy); });
+        for (int k = 0; k < 50; ++k) p->parallel_for(1, occupy, 4);
+        longJob.join();
+        REQUIRE(overlaps.load() == 0);
+    }
+}
+
+TEST_CASE("Matrix Views and In-Place Rotation", "[matrix][view]") {
+    using namespace GameMath;
+
+    // 视图变换与复制版本的旋转、翻转一致
+    Matrix<int, 5, 7> board{};
+    for (size_t r = 0; r < 5; ++r)
+        for (size_t c = 0; c < 7; ++c) board(r, c) = int(r * 10 + c);
+    auto v = view(board);
+    REQUIRE(v.rows() == 5);
+    REQUIRE(v.cols() == 7);
+    REQUIRE(v.rotated_cw().to_matrix<7, 5>() == rotate_90_clockwise(board));
+    REQUIRE(v.rotated_ccw().to_matrix<7, 5>() == rotate_90_counterclockwise(board));
+    REQUIRE(v.rotated_180().to_matrix<5, 7>() == rotate_180(board));
+    REQUIRE(v.flipped_horizontal().to_matrix<5, 7>() == flip_horizontal(board));
+    REQUIRE(v.flipped_vertical().to_matrix<5, 7>() == flip_vertical(board));
+    REQUIRE(v.transposed().to_matrix<7, 5>() == board.transposed());
+    REQUIRE(v.rotated_cw().rotated_cw().equals(v.rotated_180()));
+    REQUIRE(v.rotated_cw().rotated_ccw().equals(v));
+    REQUIRE(v.rotated_cw()(0, 4) == board(0, 0));
+    REQUIRE_THROWS_AS(v.at(5, 0), std::out_of_range);
+    REQUIRE_THROWS_AS((v.to_matrix<5, 5>()), std::invalid_argument);
+    REQUIRE(v.block(1, 2, 3, 4)(2, 3) == board(3, 5));
+
+    // 视图可写, 写入落在原矩阵上
+    v.rotated_cw()(0, 0) = -1;
+    REQUIRE(board(4, 0) == -1);
+
+    // 浮点矩阵覆盖 SSE 路径与边缘 (含 Vector3f 的行步长)
+    Matrix<float, 13, 9> m{};
+    for (size_t r = 0; r < 13; ++r)
+        for (size_t c = 0; c < 9; ++c) m(r, c) = float(r * 9 + c);
+    MatrixView<const float> cm = view(static_cast<const Matrix<float, 13, 9>&>(m));
+    REQUIRE(cm.rotated_cw().to_matrix<9, 13>() == rotate_90_clockwise(m));
+    REQUIRE(cm.rotated_ccw().to_matrix<9, 13>() == rotate_90_counterclockwise(m));
+    REQUIRE(cm.rotated_180().to_matrix<13, 9>() == rotate_180(m));
+    REQUIRE(cm.flipped_horizontal().to_matrix<13, 9>() == flip_horizontal(m));
+    REQUIRE(cm.transposed().to_matrix<9, 13>() == m.transposed());
+    Matrix3x3 m3 = Matrix3x3::identity();
+    m3(0, 2) = 5.0f;
+    REQUIRE(view(m3).rotated_ccw().to_matrix<3, 3>() == rotate_90_counterclockwise(m3));
+
+    // 稠密数据与输出行步长
+    std::vector<int> flat(6 * 5);
+    for (size_t i = 0; i < flat.size(); ++i) flat[i] = int(i);
+    MatrixView<int> fv(flat.data(), 6, 5);
+    std::vector<int> out(5 * 8, -7);
+    fv.rotated_ccw().copy_to(out.data(), 8);
+    for (size_t r = 0; r < 5; ++r) {
+        for (size_t c = 0; c < 6; ++c) REQUIRE(out[r * 8 + c] == flat[c * 5 + (4 - r)]);
+        REQUIRE(out[r * 8 + 7] == -7);
+    }
+
+    // 对称性检查不需要复制
+    Matrix<int, 3, 3> sym = {{1, 2, 1}, {2, 0, 2}, {1, 2, 1}};
+    REQUIRE(view(sym).rotated_cw().equals(view(sym)));
+    REQUIRE(view(sym).flipped_vertical().equals(view(sym)));
+    REQUIRE_FALSE(view(board).equals(view(board).flipped_horizontal()));
+
+    // 原地变换
+    Matrix<int, 37, 37> sq{};
+    for (size_t r = 0; r < 37; ++r)
+        for (size_t c = 0; c < 37; ++c) sq(r, c) = int(r * 37 + c);
+    auto orig = sq;
+    rotate_90_clockwise_in_place(sq);
+    REQUIRE(sq == rotate_90_clockwise(orig));
+    rotate_90_counterclockwise_in_place(sq);
+    REQUIRE(sq == orig);
+    rotate_90_counterclockwise_in_place(sq);
+    REQUIRE(sq == rotate_90_counterclockwise(orig));
+    sq = orig;
+    transpose_in_place(sq);
+    REQUIRE(sq == orig.transposed());
+
+    Matrix4x4 m4{};
+    for (size_t r = 0; r < 4; ++r)
+        for (size_t c = 0; c < 4; ++c) m4(r, c) = float(r * 4 + c);
+    auto m4orig = m4;
+    rotate_90_clockwise_in_place(m4);
+    REQUIRE(m4 == rotate_90_clockwise(m4orig));
+
+    auto rect = board;
+    rotate_180_in_place(rect);
+    REQUIRE(rect == rotate_180(board));
+    rect = board;
+    flip_horizontal_in_place(rect);
+    REQUIRE(rect == flip_horizontal(board));
+    rect = board;
+    flip_vertical_in_place(rect);
+    REQUIRE(rect == flip_vertical(board));
+    REQUIRE_THROWS_AS(transpose_in_place(view(board)), std::invalid_argument);
+
+    // 对视图的原地变换 (方阵子块)
+    sq = orig;
+    rotate_90_clockwise_in_place(view(sq).block(0, 0, 4, 4));
+    REQUIRE(sq(0, 3) == orig(0, 0));
+    REQUIRE(sq(3, 3) == orig(0, 3));
+    REQUIRE(sq(4, 4) == orig(4, 4));
+}
+
+TEST_CASE("DynamicMatrix and Blocked GEMM", "[matrix][gemm]") {
+    using namespace GameMath;
+
+    // 构造、访问与对齐
+    DynamicMatrix<float> a = {{1, 2, 3}, {4, 5, 6}};
+    REQUIRE(a.rows() == 2);
+    REQUIRE(a.cols() == 3);
+    REQUIRE(a(1, 2) == 6.0f);
+    REQUIRE(reinterpret_cast<uintptr_t>(a.data()) % 64 == 0);
+    REQUIRE_THROWS_AS(a.at(2, 0), std::out_of_range);
+    REQUIRE_THROWS_AS((DynamicMatrix<float>{{1, 2}, {3}}), std::invalid_argument);
+    REQUIRE(a.row(1)[0] == 4.0f);
+    REQUIRE(a.transposed() == DynamicMatrix<float>{{1, 4}, {2, 5}, {3, 6}});
+
+    DynamicMatrix<float> b = {{1, 0}, {0, 1}, {2, 2}};
+    REQUIRE(a * b == DynamicMatrix<float>{{7, 8}, {16, 17}});
+    REQUIRE(a * DynamicMatrix<float>::identity(3) == a);
+    REQUIRE((a + a) == a * 2.0f);
+    REQUIRE((a - a) == DynamicMatrix<float>::zero(2, 3));
+    REQUIRE_THROWS_AS(a * a, std::invalid_argument);
+
+    // 与固定尺寸矩阵一致
+    Matrix<float, 3, 3> fixed{};
+    for (size_t r = 0; r < 3; ++r)
+        for (size_t c = 0; c < 3; ++c) fixed(r, c) = float(r * 3 + c);
+    DynamicMatrix<float> dyn(fixed);
+    REQUIRE(DynamicMatrix<float>(fixed * fixed) == dyn * dyn);
+
+    // 覆盖分块、边缘、转置视图与 alpha/beta 的大矩阵, 与朴素实现比较
+    auto reference = [](MatrixView<const float> x, MatrixView<const float> y, MatrixView<float> z, float alpha, float beta) {
+        for (size_t i = 0; i < z.rows(); ++i)
+            for (size_t j = 0; j < z.cols(); ++j) {
+                float sum = 0.0f;
+                for (size_t k = 0; k < x.cols(); ++k) sum += x(i, k) * y(k, j);
+                z(i, j) = alpha * sum + beta * z(i, j);
+            }
+    };
+    Xoshiro128 rng(5);
+    const size_t m = 131, n = 75, k = 301;
+    DynamicMatrix<float> x(m, k), yT(n, k), z(m, n), expected(m, n);
+    for (float& v : x) v = float(int(rng.next_below(9)) - 4);
+    for (float& v : yT) v = float(int(rng.next_below(9)) - 4);
+    for (float& v : z) v = float(int(rng.next_below(9)) - 4);
+    expected = z;
+    reference(x.view(), yT.view().transposed(), expected.view(), 2.0f, 0.5f);
+    DynamicMatrix<float> serial = z;
+    gemm<float>(x.view(), yT.view().transposed(), serial.view(), 2.0f, 0.5f);
+    REQUIRE(serial == expected);
+
+    ThreadPool pool(3);
+    DynamicMatrix<float> big(300, 280), bigB(280, 290);
+    for (float& v : big) v = float(int(rng.next_below(5)) - 2);
+    for (float& v : bigB) v = float(int(rng.next_below(5)) - 2);
+    DynamicMatrix<float> bigExpected(300, 290);
+    reference(big.view(), bigB.view(), bigExpected.view(), 1.0f, 0.0f);
+    REQUIRE(multiply(big, bigB, pool) == bigExpected);
+    REQUIRE(big * bigB == bigExpected);
+
+    // 打包缓冲区按线程复用: 调度函数在同一线程上重入 gemm 时两者互不干扰
+    DynamicMatrix<float> nested(m, n);
+    int reentered = 0, nestedCorrect = 0;
+    auto reentrantFor = [&](size_t count, auto&& task) {
+        nested = z;
+        gemm<float>(x.view(), yT.view().transposed(), nested.view(), 2.0f, 0.5f);
+        ++reentered;
+        nestedCorrect += nested == expected;
+        for (size_t i = 0; i < count; ++i) task(i);
+    };
+    DynamicMatrix<float> outer(300, 290);
+    gemm<float>(big.view(), bigB.view(), outer.view(), 1.0f, 0.0f, reentrantFor);
+    REQUIRE(outer == bigExpected);
+    REQUIRE(reentered > 0);
+    REQUIRE(nestedCorrect == reentered);
+
+    // 整数与双精度走标量内核
+    DynamicMatrix<int> ia(40, 50, 2), ib(50, 60, 3);
+    DynamicMatrix<int> ic = ia * ib;
+    REQUIRE(ic(39, 59) == 300);
+    DynamicMatrix<double> da = DynamicMatrix<double>::identity(70);
+    DynamicMatrix<double> db(70, 70, 1.5);
+    REQUIRE(da * db == db);
+}
+
+TEST_CASE("Fixed-Size Multiply Kernels and Batch Concatenation", "[matrix][batch]") {
+    using namespace GameMath;
+
+    // 专用内核与朴素实现一致 (整数值, 结果精确)
+    auto naive = [](const auto& a, const auto& b, auto& out) {
+        for (size_t i = 0; i < a.numRows(); ++i)
+            for (size_t j = 0; j < b.numCols(); ++j) {
+                float sum = 0.0f;
+                for (size_t k = 0; k < a.numCols(); ++k) sum += a(i, k) * b(k, j);
+                out(i, j) = sum;
+            }
+    };
+    auto fill = [](auto& m, int seed) {
+        for (size_t i = 0; i < m.numRows(); ++i)
+            for (size_t j = 0; j < m.numCols(); ++j) m(i, j) = float(int((i * 7 + j * 3 + seed) % 11) - 5);
+    };
+
+    Matrix2x2 a2, b2, e2;
+    fill(a2, 1); fill(b2, 2); naive(a2, b2, e2);
+    REQUIRE(a2 * b2 == e2);
+    Matrix3x3 a3, b3, e3;
+    fill(a3, 3); fill(b3, 4); naive(a3, b3, e3);
+    REQUIRE(a3 * b3 == e3);
+    Matrix3x4 a34;
+    Matrix4x4 b4, e4;
+    fill(a34, 5); fill(b4, 6);
+    Matrix3x4 e34;
+    naive(a34, b4, e34);
+    REQUIRE(a34 * b4 == e34);
+    Matrix4x4 a4;
+    fill(a4, 7); naive(a4, b4, e4);
+    REQUIRE(a4 * b4 == e4);
+    Matrix<float, 2, 3> a23;
+    Matrix<float, 3, 5> b35;
+    Matrix<float, 2, 5> e25;
+    fill(a23, 8); fill(b35, 9); naive(a23, b35, e25);
+    REQUIRE(a23 * b35 == e25);
+
+    // 编译期求值走标量路径
+    constexpr Matrix<int, 2, 2> c2 = Matrix<int, 2, 2>{Vector<int, 2>{1, 2}, Vector<int, 2>{3, 4}} *
+                                     Matrix<int, 2, 2>{Vector<int, 2>{5, 6}, Vector<int, 2>{7, 8}};
+    static_assert(c2.rows[1].data[0] == 43);
+
+    // 仿射 3x4 相乘与 4x4 的前三行相同
+    auto to4 = [](const Matrix3x4& m) {
+        Matrix4x4 r = Matrix4x4::identity();
+        for (size_t i = 0; i < 3; ++i) r[i] = m[i];
+        return r;
+    };
+    Matrix3x4 b34;
+    fill(b34, 10);
+    Matrix3x4 affine = mul_affine(a34, b34);
+    Matrix4x4 full = to4(a34) * to4(b34);
+    for (size_t i = 0; i < 3; ++i) REQUIRE(affine[i] == full[i]);
+
+    // 逐对相乘, 输出可与输入相同
+    std::vector<Matrix4x4> parents(37), locals(37), out(37);
+    for (size_t i = 0; i < parents.size(); ++i) {
+        fill(parents[i], int(i));
+        fill(locals[i], int(i * 3 + 1));
+    }
+    multiply_pairs(parents, locals, out);
+    for (size_t i = 0; i < out.size(); ++i) REQUIRE(out[i] == parents[i] * locals[i]);
+    std::vector<Matrix4x4> inPlace = parents;
+    multiply_pairs(inPlace, locals, inPlace);
+    REQUIRE(inPlace == out);
+    REQUIRE_THROWS_AS(multiply_pairs(parents, locals, Span<Matrix4x4>(out.data(), 3)), std::invalid_argument);
+
+    // 大数组走非临时存储
+    std::vector<Matrix3x4> bigA(20000), bigB(20000), bigOut(20000);
+    for (size_t i = 0; i < bigA.size(); ++i) {
+        fill(bigA[i], int(i % 13));
+        fill(bigB[i], int(i % 7));
+    }
+    multiply_pairs(bigA, bigB, bigOut);
+    REQUIRE(bigOut[19999] == mul_affine(bigA[19999], bigB[19999]));
+    REQUIRE(bigOut[12345] == mul_affine(bigA[12345], bigB[12345]));
+
+    // 层级连乘与逐节点计算一致, 可原地计算
+    std::vector<uint32_t> parentIndex = {kNoParent, 0, 1, 0, 3, kNoParent, 5, 2};
+    std::vector<Matrix4x4> local(parentIndex.size()), world(parentIndex.size());
+    for (size_t i = 0; i < local.size(); ++i) {
+        local[i] = Matrix4x4::identity();
+        local[i](0, 3) = float(i);
+        local[i](1, 1) = i % 2 ? 2.0f : 1.0f;
+    }
+    concatenate(parentIndex, local, world);
+    for (size_t i = 0; i < world.size(); ++i) {
+        Matrix4x4 expected = local[i];
+        for (uint32_t p = parentIndex[i]; p != kNoParent; p = parentIndex[p]) expected = local[p] * expected;
+        REQUIRE(world[i] == expected);
+    }
+    std::vector<Matrix4x4> chain = local;
+    concatenate(parentIndex, chain, chain);
+    REQUIRE(chain == world);
+    parentIndex[2] = 4;
+    REQUIRE_THROWS_AS(concatenate(parentIndex, local, world), std::invalid_argument);
+
+    std::vector<uint32_t> affineParents = {kNoParent, 0, 1};
+    std::vector<Matrix3x4> affineLocal = {a34, b34, a34}, affineWorld(3);
+    concatenate(affineParents, affineLocal, affineWorld);
+    REQUIRE(affineWorld[2] == mul_affine(mul_affine(a34, b34), a34));
+}
+
+TEST_CASE("Aligned Storage and Frame Arena", "[memory]") {
+    using namespace GameMath;
+
+    auto aligned = [](const void* p, size_t a) { return reinterpret_cast<uintptr_t>(p) % a == 0; };
+
+    // 对齐变体: 大小补齐, 运算与原类型一致
+    static_assert(sizeof(Vector3fAligned) == 16 && alignof(Vector3fAligned) == 16);
+    static_assert(sizeof(Matrix4x4Aligned) == 64 && alignof(Matrix4x4Aligned) == 64);
+    static_assert(sizeof(Matrix3x4Aligned) == 64);
+    Vector3fAligned v(1.0f, 2.0f, 3.0f);
+    v = v + Vector3f(1.0f, 1.0f, 1.0f);
+    REQUIRE(v.y == 3.0f);
+    Matrix4x4Aligned m = Matrix4x4::identity();
+    m(0, 3) = 5.0f;
+    REQUIRE((m * m)(0, 3) == 10.0f);
+    std::vector<Matrix4x4Aligned> mats(5, m);
+    for (const auto& x : mats) REQUIRE(aligned(&x, 64));
+
+    // 对齐分配器
+    AlignedVector<float> floats(37, 1.0f);
+    REQUIRE(aligned(floats.data(), 64));
+    floats.resize(1000);
+    REQUIRE(aligned(floats.data(), 64));
+    AlignedVector<double, 128> wide(3);
+    REQUIRE(aligned(wide.data(), 128));
+    REQUIRE(AlignedAllocator<float>() == AlignedAllocator<int>());
+
+    // 批量容器的分量数组按缓存行对齐
+    Vec3Batch batch(100);
+    for (size_t c = 0; c < 3; ++c) REQUIRE(aligned(batch.component(c), 64));
+
+    // 帧内存池
+    FrameArena arena(256);
+    float* a = arena.allocate<float>(10);
+    REQUIRE(aligned(a, 64));
+    Span<Vector4f> b = arena.allocate_span<Vector4f>(4);
+    REQUIRE(aligned(b.data(), 64));
+    REQUIRE(reinterpret_cast<char*>(b.data()) >= reinterpret_cast<char*>(a + 10));
+    void* small = arena.allocate(3, 4);
+    REQUIRE(aligned(small, 4));
+    REQUIRE(arena.used() == 10 * sizeof(float) + 4 * sizeof(Vector4f) + 3);
+    REQUIRE(arena.block_count() == 1);
+    REQUIRE_THROWS_AS(arena.allocate(8, 3), std::invalid_argument);
+
+    // 超出当前块时追加, reset 后合并为一个块, 下一帧同样的用量不再申请
+    for (int i = 0; i < 20; ++i) {
+        int* p = arena.allocate<int>(50);
+        REQUIRE(aligned(p, 64));
+        for (int k = 0; k < 50; ++k) p[k] = i;
+    }
+    REQUIRE(arena.block_count() > 1);
+    size_t capacity = arena.capacity();
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.block_count() == 1);
+    REQUIRE(arena.capacity() == capacity);
+    for (int i = 0; i < 20; ++i) arena.allocate<int>(50);
+    REQUIRE(arena.block_count() == 1);
+
+    // 大于块大小的单次分配
+    Span<Matrix4x4> big = arena.allocate_span<Matrix4x4>(100);
+    multiply_pairs(std::vector<Matrix4x4>(100, Matrix4x4(m)), std::vector<Matrix4x4>(100, Matrix4x4::identity()), big);
+    REQUIRE(big[99](0, 3) == 5.0f);
+    arena.release();
+    REQUIRE(arena.capacity() == 0);
+    REQUIRE(arena.block_count() == 0);
+
+    // 移动后源对象为空, 再次分配从头申请
+    arena.allocate<float>(16);
+    size_t owned = arena.capacity();
+    FrameArena moved(std::move(arena));
+    REQUIRE(moved.capacity() == owned);
+    REQUIRE(moved.used() == 16 * sizeof(float));
+    REQUIRE(arena.capacity() == 0);
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.block_count() == 0);
+    arena.allocate<float>(4);
+    REQUIRE(arena.capacity() == 256);
+    REQUIRE(arena.used() == 4 * sizeof(float));
+    arena = std::move(moved);
+    REQUIRE(arena.capacity() == owned);
+    REQUIRE(moved.capacity() == 0);
+    REQUIRE(moved.used() == 0);
+    REQUIRE(moved.block_count() == 0);
+}